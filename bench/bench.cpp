@@ -0,0 +1,151 @@
+//
+// BENCH.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "bench.hpp"
+
+namespace {
+
+struct benchmark {
+	const char*	name;
+	int			(*run)(int, char**);
+	const char*	description;
+};
+
+const benchmark k_benchmarks[] = {
+	{ "threads", bocan::BenchThreads, "batch throughput from 1 to N threads. [max threads] [lines]" },
+	{ "library", bocan::BenchLibrary, "in-process evaluation cost and steady state allocations. [calls]" },
+	{ "compile", bocan::BenchCompile, "compiled expression with variables against re-parsing. [evaluations]" },
+	{ "simd", bocan::BenchSimd, "scalar and vector column throughput per operator. [rows]" },
+	{ "bytecode", bocan::BenchBytecode, "stack machine against walking the syntax tree. [lines] [passes]" },
+	{ "numbers", bocan::BenchNumbers, "literal conversion against strtod, exhaustive check and timing. [random literals]" },
+	{ "format", bocan::BenchFormat, "shortest round trip formatting, checked and timed against printf. [values]" },
+	{ "cache", bocan::BenchCache, "query log replayed with and without a cache of solutions. [queries] [formulas]" },
+	{ "bigint", bocan::BenchBigInt, "big integer arithmetic from 64 bit to 1M bit operands, checked and timed. [max bits]" },
+	{ "decimal", bocan::BenchDecimal, "rounding modes, and chains of cent amounts against the double path. [chains] [terms]" },
+	{ "stream", bocan::BenchStream, "chunked solving of one long expression against solving it whole. [megabytes]" },
+	{ "suite", bocan::BenchSuite, "phase latency percentiles over generated corpora. [expressions] [--json file]" },
+	{ "serve", bocan::BenchServe, "load generator for serve mode, pipelined clients checked and timed. [clients] [lines] [depth] [--socket path]" },
+	{ "calcbin", bocan::BenchProgramFile, "formula library loaded from a compiled file against parsing its text. [formulas]" },
+	{ "worksheet", bocan::BenchWorksheet, "changing one input of a worksheet against solving every definition again. [definitions]" },
+	{ "fork", bocan::BenchFork, "one huge expression solved serially and as fork-join tasks, which must match bit for bit. [terms] [repeat]" },
+	{ "share", bocan::BenchShare, "parsing and solving with repeated subtrees shared against copied, on repetitive and unique corpora. [expressions]" },
+	{ "jit", bocan::BenchJit, "row by row solving as native code checked bit for bit against the interpreter, and timed. [expressions] [rows]" },
+	{ "constant", bocan::BenchConstant, "the constant expression solver checked against the run time solver on random valid and broken expressions. [expressions]" },
+};
+
+} // NAMESPACE
+
+///
+/// @brief runs the benchmark named by the first argument, or every benchmark with 'all'.
+/// @param[in] integer is the number of command line arguments.
+/// @param[in] char pointer pointer is the vector of command line arguments.
+/// @return 0 on success, 1 for an unknown benchmark.
+/// @todo
+///
+int main(int argc, char** argv) {
+
+	// every heap allocation in the benchmark binary is counted, so benchmarks can check that a steady state does not allocate
+	bocan::CountAllocations(true);
+
+	if(argc < 2) {
+		std::printf("USAGE: bench.out <benchmark|all> [options]\n");
+		for(const benchmark& b : k_benchmarks) {
+			std::printf("  %-10s %s\n", b.name, b.description);
+		}
+		return 1;
+	}
+
+	for(const benchmark& b : k_benchmarks) {
+		if(std::strcmp(argv[1], "all") == 0) {
+			std::printf("==%s\n", b.name);
+			if(b.run(0, nullptr)) { return 1; }
+		} else if(std::strcmp(argv[1], b.name) == 0) {
+			return b.run(argc - 2, argv + 2);
+		}
+	}
+
+	if(std::strcmp(argv[1], "all") == 0) { return 0; }
+
+	std::fprintf(stderr, ">ERROR. UNKNOWN BENCHMARK '%s'.\n", argv[1]);
+	return 1;
+}
+
+///
+/// @brief generates a reproducible corpus of expressions with a wide spread of lengths, one per line.
+/// @brief most lines are short, a few are thousands of operators long, so chunks take very different times to solve.
+/// @param[in] unsigned integer is the random seed.
+/// @param[in] size_t is the number of lines.
+/// @return string holding the corpus.
+/// @todo
+///
+std::string bocan::GenerateMixedCorpus(std::uint64_t seed, std::size_t lines) {
+
+	std::mt19937_64 random(seed);
+	std::string corpus;
+	const char operators[] = { '+', '-', '*', '/' };
+
+	for(std::size_t line = 0; line < lines; line++) {
+
+		std::size_t count = (random() % 10 == 0) ? 100 + random() % 2000 : 1 + random() % 20;
+		bool floating = random() % 2;
+
+		for(std::size_t i = 0; i <= count; i++) {
+			if(i) { corpus += operators[random() % (floating ? 4 : 3)]; }
+
+			bool paren = random() % 8 == 0;
+			if(paren) { corpus += '('; }
+
+			corpus += std::to_string(1 + random() % 999);
+			if(floating && random() % 2) {
+				corpus += '.';
+				corpus += std::to_string(random() % 100);
+			}
+
+			if(paren) {
+				corpus += '+';
+				corpus += std::to_string(1 + random() % 99);
+				corpus += ')';
+			}
+		}
+		corpus += '\n';
+	}
+	return corpus;
+}
+
+///
+/// @brief compares two solutions bit for bit. the value of a failed solve is not used, only its error and where it is.
+/// @param[in] Solution reference to the first solution.
+/// @param[in] Solution reference to the second solution.
+/// @return boolean true if the solutions are the same.
+/// @todo
+///
+bool bocan::SameSolution(const Solution& a, const Solution& b) {
+	if(a.error_code != NO_ERROR || b.error_code != NO_ERROR) {
+		return a.error_code == b.error_code && a.error_pos == b.error_pos;
+	}
+	return a.floating == b.floating && a.modulus == b.modulus
+		&& (a.floating ? std::memcmp(&a.real, &b.real, sizeof(double)) == 0 : a.integer == b.integer);
+}
@@ -0,0 +1,74 @@
+//
+// BENCH.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "../src/solver/solver.hpp"
+#include "../src/stats/allocations.hpp"
+
+namespace bocan {
+
+// each benchmark is a subcommand of bench.out and receives the arguments that follow its name.
+int		BenchThreads(int, char**);
+int		BenchLibrary(int, char**);
+int		BenchCompile(int, char**);
+int		BenchSimd(int, char**);
+int		BenchBytecode(int, char**);
+int		BenchNumbers(int, char**);
+int		BenchFormat(int, char**);
+int		BenchCache(int, char**);
+int		BenchBigInt(int, char**);
+int		BenchDecimal(int, char**);
+int		BenchStream(int, char**);
+int		BenchSuite(int, char**);
+int		BenchServe(int, char**);
+int		BenchProgramFile(int, char**);
+int		BenchWorksheet(int, char**);
+int		BenchFork(int, char**);
+int		BenchShare(int, char**);
+int		BenchJit(int, char**);
+int		BenchConstant(int, char**);
+
+// shared helpers
+std::string		GenerateMixedCorpus(std::uint64_t, std::size_t);
+bool			SameSolution(const Solution&, const Solution&);
+
+// wall clock stopwatch in seconds
+class Stopwatch {
+
+public:
+	Stopwatch() : m_start(std::chrono::steady_clock::now()) {}
+
+	double Seconds() const {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+	}
+
+private:
+	std::chrono::steady_clock::time_point m_start;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// BENCH_HPP
@@ -0,0 +1,188 @@
+//
+// BENCH_BIGINT.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../src/bigint/bigint.hpp"
+#include "../src/solver/solver.hpp"
+
+namespace {
+
+std::string RandomDigits(std::mt19937_64* random, std::size_t count) {
+	std::string digits(count, '0');
+	for(std::size_t i = 0; i < count; i++) { digits[i] = static_cast<char>('0' + (*random)() % 10); }
+	if(digits[0] == '0') { digits[0] = '1'; }
+	return digits;
+}
+
+// the plain quadratic product of two decimal strings, the reference for every size
+std::string NaiveProduct(const std::string& a, const std::string& b) {
+
+	std::vector<std::uint64_t> lhs;
+	std::vector<std::uint64_t> rhs;
+	for(std::size_t end = a.size(); end > 0; end = end > 9 ? end - 9 : 0) {
+		lhs.push_back(std::strtoull(a.substr(end > 9 ? end - 9 : 0, end > 9 ? 9 : end).c_str(), nullptr, 10));
+	}
+	for(std::size_t end = b.size(); end > 0; end = end > 9 ? end - 9 : 0) {
+		rhs.push_back(std::strtoull(b.substr(end > 9 ? end - 9 : 0, end > 9 ? 9 : end).c_str(), nullptr, 10));
+	}
+
+	std::vector<std::uint64_t> product(lhs.size() + rhs.size(), 0);
+	for(std::size_t i = 0; i < lhs.size(); i++) {
+		std::uint64_t carry = 0;
+		for(std::size_t j = 0; j < rhs.size(); j++) {
+			std::uint64_t t = lhs[i] * rhs[j] + product[i + j] + carry;
+			product[i + j] = t % 1000000000;
+			carry = t / 1000000000;
+		}
+		product[i + rhs.size()] += carry;
+	}
+
+	while(product.size() > 1 && product.back() == 0) { product.pop_back(); }
+
+	std::string text = std::to_string(product.back());
+	char limb[16];
+	for(std::size_t i = product.size() - 1; i-- > 0;) {
+		std::snprintf(limb, sizeof(limb), "%09llu", static_cast<unsigned long long>(product[i]));
+		text += limb;
+	}
+	return text;
+}
+
+} // NAMESPACE
+
+///
+/// @brief checks big integer products against the quadratic method and quotients against the products,
+/// @brief then times multiplication, division and decimal conversion from 64 bit to 1M bit operands, and a few large powers.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the largest operand size in bits.
+/// @return 0 on success, 1 if any result is wrong.
+/// @todo
+///
+int bocan::BenchBigInt(int argc, char** argv) {
+
+	unsigned long max_bits = 1 << 20;
+	if(argc > 0) { max_bits = std::strtoul(argv[0], nullptr, 10); }
+
+	std::mt19937_64 random(13);
+	unsigned long mismatches = 0;
+	const unsigned long MAX_DIVIDE_BITS = 1 << 18;
+
+	std::printf("%-9s %-12s %-12s %-8s %-12s %-12s %-12s\n", "BITS", "MUL US", "NAIVE US", "SPEEDUP", "DIV US", "PARSE US", "PRINT US");
+
+	for(unsigned long bits = 64; bits <= max_bits; bits *= 4) {
+
+		std::size_t digits = static_cast<std::size_t>(bits * 0.30103) + 1;
+		std::string text_a = RandomDigits(&random, digits);
+		std::string text_b = RandomDigits(&random, digits);
+
+		BigInt a;
+		BigInt b;
+		BigInt product;
+		BigInt quotient;
+		bool remainder = false;
+
+		// repeat small sizes so the clock can see them
+		int repeat = bits <= 4096 ? 1000 : (bits <= 65536 ? 10 : 1);
+
+		Stopwatch parse_watch;
+		for(int r = 0; r < repeat; r++) { a.Parse(text_a.data(), text_a.size()); }
+		double parse = parse_watch.Seconds() / repeat;
+		b.Parse(text_b.data(), text_b.size());
+
+		Stopwatch multiply_watch;
+		for(int r = 0; r < repeat; r++) { BigInt::Multiply(a, b, &product); }
+		double multiply = multiply_watch.Seconds() / repeat;
+
+		Stopwatch print_watch;
+		std::string text;
+		for(int r = 0; r < repeat; r++) { product.ToString(&text); }
+		double print = print_watch.Seconds() / repeat;
+
+		Stopwatch naive_watch;
+		std::string expected = NaiveProduct(text_a, text_b);
+		double naive = naive_watch.Seconds();
+
+		if(text != expected) {
+			mismatches++;
+			std::fprintf(stderr, ">MISMATCH PRODUCT AT %lu BITS\n", bits);
+		}
+
+		// (a * b + 1) / b gives back a with a remainder. division is quadratic, so the largest size is skipped.
+		double divide = 0;
+		if(bits <= MAX_DIVIDE_BITS) {
+			BigInt::Add(product, BigInt(1), &product);
+			Stopwatch divide_watch;
+			for(int r = 0; r < repeat; r++) { BigInt::Divide(product, b, &quotient, &remainder); }
+			divide = divide_watch.Seconds() / repeat;
+
+			if(quotient.ToString() != text_a || !remainder) {
+				mismatches++;
+				std::fprintf(stderr, ">MISMATCH QUOTIENT AT %lu BITS\n", bits);
+			}
+		}
+
+		std::printf("%-9lu %-12.2f %-12.2f %-8.2f %-12.2f %-12.2f %-12.2f\n", bits, multiply * 1e6, naive * 1e6, naive / multiply,
+			divide * 1e6, parse * 1e6, print * 1e6);
+	}
+
+	// whole expressions through the solver
+	struct power {
+		const char*	expr;
+		const char*	expected;	// the leading digits of the solution
+		std::size_t	digits;
+	};
+	const power powers[] = {
+		{ "3^40", "12157665459056928801", 20 },
+		{ "2^64-1", "18446744073709551615", 20 },
+		{ "7^100000", "6367", 84510 },
+		{ "2^1000000", "9900", 301030 },
+		{ "(10^5000+1)/(10^2500)", "1", 2501 },
+	};
+
+	Solver solver;
+	std::printf("%-24s %-10s %-12s\n", "EXPRESSION", "DIGITS", "MS");
+
+	for(const power& p : powers) {
+		Solution solution;
+		BigInt result;
+		std::string expr(p.expr);
+
+		Stopwatch watch;
+		bool err = solver.Tokenize(expr.data(), expr.size(), &solution) || solver.EvaluateBig(&result, &solution);
+		double seconds = watch.Seconds();
+
+		std::string text = result.ToString();
+		if(err || text.size() != p.digits || text.compare(0, std::string(p.expected).size(), p.expected) != 0) {
+			mismatches++;
+			std::fprintf(stderr, ">MISMATCH '%s'\n", p.expr);
+		}
+		std::printf("%-24s %-10zu %-12.3f\n", p.expr, text.size(), seconds * 1e3);
+	}
+
+	std::printf("MISMATCHES %lu\n", mismatches);
+	return mismatches ? 1 : 0;
+}
@@ -0,0 +1,137 @@
+//
+// BENCH_BYTECODE.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../src/bytecode/bytecode.hpp"
+#include "../src/evaluator/evaluator.hpp"
+#include "../src/lexer/lexer.hpp"
+#include "../src/parser/parser.hpp"
+#include "../src/solver/solver.hpp"
+
+///
+/// @brief solves a mixed corpus that is parsed once, by walking the syntax trees and by running their bytecode.
+/// @brief both must give the same solution or error for every line.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the number of lines and the number of passes.
+/// @return 0 on success, 1 if the results differ.
+/// @todo
+///
+int bocan::BenchBytecode(int argc, char** argv) {
+
+	unsigned long lines = 20000;
+	unsigned long passes = 20;
+
+	if(argc > 0) { lines = std::strtoul(argv[0], nullptr, 10); }
+	if(argc > 1) { passes = std::strtoul(argv[1], nullptr, 10); }
+	if(passes == 0) { passes = 1; }
+
+	std::string corpus = GenerateMixedCorpus(9, lines);
+
+	// parse and compile every line before timing
+	std::vector<Ast> trees;
+	std::vector<std::unique_ptr<Bytecode>> programs;
+	std::size_t instructions = 0;
+
+	Lexer lexer;
+	Parser parser;
+	std::vector<Token> tokens;
+
+	for(std::size_t begin = 0; begin < corpus.size(); ) {
+
+		std::size_t end = corpus.find('\n', begin);
+		const char* line = corpus.data() + begin;
+
+		if(!lexer.Tokenize(line, end - begin, &tokens)) {
+			trees.emplace_back();
+			if(parser.Parse(line, tokens, lexer.IsFloating(), &trees.back())) {
+				trees.pop_back();
+			} else {
+				programs.emplace_back(new Bytecode);
+				programs.back()->Compile(trees.back());
+				instructions += programs.back()->View().header->code_size;
+			}
+		}
+		begin = end + 1;
+	}
+
+	std::vector<BytecodeView> views;
+	for(const std::unique_ptr<Bytecode>& program : programs) { views.push_back(program->View()); }
+
+	std::vector<Solution> walked(trees.size());
+	std::vector<Solution> ran(trees.size());
+
+	Evaluator evaluator;
+	Vm vm;
+
+	Stopwatch walk_watch;
+	for(unsigned long pass = 0; pass < passes; pass++) {
+		for(std::size_t i = 0; i < trees.size(); i++) {
+			Solution& solution = walked[i];
+			solution = Solution();
+			solution.floating = trees[i].floating;
+			bool err = solution.floating ? evaluator.Evaluate(trees[i], &solution.real)
+			                             : evaluator.Evaluate(trees[i], &solution.integer);
+			if(err) {
+				solution.error_code = evaluator.GetErrorCode();
+				solution.error_pos = evaluator.GetErrorPosition();
+			}
+			solution.modulus = evaluator.GetModulusFlag();
+		}
+	}
+	double walk_seconds = walk_watch.Seconds();
+
+	unsigned long before = GetAllocationCount();
+
+	Stopwatch vm_watch;
+	for(unsigned long pass = 0; pass < passes; pass++) {
+		for(std::size_t i = 0; i < views.size(); i++) {
+			vm.Run(views[i], nullptr, &ran[i]);
+		}
+	}
+	double vm_seconds = vm_watch.Seconds();
+
+	unsigned long allocations = GetAllocationCount() - before;
+
+	unsigned long mismatches = 0;
+	for(std::size_t i = 0; i < trees.size(); i++) {
+		const Solution& a = walked[i];
+		const Solution& b = ran[i];
+		bool same = a.error_code == b.error_code && a.error_pos == b.error_pos && a.modulus == b.modulus &&
+			(a.floating ? std::memcmp(&a.real, &b.real, sizeof(double)) == 0 : a.integer == b.integer);
+		if(a.error_code != NO_ERROR) { same = a.error_code == b.error_code && a.error_pos == b.error_pos; }
+		if(!same) { mismatches++; }
+	}
+
+	double count = static_cast<double>(instructions) * passes;
+
+	std::printf("%-10s %-10s %-12s %-10s\n", "PATH", "SECONDS", "NS/OP", "SPEEDUP");
+	std::printf("%-10s %-10.4f %-12.2f %-10.2f\n", "tree", walk_seconds, walk_seconds * 1e9 / count, 1.0);
+	std::printf("%-10s %-10.4f %-12.2f %-10.2f\n", "bytecode", vm_seconds, vm_seconds * 1e9 / count, walk_seconds / vm_seconds);
+	std::printf("EXPRESSIONS %zu INSTRUCTIONS %zu MISMATCHES %lu ALLOCATIONS %lu\n", trees.size(), instructions, mismatches, allocations);
+
+	return mismatches ? 1 : 0;
+}
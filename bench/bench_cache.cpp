@@ -0,0 +1,182 @@
+//
+// BENCH_CACHE.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../src/cache/cache.hpp"
+#include "../src/solver/solver.hpp"
+
+namespace {
+
+// a query log like a shared calculator sees: a few popular formulas asked for again and again,
+// written with different spacing and multiplication signs, built from a pool of common terms
+class QueryLog {
+
+public:
+	QueryLog(std::uint64_t seed, std::size_t formulas) : m_random(seed) {
+
+		for(std::size_t i = 0; i < TERMS; i++) { m_terms.push_back(MakeTerm()); }
+		for(std::size_t i = 0; i < formulas; i++) { m_formulas.push_back(MakeFormula()); }
+
+		// popularity falls off as 1 / rank
+		double total = 0;
+		for(std::size_t i = 0; i < formulas; i++) {
+			total += 1.0 / static_cast<double>(i + 1);
+			m_weights.push_back(total);
+		}
+	}
+
+	std::string Next() {
+		double pick = std::uniform_real_distribution<double>(0, m_weights.back())(m_random);
+		std::size_t index = std::lower_bound(m_weights.begin(), m_weights.end(), pick) - m_weights.begin();
+		return Render(m_formulas[std::min(index, m_formulas.size() - 1)]);
+	}
+
+private:
+	std::string MakeNumber(bool floating) {
+		std::string number = std::to_string(1 + m_random() % 999);
+		if(floating) { number += "." + std::to_string(m_random() % 100); }
+		return number;
+	}
+
+	std::string MakeTerm() {
+		bool floating = m_random() % 2;
+		std::string term = "(" + MakeNumber(floating);
+		std::size_t count = 2 + m_random() % 5;
+		for(std::size_t i = 0; i < count; i++) {
+			const char operators[] = { '+', '-', '*', '^' };
+			char oper = operators[m_random() % 4];
+			term += oper;
+			term += oper == '^' ? std::to_string(2 + m_random() % 3) : MakeNumber(floating);
+		}
+		return term + ")";
+	}
+
+	std::string MakeFormula() {
+		std::string formula;
+		std::size_t count = 2 + m_random() % 5;
+		for(std::size_t i = 0; i < count; i++) {
+			if(i) { formula += "+-*"[m_random() % 3]; }
+			formula += m_random() % 3 ? m_terms[m_random() % m_terms.size()] : MakeNumber(false);
+		}
+		return formula;
+	}
+
+	// the same formula typed another way: spaces around operators, 'x' for '*' and an implied '*' before a '('
+	std::string Render(const std::string& formula) {
+		std::uint64_t style = m_random();
+		std::string text;
+		for(std::size_t i = 0; i < formula.size(); i++) {
+			char c = formula[i];
+			if(c == '*' && (style & 1)) {
+				text += (style & 2) ? " x " : "x";
+			} else if(c == '*' && (style & 4) && i + 1 < formula.size() && formula[i + 1] == '(' && i && formula[i - 1] == ')') {
+				continue;
+			} else if((c == '+' || c == '-') && (style & 8)) {
+				text += ' ';
+				text += c;
+				text += ' ';
+			} else {
+				text += c;
+			}
+		}
+		return text;
+	}
+
+	static const std::size_t TERMS = 300;
+
+	std::mt19937_64		m_random;
+	std::vector<std::string>	m_terms;
+	std::vector<std::string>	m_formulas;
+	std::vector<double>			m_weights;
+};
+
+} // NAMESPACE
+
+///
+/// @brief replays a query log with and without a cache of solutions, checks that every result is identical,
+/// @brief and reports the hit rate, evictions and time per query for each capacity.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the number of queries and the number of distinct formulas.
+/// @return 0 on success, 1 if a cached result differs.
+/// @todo
+///
+int bocan::BenchCache(int argc, char** argv) {
+
+	unsigned long queries = 200000;
+	unsigned long formulas = 20000;
+	if(argc > 0) { queries = std::strtoul(argv[0], nullptr, 10); }
+	if(argc > 1) { formulas = std::strtoul(argv[1], nullptr, 10); }
+	if(queries == 0) { queries = 1; }
+	if(formulas == 0) { formulas = 1; }
+
+	QueryLog log(12, formulas);
+	std::vector<std::string> texts;
+	for(unsigned long i = 0; i < queries; i++) { texts.push_back(log.Next()); }
+
+	Solver solver;
+	std::vector<Solution> expected(texts.size());
+
+	Stopwatch plain_watch;
+	for(std::size_t i = 0; i < texts.size(); i++) {
+		solver.Solve(texts[i].data(), texts[i].size(), &expected[i]);
+	}
+	double plain = plain_watch.Seconds();
+
+	std::printf("%lu QUERIES %lu FORMULAS\n", queries, formulas);
+	std::printf("%-10s %-10s %-12s %-12s %-12s %-10s %-10s\n", "CAPACITY", "HIT RATE", "HITS", "GROUP HITS", "EVICTIONS", "NS/QUERY", "SPEEDUP");
+	std::printf("%-10s %-10s %-12s %-12s %-12s %-10.1f %-10s\n", "none", "-", "-", "-", "-", plain * 1e9 / queries, "1.00");
+
+	unsigned long mismatches = 0;
+	const std::size_t capacities[] = { 1000, 10000, 100000 };
+
+	for(std::size_t capacity : capacities) {
+
+		SolutionCache cache(capacity);
+		Solver cached;
+		cached.SetCache(&cache);
+		Solution solution;
+
+		Stopwatch watch;
+		for(std::size_t i = 0; i < texts.size(); i++) {
+			cached.Solve(texts[i].data(), texts[i].size(), &solution);
+			if(!SameSolution(solution, expected[i]) && mismatches++ < 10) {
+				std::fprintf(stderr, ">MISMATCH '%s'\n", texts[i].c_str());
+			}
+		}
+		double seconds = watch.Seconds();
+
+		unsigned long lookups = cache.GetHitCount() + cache.GetMissCount();
+		std::printf("%-10zu %-10.3f %-12lu %-12lu %-12lu %-10.1f %-10.2f\n", capacity,
+			lookups ? static_cast<double>(cache.GetHitCount()) / lookups : 0.0,
+			cache.GetHitCount(), cache.GetGroupHitCount(), cache.GetEvictionCount(), seconds * 1e9 / queries, plain / seconds);
+	}
+
+	std::printf("MISMATCHES %lu\n", mismatches);
+	return mismatches ? 1 : 0;
+}
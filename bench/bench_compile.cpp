@@ -0,0 +1,128 @@
+//
+// BENCH_COMPILE.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../src/expression/expression.hpp"
+#include "../src/solver/solver.hpp"
+
+namespace {
+
+const char k_formula[] = "a*(b-c)^2/d";
+const int ROUNDS = 5;
+
+} // NAMESPACE
+
+///
+/// @brief solves one formula with many sets of inputs, once by writing each set into the text and solving it,
+/// @brief and once by compiling the formula and binding each set to its variables. the results must agree.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the number of input sets.
+/// @return 0 on success, 1 if the formula fails to compile, the results differ or the compiled path allocates.
+/// @todo
+///
+int bocan::BenchCompile(int argc, char** argv) {
+
+	unsigned long count = 200000;
+	if(argc > 0) { count = std::strtoul(argv[0], nullptr, 10); }
+	if(count == 0) { count = 1; }
+
+	Expression expression;
+	Solution solution;
+
+	if(expression.Compile(k_formula, sizeof(k_formula) - 1, &solution)) {
+		std::fprintf(stderr, ">ERROR %d. UNABLE TO COMPILE '%s'.\n", solution.error_code, k_formula);
+		return 1;
+	}
+
+	const std::size_t variables = expression.GetVariableCount();
+	const int a = expression.GetVariableIndex("a");
+	const int b = expression.GetVariableIndex("b");
+	const int c = expression.GetVariableIndex("c");
+	const int d = expression.GetVariableIndex("d");
+
+	// the same inputs as text, written before timing so only solving is measured
+	std::mt19937_64 random(7);
+	std::vector<double> values(count * variables);
+	std::vector<std::string> texts(count);
+
+	for(unsigned long i = 0; i < count; i++) {
+		double* set = &values[i * variables];
+		set[a] = 1 + random() % 999;
+		set[b] = 1 + random() % 999;
+		set[c] = 1 + random() % 999;
+		set[d] = 1 + random() % 999;
+
+		char text[128];
+		std::snprintf(text, sizeof(text), "%.0f*(%.0f-%.0f)^2/%.0f", set[a], set[b], set[c], set[d]);
+		texts[i] = text;
+	}
+
+	std::vector<double> parsed(count);
+	std::vector<double> compiled(count);
+	Solver solver;
+
+	double parse_seconds = 0;
+	double compile_seconds = 0;
+	unsigned long allocations = 0;
+
+	// the fastest of a few rounds, so a busy machine does not skew the ratio
+	for(int round = 0; round < ROUNDS; round++) {
+
+		Stopwatch parse_watch;
+		for(unsigned long i = 0; i < count; i++) {
+			solver.Solve(texts[i].data(), texts[i].size(), &solution);
+			parsed[i] = solution.real;
+		}
+		double seconds = parse_watch.Seconds();
+		if(round == 0 || seconds < parse_seconds) { parse_seconds = seconds; }
+
+		unsigned long before = GetAllocationCount();
+
+		Stopwatch compile_watch;
+		for(unsigned long i = 0; i < count; i++) {
+			expression.Evaluate(&values[i * variables], &solution);
+			compiled[i] = solution.real;
+		}
+		seconds = compile_watch.Seconds();
+		if(round == 0 || seconds < compile_seconds) { compile_seconds = seconds; }
+
+		allocations += GetAllocationCount() - before;
+	}
+
+	unsigned long mismatches = 0;
+	for(unsigned long i = 0; i < count; i++) {
+		if(std::fabs(parsed[i] - compiled[i]) > 1e-12 * std::fabs(parsed[i])) { mismatches++; }
+	}
+
+	std::printf("%-10s %-12s %-10s\n", "PATH", "NS/EVAL", "SPEEDUP");
+	std::printf("%-10s %-12.1f %-10.2f\n", "re-parse", parse_seconds * 1e9 / count, 1.0);
+	std::printf("%-10s %-12.1f %-10.2f\n", "compiled", compile_seconds * 1e9 / count, parse_seconds / compile_seconds);
+	std::printf("FORMULA %s INPUTS %lu MISMATCHES %lu ALLOCATIONS %lu\n", k_formula, count, mismatches, allocations);
+
+	return mismatches || allocations ? 1 : 0;
+}
@@ -0,0 +1,230 @@
+//
+// BENCH_CONSTANT.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++20
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "bench.hpp"
+#include "../src/libcalc/constant.hpp"
+#include "../src/libcalc/libcalc.hpp"
+
+namespace {
+
+// folded while this file is compiled. a wrong answer, or any error, stops the build
+constexpr bocan::Result k_area = bocan::calc::Evaluate("2*(12-5)^2");
+constexpr bocan::Result k_cents = bocan::calc::Evaluate("19.99 x 3 - 0.5");
+constexpr bocan::Result k_wrap = bocan::calc::Evaluate("9223372036854775807 + 1");
+constexpr bocan::Result k_implicit = bocan::calc::Evaluate("2(3+4)(5) - -1");
+
+static_assert(k_area.type == bocan::RESULT_FLOATING && k_area.value.floating == 98);
+static_assert(k_cents.type == bocan::RESULT_FLOATING && k_cents.value.floating == 19.99 * 3 - 0.5);
+static_assert(k_wrap.type == bocan::RESULT_INTEGER && k_wrap.value.integer == -9223372036854775807 - 1);
+static_assert(k_implicit.value.integer == 71);
+static_assert(bocan::calc::Solve("1/(2-2)").error_code == bocan::DIVIDE_BY_ZERO);
+static_assert(bocan::calc::Solve("2*(3++4)").error_position == 5);
+
+// parentheses nested far deeper than the compiler lets a constexpr function recurse
+constexpr std::size_t k_nesting = 1000;
+constexpr std::array<char, 2 * k_nesting + 1> k_nested = [] {
+	std::array<char, 2 * k_nesting + 1> text{};
+	for(std::size_t i = 0; i < k_nesting; i++) {
+		text[i] = '(';
+		text[k_nesting + 1 + i] = ')';
+	}
+	text[k_nesting] = '7';
+	return text;
+}();
+static_assert(bocan::calc::Solve(std::string_view(k_nested.data(), k_nested.size())).value.integer == 7);
+
+// a random expression. most follow the grammar, and some have a token dropped or swapped so they fail
+std::string Generate(std::mt19937_64& random, int depth) {
+
+	static const char* k_numbers[] = { "0", "7", "12", "0.1", "2.5", ".5", "5.", "1e3", "2.5E-4", "1e400", "4e-330",
+		"123456789012345678901234", "0.30000000000000004", "9223372036854775807", "1.7976931348623157e308" };
+	static const char* k_operators[] = { "+", "-", "*", "x", "/", "^", " + ", " * " };
+
+	if(depth == 0 || random() % 3 == 0) {
+		std::string number = k_numbers[random() % (sizeof(k_numbers) / sizeof(k_numbers[0]))];
+		if(random() % 6 == 0) { number = "-" + number; }
+		return number;
+	}
+
+	std::string lhs = Generate(random, depth - 1);
+	std::string rhs = Generate(random, depth - 1);
+
+	switch(random() % 6) {
+		case 0:		return "(" + lhs + ")(" + rhs + ")";
+		case 1:		return "-(" + lhs + ")";
+		case 2:		return lhs + "(" + rhs + ")";
+		default:	return lhs + k_operators[random() % (sizeof(k_operators) / sizeof(k_operators[0]))] + rhs;
+	}
+}
+
+// breaks one character of the expression
+void Mutate(std::mt19937_64& random, std::string* expr) {
+	static const char k_characters[] = "()+-*/^.e 0x";
+	if(expr->empty()) { return; }
+	std::size_t i = random() % expr->size();
+	switch(random() % 3) {
+		case 0:		expr->erase(i, 1); break;
+		case 1:		expr->insert(i, 1, k_characters[random() % (sizeof(k_characters) - 1)]); break;
+		default:	(*expr)[i] = k_characters[random() % (sizeof(k_characters) - 1)]; break;
+	}
+}
+
+// the distance between two doubles in units in the last place. any two NaNs are the same
+std::uint64_t Distance(double lhs, double rhs) {
+	if(lhs != lhs && rhs != rhs) { return 0; }
+	std::int64_t a = 0;
+	std::int64_t b = 0;
+	std::memcpy(&a, &lhs, sizeof(double));
+	std::memcpy(&b, &rhs, sizeof(double));
+	if(a < 0) { a = INT64_MIN - a; }
+	if(b < 0) { b = INT64_MIN - b; }
+	return a > b ? static_cast<std::uint64_t>(a - b) : static_cast<std::uint64_t>(b - a);
+}
+
+} // NAMESPACE
+
+///
+/// @brief solves random expressions, valid and broken, with the constant expression solver and with
+/// @brief bocan::Evaluate(). types, values, error codes and positions must match. a power or a literal off the
+/// @brief exact fast path may differ by one unit in the last place, which is counted apart, and lone powers are
+/// @brief checked to be within that unit.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the number of expressions.
+/// @return 0 on success, 1 if a solution differs.
+/// @todo
+///
+int bocan::BenchConstant(int argc, char** argv) {
+
+	unsigned long count = 200000;
+	if(argc > 0) { count = std::strtoul(argv[0], nullptr, 10); }
+
+	std::mt19937_64 random(25);
+
+	unsigned long errors = 0;
+	unsigned long rounded = 0;
+	unsigned long mismatches = 0;
+
+	for(unsigned long i = 0; i < count; i++) {
+
+		std::string expr = Generate(random, 4);
+		if(random() % 4 == 0) { Mutate(random, &expr); }
+
+		Result expected = bocan::Evaluate(expr);
+		Result actual = calc::Solve(expr);
+
+		bool same = expected.error_code == actual.error_code && expected.error_position == actual.error_position &&
+			expected.type == actual.type;
+
+		if(same && expected.error_code == NO_ERROR) {
+			if(expected.type == RESULT_INTEGER) {
+				same = expected.value.integer == actual.value.integer;
+			} else {
+				// a power one unit off in the last place can move later digits after a cancellation
+				double lhs = expected.value.floating;
+				double rhs = actual.value.floating;
+				if(Distance(lhs, rhs) != 0) {
+					if(expr.find_first_of("^e") != std::string::npos && std::abs(lhs - rhs) <= 1e-9 * std::abs(lhs)) {
+						rounded++;
+					} else {
+						same = false;
+					}
+				}
+			}
+		}
+
+		if(expected.error_code != NO_ERROR) { errors++; }
+		if(!same) {
+			if(mismatches < 10) {
+				std::printf("MISMATCH '%s' %d@%zu %.17g AGAINST %d@%zu %.17g\n", expr.c_str(), expected.error_code, expected.error_position,
+					expected.type == RESULT_FLOATING ? expected.value.floating : static_cast<double>(expected.value.integer),
+					actual.error_code, actual.error_position,
+					actual.type == RESULT_FLOATING ? actual.value.floating : static_cast<double>(actual.value.integer));
+			}
+			mismatches++;
+		}
+	}
+
+	// a lone power of two literals, which must be within one unit in the last place
+	unsigned long powers = 0;
+	unsigned long exact = 0;
+	for(unsigned long i = 0; i < count / 4; i++) {
+
+		char expr[96];
+		double base = std::ldexp(static_cast<double>(random() % 1000000) / 1000, static_cast<int>(random() % 40) - 20);
+		double power = random() % 2 ? static_cast<double>(random() % 200) - 100 : static_cast<double>(random() % 20000) / 1000 - 10;
+		std::snprintf(expr, sizeof(expr), "%s%.17g^%.17g", random() % 4 ? "" : "-", base, power);
+
+		Result expected = bocan::Evaluate(expr);
+		Result actual = calc::Solve(expr);
+
+		std::uint64_t distance = Distance(expected.value.floating, actual.value.floating);
+		if(expected.error_code != actual.error_code || distance > 1) {
+			if(mismatches < 10) { std::printf("MISMATCH '%s' %.17g AGAINST %.17g\n", expr, expected.value.floating, actual.value.floating); }
+			mismatches++;
+		}
+		powers++;
+		if(distance == 0) { exact++; }
+	}
+
+	// nesting at the limit shared with the parser, just past it, and left open
+	for(int depth : { MAX_DEPTH, MAX_DEPTH + 1 }) {
+		for(const char* open : { "(", "-(" }) {
+
+			std::string expr;
+			for(int d = 0; d < depth; d++) { expr += open; }
+			expr += "2";
+			std::string closed = expr + std::string(depth, ')');
+
+			for(const std::string& text : { expr, closed }) {
+				Result expected = bocan::Evaluate(text);
+				Result actual = calc::Solve(text);
+				if(expected.error_code != actual.error_code || expected.error_position != actual.error_position || expected.value.integer != actual.value.integer) {
+					if(mismatches < 10) { std::printf("MISMATCH %d DEEP '%s...' %d@%zu AGAINST %d@%zu\n", depth, open, expected.error_code, expected.error_position, actual.error_code, actual.error_position); }
+					mismatches++;
+				}
+			}
+		}
+	}
+
+	std::printf("EXPRESSIONS %lu ERRORS %lu ROUNDED %lu POWERS %lu EXACT %lu MISMATCHES %lu\n", count, errors, rounded, powers, exact, mismatches);
+
+	// what a fixed formula costs when it is parsed every time, against a value folded into the program
+	const std::string_view formula = "2*(12-5)^2";
+	const unsigned long iterations = 1000000;
+	double sum = 0;
+
+	Stopwatch watch;
+	for(unsigned long i = 0; i < iterations; i++) { sum += bocan::Evaluate(formula).value.floating; }
+	double seconds = watch.Seconds();
+
+	std::printf("SOLVED AT RUN TIME %.1f NS, FOLDED %g (%g)\n", seconds * 1e9 / iterations, k_area.value.floating, sum);
+
+	return mismatches ? 1 : 0;
+}
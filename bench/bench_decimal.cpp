@@ -0,0 +1,175 @@
+//
+// BENCH_DECIMAL.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../src/bigint/bigint.hpp"
+#include "../src/decimal/decimal.hpp"
+#include "../src/number/number.hpp"
+#include "../src/solver/solver.hpp"
+
+///
+/// @brief checks each rounding mode on known cases, then solves long chains of cent amounts with the double,
+/// @brief decimal and big integer paths, counting inexact double results and timing all three.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the number of chains and the terms per chain.
+/// @return 0 on success, 1 if a decimal result is wrong.
+/// @todo
+///
+int bocan::BenchDecimal(int argc, char** argv) {
+
+	unsigned long chains = 2000;
+	unsigned long terms = 200;
+	if(argc > 0) { chains = std::strtoul(argv[0], nullptr, 10); }
+	if(argc > 1) { terms = std::strtoul(argv[1], nullptr, 10); }
+	if(chains == 0) { chains = 1; }
+	if(terms == 0) { terms = 1; }
+
+	Solver solver;
+	Solution solution;
+	Decimal decimal;
+	char text[Decimal::FORMAT_SIZE + 1];
+	unsigned long mismatches = 0;
+
+	// every mode on ties, on values between ties and on negatives
+	struct check {
+		const char*		expr;
+		int				scale;
+		rounding_mode	rounding;
+		const char*		expected;
+	};
+	const check checks[] = {
+		{ "2.5", 0, ROUND_HALF_EVEN, "2" },		{ "3.5", 0, ROUND_HALF_EVEN, "4" },
+		{ "-2.5", 0, ROUND_HALF_EVEN, "-2" },	{ "2.5", 0, ROUND_HALF_UP, "3" },
+		{ "-2.5", 0, ROUND_HALF_UP, "-3" },		{ "2.7", 0, ROUND_DOWN, "2" },
+		{ "-2.7", 0, ROUND_DOWN, "-2" },		{ "2.1", 0, ROUND_UP, "3" },
+		{ "-2.1", 0, ROUND_UP, "-3" },			{ "-2.1", 0, ROUND_FLOOR, "-3" },
+		{ "2.1", 0, ROUND_CEILING, "3" },		{ "-2.1", 0, ROUND_CEILING, "-2" },
+		{ "1/3", 2, ROUND_HALF_EVEN, "0.33" },	{ "2/3", 2, ROUND_DOWN, "0.66" },
+		{ "1/3", 2, ROUND_UP, "0.34" },			{ "0.1+0.2", 2, ROUND_HALF_EVEN, "0.30" },
+		{ "19.99*3", 2, ROUND_HALF_EVEN, "59.97" },	{ "0.125*1", 2, ROUND_HALF_EVEN, "0.12" },
+		{ "1.005", 2, ROUND_HALF_UP, "1.01" },	{ "1.005", 2, ROUND_HALF_EVEN, "1.00" },
+		{ "--2.1", 0, ROUND_FLOOR, "2" },		{ "-(2.1)", 0, ROUND_FLOOR, "-3" },	{ "1.1^2", 2, ROUND_HALF_EVEN, "1.21" },
+		{ "2^-2", 2, ROUND_HALF_EVEN, "0.25" },	{ "92233720368547758.07+1", 2, ROUND_HALF_EVEN, "92233720368547759.07" },
+		{ "1.5e-3", 3, ROUND_HALF_EVEN, "0.002" },	{ "0.0000000000000000000000000000000000000000051", 2, ROUND_UP, "0.01" },
+	};
+
+	for(const check& c : checks) {
+		DecimalFormat format;
+		format.scale = c.scale;
+		format.rounding = c.rounding;
+
+		bool err = solver.Tokenize(c.expr, std::strlen(c.expr), &solution) || solver.EvaluateDecimal(format, &decimal, &solution);
+		text[err ? 0 : decimal.Format(format.scale, text)] = '\0';
+
+		if(err || std::strcmp(text, c.expected) != 0) {
+			if(mismatches++ < 10) { std::fprintf(stderr, ">MISMATCH '%s' GAVE '%s' EXPECTED '%s'\n", c.expr, text, c.expected); }
+		}
+	}
+	std::printf("ROUNDING CHECKS %zu MISMATCHES %lu\n", sizeof(checks) / sizeof(checks[0]), mismatches);
+
+	// chains of cent amounts, the same chain in cents for the big integer path, and its exact total
+	std::mt19937_64 random(14);
+	std::vector<std::string> amounts(chains);
+	std::vector<std::string> cents(chains);
+	std::vector<long> totals(chains);
+
+	for(unsigned long c = 0; c < chains; c++) {
+		long total = 0;
+		for(unsigned long t = 0; t < terms; t++) {
+			long value = static_cast<long>(random() % 100000);
+			bool minus = t && random() % 3 == 0;
+			if(t) {
+				amounts[c] += minus ? '-' : '+';
+				cents[c] += minus ? '-' : '+';
+			}
+			char amount[32];
+			std::snprintf(amount, sizeof(amount), "%ld.%02ld", value / 100, value % 100);
+			amounts[c] += amount;
+			cents[c] += std::to_string(value);
+			total += minus ? -value : value;
+		}
+		totals[c] = total;
+	}
+
+	DecimalFormat cents_format;
+	unsigned long inexact = 0;
+	unsigned long wrong = 0;
+	double seconds[3] = { 0, 0, 0 };
+
+	// splitting the text into tokens is the same work on every path
+	Stopwatch tokenize_watch;
+	for(unsigned long c = 0; c < chains; c++) {
+		if(solver.Tokenize(amounts[c].data(), amounts[c].size(), &solution)) { return 1; }
+	}
+	double tokenize = tokenize_watch.Seconds();
+
+	for(int path = 0; path < 3; path++) {
+
+		BigInt big;
+		Stopwatch watch;
+
+		for(unsigned long c = 0; c < chains; c++) {
+			const std::string& expr = path == 2 ? cents[c] : amounts[c];
+			if(solver.Tokenize(expr.data(), expr.size(), &solution)) { return 1; }
+
+			if(path == 0) {
+				solver.Evaluate(&solution);
+				// the exact total and the double nearest to it
+				char exact[32];
+				std::snprintf(exact, sizeof(exact), "%s%ld.%02ld", totals[c] < 0 ? "-" : "", std::labs(totals[c]) / 100, std::labs(totals[c]) % 100);
+				if(solution.real != std::strtod(exact, nullptr)) { inexact++; }
+			} else if(path == 1) {
+				solver.EvaluateDecimal(cents_format, &decimal, &solution);
+				text[decimal.Format(cents_format.scale, text)] = '\0';
+				char exact[32];
+				std::snprintf(exact, sizeof(exact), "%s%ld.%02ld", totals[c] < 0 ? "-" : "", std::labs(totals[c]) / 100, std::labs(totals[c]) % 100);
+				if(std::strcmp(text, exact) != 0) { wrong++; }
+			} else {
+				solver.EvaluateBig(&big, &solution);
+			}
+		}
+		seconds[path] = watch.Seconds();
+	}
+
+	std::printf("%lu CHAINS OF %lu AMOUNTS\n", chains, terms);
+	std::printf("TOKENIZING %.1f NS/TERM ON EVERY PATH\n", tokenize * 1e9 / (chains * terms));
+	std::printf("%-10s %-12s %-12s %-16s %-10s\n", "PATH", "US/CHAIN", "NS/TERM", "SOLVE NS/TERM", "INEXACT");
+
+	const char* names[3] = { "double", "decimal", "bigint" };
+	for(int path = 0; path < 3; path++) {
+		double per_term = seconds[path] * 1e9 / (chains * terms);
+		std::printf("%-10s %-12.2f %-12.1f %-16.1f ", names[path], seconds[path] * 1e6 / chains, per_term, per_term - tokenize * 1e9 / (chains * terms));
+		if(path == 2) {
+			std::printf("%-10s\n", "-");
+		} else {
+			std::printf("%-10lu\n", path == 0 ? inexact : wrong);
+		}
+	}
+
+	return mismatches || wrong ? 1 : 0;
+}
@@ -0,0 +1,174 @@
+//
+// BENCH_FORK.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "../src/lexer/lexer.hpp"
+#include "../src/parser/parser.hpp"
+#include "../src/evaluator/evaluator.hpp"
+#include "../src/thread_pool/thread_pool.hpp"
+
+namespace {
+
+// a random parenthesized term of whole numbers, or of decimals with divisions
+void AppendTerm(std::mt19937_64& random, bool floating, int depth, std::string* expr) {
+
+	if(depth == 0) {
+		*expr += std::to_string(1 + random() % 9);
+		if(floating) { *expr += "." + std::to_string(random() % 100); }
+		return;
+	}
+
+	static const char k_integer_operators[] = "+-*";
+	static const char k_float_operators[] = "+-*/";
+
+	char oper = floating ? k_float_operators[random() % 4] : k_integer_operators[random() % 3];
+
+	// a divisor is a literal, so it is never zero
+	*expr += '(';
+	AppendTerm(random, floating, depth - 1, expr);
+	*expr += oper;
+	AppendTerm(random, floating, oper == '/' ? 0 : depth - 1, expr);
+	*expr += ')';
+}
+
+// thousands of independent top-level terms joined by '+' and '*', as in the generated expressions
+std::string GenerateTerms(std::uint64_t seed, std::size_t terms, bool floating) {
+	std::mt19937_64 random(seed);
+	std::string expr;
+	for(std::size_t i = 0; i < terms; i++) {
+		if(i) { expr += random() % 4 ? '+' : '*'; }
+		AppendTerm(random, floating, 2 + static_cast<int>(random() % 3), &expr);
+	}
+	return expr;
+}
+
+struct outcome {
+	bool			err = false;
+	long			integer = 0;
+	double			real = 0;
+	bocan::errors	error_code = bocan::NO_ERROR;
+	std::size_t		error_pos = 0;
+	bool			modulus = false;
+};
+
+bool Same(const outcome& a, const outcome& b) {
+	return a.err == b.err && a.integer == b.integer && std::memcmp(&a.real, &b.real, sizeof(double)) == 0 &&
+		a.error_code == b.error_code && a.error_pos == b.error_pos && a.modulus == b.modulus;
+}
+
+outcome Run(bocan::Evaluator* evaluator, const bocan::Ast& ast) {
+	outcome o;
+	o.err = ast.floating ? evaluator->Evaluate(ast, &o.real) : evaluator->Evaluate(ast, &o.integer);
+	o.error_code = evaluator->GetErrorCode();
+	o.error_pos = evaluator->GetErrorPosition();
+	o.modulus = evaluator->GetModulusFlag();
+	return o;
+}
+
+} // NAMESPACE
+
+///
+/// @brief solves expressions of many independent top-level terms on one thread, then as fork-join tasks on pools of
+/// @brief 2, 4 and 8 threads. every parallel solution, and every error and its position, must be bit-identical to the serial one.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the number of terms and the number of repetitions.
+/// @return 0 on success, 1 if a parallel solution differs.
+/// @todo
+///
+int bocan::BenchFork(int argc, char** argv) {
+
+	unsigned long terms = 20000;
+	unsigned long repeat = 20;
+	if(argc > 0) { terms = std::strtoul(argv[0], nullptr, 10); }
+	if(argc > 1) { repeat = std::strtoul(argv[1], nullptr, 10); }
+	if(repeat == 0) { repeat = 1; }
+
+	struct input {
+		const char*	name;
+		std::string	expr;
+	};
+
+	std::vector<input> inputs = {
+		{ "doubles", GenerateTerms(22, terms, true) },
+		{ "integers", GenerateTerms(23, terms, false) },
+		{ "small", GenerateTerms(24, 10, true) },
+	};
+
+	// a divide by zero early in the text and another late, so the first by node order has to win
+	std::string errors = GenerateTerms(25, terms, true);
+	errors.insert(errors.size() / 3, "(1/0)+");
+	errors.insert(errors.size() * 2 / 3, "(2/0)*");
+	inputs.push_back({ "divide by zero", errors });
+
+	std::printf("THREADS AVAILABLE %u\n", std::thread::hardware_concurrency());
+	std::printf("%-16s %-10s %-8s %-12s %-10s %s\n", "INPUT", "NODES", "THREADS", "US", "SPEEDUP", "SAME");
+
+	unsigned long mismatches = 0;
+
+	for(const input& in : inputs) {
+
+		Lexer lexer;
+		Parser parser;
+		std::vector<Token> tokens;
+		Ast ast;
+
+		if(lexer.Tokenize(in.expr.data(), in.expr.size(), &tokens) ||
+		   parser.Parse(in.expr.data(), tokens, lexer.IsFloating(), &ast)) {
+			std::fprintf(stderr, ">UNABLE TO PARSE '%s'\n", in.name);
+			return 1;
+		}
+
+		Evaluator serial;
+		outcome expected = Run(&serial, ast);
+
+		Stopwatch serial_watch;
+		for(unsigned long r = 0; r < repeat; r++) { Run(&serial, ast); }
+		double serial_time = serial_watch.Seconds() / repeat;
+		std::printf("%-16s %-10zu %-8u %-12.1f %-10s %s\n", in.name, ast.nodes.size(), 1u, serial_time * 1e6, "1.00", "-");
+
+		for(unsigned int threads : { 2u, 4u, 8u }) {
+
+			ThreadPool pool(threads);
+			Evaluator parallel;
+			parallel.SetPool(&pool);
+
+			bool same = Same(expected, Run(&parallel, ast));
+
+			Stopwatch watch;
+			for(unsigned long r = 0; r < repeat; r++) { same = Same(expected, Run(&parallel, ast)) && same; }
+			double seconds = watch.Seconds() / repeat;
+
+			if(!same) { mismatches++; }
+			std::printf("%-16s %-10zu %-8u %-12.1f %-10.2f %s\n", in.name, ast.nodes.size(), threads, seconds * 1e6,
+				serial_time / seconds, same ? "YES" : "NO <- SHOULD MATCH SERIAL");
+		}
+	}
+
+	std::printf("MISMATCHES %lu\n", mismatches);
+	return mismatches ? 1 : 0;
+}
@@ -0,0 +1,139 @@
+//
+// BENCH_FORMAT.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../src/number/number.hpp"
+
+///
+/// @brief checks that formatted doubles read back as the same bits and formatted longs match printf,
+/// @brief then times both against the printf and to_string conversions they replace.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the number of random values.
+/// @return 0 on success, 1 if any value does not round trip.
+/// @todo
+///
+int bocan::BenchFormat(int argc, char** argv) {
+
+	unsigned long count = 1000000;
+	if(argc > 0) { count = std::strtoul(argv[0], nullptr, 10); }
+	if(count == 0) { count = 1; }
+
+	std::mt19937_64 random(11);
+	char buffer[FORMAT_SIZE + 1];
+	char expected[64];
+	unsigned long mismatches = 0;
+	unsigned long longest = 0;
+
+	// random bit patterns cover every exponent, then values typical of results
+	std::vector<double> reals;
+	for(unsigned long i = 0; i < count; i++) {
+		std::uint64_t bits = random();
+		double value = 0;
+		std::memcpy(&value, &bits, sizeof(double));
+		if(std::isfinite(value)) { reals.push_back(value); }
+		reals.push_back(static_cast<double>(random() % 100000) / 100);
+	}
+	const double specials[] = { 0.0, -0.0, 0.1, 0.3, 1e-7, 5e-324, 2.2250738585072014e-308, 1.7976931348623157e308, 9007199254740993.0, 1e22, 1e23 };
+	for(double value : specials) { reals.push_back(value); }
+
+	for(double value : reals) {
+		std::size_t len = FormatDouble(value, buffer);
+		buffer[len] = '\0';
+		if(len > longest) { longest = len; }
+
+		// a leading '-' is an operator in an expression, not part of the literal
+		bool negative = buffer[0] == '-';
+		double parsed = ParseDouble(buffer + negative, len - negative);
+		if(negative) { parsed = -parsed; }
+		if(std::memcmp(&parsed, &value, sizeof(double)) != 0) {
+			if(mismatches++ < 10) { std::fprintf(stderr, ">MISMATCH %.17g FORMATTED '%s'\n", value, buffer); }
+		}
+	}
+
+	std::vector<long> integers;
+	for(unsigned long i = 0; i < count; i++) {
+		integers.push_back(static_cast<long>(random()) >> (random() % 64));
+	}
+	const long extremes[] = { 0, 1, -1, 9, 10, 99, 100, -100, LONG_MAX, LONG_MIN };
+	for(long value : extremes) { integers.push_back(value); }
+
+	for(long value : integers) {
+		std::size_t len = FormatInteger(value, buffer);
+		int expected_len = std::snprintf(expected, sizeof(expected), "%ld", value);
+		if(len != static_cast<std::size_t>(expected_len) || std::memcmp(buffer, expected, len) != 0) {
+			if(mismatches++ < 10) { std::fprintf(stderr, ">MISMATCH %ld\n", value); }
+		}
+	}
+
+	std::printf("CHECKED %zu DOUBLES %zu LONGS MISMATCHES %lu LONGEST %lu\n", reals.size(), integers.size(), mismatches, longest);
+
+	// timing, the fastest of a few rounds
+	struct method {
+		const char*	name;
+		int			kind;
+	};
+	const method methods[] = {
+		{ "printf %f", 0 },
+		{ "to_string", 1 },
+		{ "printf %.17g", 2 },
+		{ "shortest", 3 },
+		{ "printf %ld", 4 },
+		{ "integer", 5 },
+	};
+
+	std::printf("%-14s %-10s\n", "METHOD", "NS/VALUE");
+
+	volatile std::size_t sink = 0;
+
+	for(const method& m : methods) {
+
+		double best = 0;
+		std::size_t values = m.kind < 4 ? reals.size() : integers.size();
+
+		for(int round = 0; round < 3; round++) {
+			Stopwatch watch;
+			for(std::size_t i = 0; i < values; i++) {
+				switch(m.kind) {
+					case 0: sink = sink + std::snprintf(expected, sizeof(expected), "%f", reals[i]); break;
+					case 1: sink = sink + std::to_string(reals[i]).size(); break;
+					case 2: sink = sink + std::snprintf(expected, sizeof(expected), "%.17g", reals[i]); break;
+					case 3: sink = sink + FormatDouble(reals[i], buffer); break;
+					case 4: sink = sink + std::snprintf(expected, sizeof(expected), "%ld", integers[i]); break;
+					default: sink = sink + FormatInteger(integers[i], buffer); break;
+				}
+			}
+			double seconds = watch.Seconds();
+			if(round == 0 || seconds < best) { best = seconds; }
+		}
+		std::printf("%-14s %-10.1f\n", m.name, best * 1e9 / values);
+	}
+
+	return mismatches ? 1 : 0;
+}
@@ -0,0 +1,165 @@
+//
+// BENCH_JIT.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../src/expression/expression.hpp"
+#include "../src/jit/jit.hpp"
+#include "../src/solver/solver.hpp"
+
+namespace {
+
+// a random expression over a, b and c. integral expressions leave out '/', '^' and fractions
+std::string Term(std::mt19937_64& random, int depth, bool integral) {
+
+	if(depth == 0 || random() % 4 == 0) {
+		switch(random() % 5) {
+			case 0:		return "a";
+			case 1:		return "b";
+			case 2:		return "c";
+			case 3:		return integral ? std::to_string(random() % 10) : "0." + std::to_string(random() % 100);
+			default:	return std::to_string(random() % 1000);
+		}
+	}
+
+	const char* operators = integral ? "+-*" : "+-*/^";
+	char op = operators[random() % (integral ? 3 : 5)];
+	if(random() % 8 == 0) { return "-(" + Term(random, depth - 1, integral) + ")"; }
+	if(op == '^') { return "(" + Term(random, depth - 1, integral) + ")^" + std::to_string(random() % 4); }
+	return "(" + Term(random, depth - 1, integral) + op + Term(random, depth - 1, integral) + ")";
+}
+
+// values that reach every branch of the native code: zeros of both signs, NaN and infinities
+double Value(std::mt19937_64& random) {
+	switch(random() % 10) {
+		case 0:		return 0.0;
+		case 1:		return -0.0;
+		case 2:		return std::numeric_limits<double>::quiet_NaN();
+		case 3:		return random() % 2 ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity();
+		default:	return (static_cast<double>(random() % 2000000) - 1000000) / 1000;
+	}
+}
+
+} // NAMESPACE
+
+///
+/// @brief solves random expressions of a, b and c row by row, interpreted and as native code, and checks that
+/// @brief every solution and error matches bit for bit. integral expressions are solved with longs as well. then
+/// @brief times a hot expression both ways.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the number of expressions and the number of rows of each.
+/// @return 0 on success, 1 if a solution differs or no native code could be compiled.
+/// @todo
+///
+int bocan::BenchJit(int argc, char** argv) {
+
+	unsigned long count = 2000;
+	unsigned long rows = Expression::JIT_THRESHOLD + 200;
+	if(argc > 0) { count = std::strtoul(argv[0], nullptr, 10); }
+	if(argc > 1) { rows = std::strtoul(argv[1], nullptr, 10); }
+
+	if(!Jit::IsSupported()) {
+		std::printf("NATIVE CODE IS NOT SUPPORTED ON THIS MACHINE\n");
+		return 0;
+	}
+
+	std::mt19937_64 random(25);
+
+	unsigned long mismatches = 0;
+	unsigned long solved = 0;
+	unsigned long compiled = 0;
+	unsigned long errors = 0;
+
+	for(unsigned long e = 0; e < count; e++) {
+
+		const bool integral = e % 4 == 0;
+		const std::string text = Term(random, 6, integral);
+
+		Expression interpreted;
+		Expression native;
+		Solution solution;
+		if(interpreted.Compile(text.data(), text.size(), &solution) || native.Compile(text.data(), text.size(), &solution)) { continue; }
+		native.SetJit(true);
+		solved++;
+
+		for(unsigned long r = 0; r < rows; r++) {
+
+			Solution expected;
+			Solution actual;
+
+			if(native.IsIntegral() && r % 2) {
+				long values[3] = { static_cast<long>(random()), static_cast<long>(random() % 100) - 50, 0 };
+				interpreted.Evaluate(values, &expected);
+				native.Evaluate(values, &actual);
+			} else {
+				double values[3] = { Value(random), Value(random), Value(random) };
+				interpreted.Evaluate(values, &expected);
+				native.Evaluate(values, &actual);
+			}
+
+			if(expected.error_code != NO_ERROR) { errors++; }
+			if(!SameSolution(expected, actual)) {
+				if(mismatches < 10) { std::printf("MISMATCH %s ROW %lu\n", text.c_str(), r); }
+				mismatches++;
+			}
+		}
+
+		if(native.IsNative() || native.GetVariableCount() == 0) { compiled++; }
+	}
+
+	std::printf("EXPRESSIONS %lu ROWS %lu NATIVE %lu ERRORS %lu MISMATCHES %lu\n", solved, rows, compiled, errors, mismatches);
+
+	// a hot expression, solved over many rows once it is native
+	const std::string hot = "(a*1.5+b*2.25-c)*(a-b)/(c+1000)+a*a*0.5-b*c+(a+b+c)^2";
+	const unsigned long iterations = 2000000;
+
+	std::printf("%-12s %-12s\n", "MODE", "NS/ROW");
+
+	for(bool jit : { false, true }) {
+
+		Expression expression;
+		Solution solution;
+		expression.Compile(hot.data(), hot.size(), &solution);
+		expression.SetJit(jit);
+
+		double values[3] = { 1.25, 2.5, 3.75 };
+		double sum = 0;
+
+		Stopwatch watch;
+		for(unsigned long i = 0; i < iterations; i++) {
+			values[0] = static_cast<double>(i & 1023);
+			expression.Evaluate(values, &solution);
+			sum += solution.real;
+		}
+		double seconds = watch.Seconds();
+
+		std::printf("%-12s %-12.2f (%g)\n", jit ? "native" : "interpreted", seconds * 1e9 / iterations, sum);
+	}
+
+	return mismatches || compiled < solved ? 1 : 0;
+}
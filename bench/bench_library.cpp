@@ -0,0 +1,109 @@
+//
+// BENCH_LIBRARY.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+#include "bench.hpp"
+#include "../src/libcalc/libcalc.hpp"
+#include "../src/libcalc/libcalc.h"
+
+namespace {
+
+const char* const k_expressions[] = {
+	"2+3*4",
+	"(18-4)/7+6*3",
+	"-3*(12+7)-(4^3)/2",
+	"1.5*(2.25+3)/0.5",
+	"100/(5-5)",
+};
+
+} // NAMESPACE
+
+///
+/// @brief measures the cost of one in-process evaluation through the C++ and C entry points,
+/// @brief and counts the heap allocations made once the calling thread's solver is warm.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the number of calls per expression.
+/// @return 0 on success, 1 if the steady state allocated.
+/// @todo
+///
+int bocan::BenchLibrary(int argc, char** argv) {
+
+	unsigned long calls = 200000;
+	if(argc > 0) { calls = std::strtoul(argv[0], nullptr, 10); }
+	if(calls == 0) { calls = 1; }
+
+	// warm up the solver so its scratch storage reaches its working size
+	for(const char* expr : k_expressions) { Evaluate(expr); }
+
+	std::printf("%-20s %-8s %-12s %-12s %-8s\n", "EXPRESSION", "API", "NS/CALL", "RESULT", "ALLOCS");
+
+	bool allocated = false;
+	volatile long sink = 0;
+
+	for(const char* expr : k_expressions) {
+
+		std::size_t size = std::strlen(expr);
+
+		for(int api = 0; api < 2; api++) {
+
+			unsigned long before = GetAllocationCount();
+			Result result{};
+			calc_result c_result{};
+
+			Stopwatch watch;
+			for(unsigned long i = 0; i < calls; i++) {
+				if(api == 0) {
+					result = Evaluate(std::string_view(expr, size));
+					sink = sink + result.value.integer;
+				} else {
+					c_result = calc_evaluate(expr, size);
+					sink = sink + c_result.value.integer;
+				}
+			}
+			double seconds = watch.Seconds();
+
+			unsigned long allocations = GetAllocationCount() - before;
+			if(allocations) { allocated = true; }
+
+			char text[32];
+			int code = api == 0 ? result.error_code : c_result.error_code;
+			if(code != CALC_NO_ERROR) {
+				std::snprintf(text, sizeof(text), "ERROR %d", code);
+			} else if(api == 0 ? result.type == RESULT_FLOATING : c_result.type == CALC_RESULT_FLOATING) {
+				std::snprintf(text, sizeof(text), "%g", api == 0 ? result.value.floating : c_result.value.floating);
+			} else {
+				std::snprintf(text, sizeof(text), "%ld", api == 0 ? result.value.integer : c_result.value.integer);
+			}
+
+			std::printf("%-20s %-8s %-12.1f %-12s %-8lu\n", expr, api == 0 ? "C++" : "C",
+				seconds * 1e9 / calls, text, allocations);
+		}
+	}
+
+	if(allocated) {
+		std::fprintf(stderr, ">ERROR. THE STEADY STATE ALLOCATED MEMORY.\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,209 @@
+//
+// BENCH_NUMBERS.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../src/number/number.hpp"
+
+namespace {
+
+struct tally {
+	unsigned long	checked;
+	unsigned long	mismatches;
+};
+
+///
+/// @brief converts one literal both ways and counts it. the first few mismatches are printed.
+/// @param[in] char pointer to the null terminated literal.
+/// @param[in] size_t is the length of the literal.
+/// @param[in,out] tally pointer counting the literals.
+/// @return
+/// @todo
+///
+void Check(const char* literal, std::size_t len, tally* count) {
+
+	double expected = std::strtod(literal, nullptr);
+	double parsed = bocan::ParseDouble(literal, len);
+
+	count->checked++;
+	if(std::memcmp(&expected, &parsed, sizeof(double)) != 0) {
+		if(count->mismatches++ < 10) {
+			std::fprintf(stderr, ">MISMATCH '%s' STRTOD %.17g PARSED %.17g\n", literal, expected, parsed);
+		}
+	}
+}
+
+///
+/// @brief the conversion the parser used before, one std::pow call per digit. kept as the baseline.
+/// @param[in] char pointer to the literal.
+/// @param[in] size_t is the length of the literal.
+/// @return double approximately equal to the literal.
+/// @todo
+///
+double ParsePerDigit(const char* digits, std::size_t len) {
+
+	double op = 0;
+	int pos = 0;
+	std::size_t decimal_pos = len;
+
+	for(std::size_t i = 0; i < len; i++) {
+		if(digits[i] == '.') { decimal_pos = i; }
+	}
+	for(std::size_t i = decimal_pos; i > 0; i--) {
+		op = op + ( (digits[i - 1] - '0') * std::pow(10, pos) );
+		pos++;
+	}
+	pos = -1;
+	for(std::size_t i = decimal_pos + 1; i < len; i++) {
+		op = op + ( (digits[i] - '0') * std::pow(10, pos) );
+		pos--;
+	}
+	return op;
+}
+
+///
+/// @brief converts a literal with the C library, copying it first as a caller holding a token must.
+/// @param[in] char pointer to the literal.
+/// @param[in] size_t is the length of the literal.
+/// @return double nearest to the literal.
+/// @todo
+///
+double ParseStrtod(const char* digits, std::size_t len) {
+	char buffer[64];
+	std::memcpy(buffer, digits, len);
+	buffer[len] = '\0';
+	return std::strtod(buffer, nullptr);
+}
+
+} // NAMESPACE
+
+///
+/// @brief checks ParseDouble() against std::strtod over every short decimal, every radix position and a sweep of exponents,
+/// @brief random round trip literals and very long literals, then times it against the old per-digit conversion.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the number of random literals.
+/// @return 0 on success, 1 if any literal converts differently.
+/// @todo
+///
+int bocan::BenchNumbers(int argc, char** argv) {
+
+	unsigned long randoms = 1000000;
+	if(argc > 0) { randoms = std::strtoul(argv[0], nullptr, 10); }
+
+	char literal[512];
+	tally count = { 0, 0 };
+	std::mt19937_64 random(10);
+
+	// every literal of up to six digits, with the radix point in every position
+	for(unsigned long digits = 1; digits <= 6; digits++) {
+		unsigned long limit = 1;
+		for(unsigned long d = 0; d < digits; d++) { limit *= 10; }
+
+		for(unsigned long value = 0; value < limit; value++) {
+			std::snprintf(literal, sizeof(literal), "%0*lu", static_cast<int>(digits), value);
+			Check(literal, digits, &count);
+
+			for(unsigned long radix = 0; radix <= digits; radix++) {
+				std::memmove(literal + radix + 1, literal + radix, digits - radix + 1);
+				literal[radix] = '.';
+				Check(literal, digits + 1, &count);
+				std::memmove(literal + radix, literal + radix + 1, digits - radix + 1);
+			}
+		}
+	}
+
+	// up to four significant digits over the whole range of exponents, including subnormals and overflow
+	for(unsigned long value = 1; value < 10000; value += 1 + value / 100) {
+		for(int exponent = -345; exponent <= 330; exponent++) {
+			int len = std::snprintf(literal, sizeof(literal), "%lue%d", value, exponent);
+			Check(literal, static_cast<std::size_t>(len), &count);
+		}
+	}
+
+	// random doubles written with 15 to 17 significant digits
+	for(unsigned long i = 0; i < randoms; i++) {
+		std::uint64_t bits = random();
+		double value = 0;
+		std::memcpy(&value, &bits, sizeof(double));
+		if(!std::isfinite(value)) { continue; }
+		int len = std::snprintf(literal, sizeof(literal), "%.*e", 14 + static_cast<int>(i % 3), std::fabs(value));
+		Check(literal, static_cast<std::size_t>(len), &count);
+	}
+
+	// literals with more digits than the fast path holds, and longer than the stack buffer
+	for(unsigned long i = 0; i < 10000; i++) {
+		std::size_t len = 1 + random() % 300;
+		for(std::size_t j = 0; j < len; j++) { literal[j] = static_cast<char>('0' + random() % 10); }
+		literal[random() % len] = '.';
+		literal[len] = '\0';
+		Check(literal, len, &count);
+	}
+
+	std::printf("CHECKED %lu LITERALS MISMATCHES %lu\n", count.checked, count.mismatches);
+
+	// timing: a number-heavy list of literals of the kinds that appear in expressions
+	std::vector<std::string> literals;
+	for(unsigned long i = 0; i < 200000; i++) {
+		switch(i % 4) {
+			case 0: std::snprintf(literal, sizeof(literal), "%lu", random() % 100000); break;
+			case 1: std::snprintf(literal, sizeof(literal), "%lu.%02lu", random() % 1000, random() % 100); break;
+			case 2: std::snprintf(literal, sizeof(literal), "0.%06lu", random() % 1000000); break;
+			default: std::snprintf(literal, sizeof(literal), "%lu.%lu", random() % 100000, random() % 100000000); break;
+		}
+		literals.push_back(literal);
+	}
+
+	struct method {
+		const char*	name;
+		double		(*parse)(const char*, std::size_t);
+	};
+	const method methods[] = {
+		{ "per-digit", ParsePerDigit },
+		{ "strtod", ParseStrtod },
+		{ "parse", ParseDouble },
+	};
+
+	std::printf("%-10s %-10s %-10s\n", "METHOD", "NS/NUMBER", "SPEEDUP");
+
+	double base = 0;
+	volatile double sink = 0;
+
+	for(const method& m : methods) {
+		double best = 0;
+		for(int round = 0; round < 5; round++) {
+			Stopwatch watch;
+			for(const std::string& text : literals) { sink = sink + m.parse(text.data(), text.size()); }
+			double seconds = watch.Seconds();
+			if(round == 0 || seconds < best) { best = seconds; }
+		}
+		if(base == 0) { base = best; }
+		std::printf("%-10s %-10.2f %-10.2f\n", m.name, best * 1e9 / literals.size(), base / best);
+	}
+
+	return count.mismatches ? 1 : 0;
+}
@@ -0,0 +1,190 @@
+//
+// BENCH_PROGRAM_FILE.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <unistd.h>
+
+#include "bench.hpp"
+#include "../src/bytecode/bytecode.hpp"
+#include "../src/program_file/program_file.hpp"
+#include "../src/solver/solver.hpp"
+
+namespace {
+
+// a copy of a file cut to the given size, with one bit flipped at the offset
+std::string Damage(const std::string& bytes, std::size_t offset, std::size_t size) {
+	std::string damaged = bytes.substr(0, size);
+	if(offset < damaged.size()) { damaged[offset] ^= 0x10; }
+	return damaged;
+}
+
+// a copy of a file whose first program is said to start far past the end, with a checksum that matches
+std::string MoveFirstProgram(const std::string& bytes) {
+
+	std::string damaged = bytes;
+	unsigned char* data = reinterpret_cast<unsigned char*>(damaged.data());
+
+	bocan::program_file_header header;
+	std::memcpy(&header, data, sizeof(header));
+
+	for(std::uint32_t i = 0; i < header.count; i++) {
+		bocan::program_file_entry entry;
+		unsigned char* at = data + sizeof(header) + i * sizeof(entry);
+		std::memcpy(&entry, at, sizeof(entry));
+		if(!entry.program) { continue; }
+
+		entry.program = std::uint64_t(1) << 40;
+		std::memcpy(at, &entry, sizeof(entry));
+		break;
+	}
+
+	header.checksum = bocan::ProgramFile::Checksum(data + sizeof(header), damaged.size() - sizeof(header));
+	std::memcpy(data, &header, sizeof(header));
+	return damaged;
+}
+
+// writes a damaged file and checks that it is rejected
+bool Rejects(const std::string& damaged, const std::string& path) {
+
+	std::FILE* out = std::fopen(path.c_str(), "wb");
+	if(!out) { return false; }
+	std::fwrite(damaged.data(), 1, damaged.size(), out);
+	std::fclose(out);
+
+	bocan::ProgramFile file;
+	bool rejected = file.Open(path.c_str());
+	std::printf("%-28s %s\n", rejected ? file.GetFailure() : "ACCEPTED", rejected ? "" : "<- SHOULD BE REJECTED");
+	return rejected;
+}
+
+} // NAMESPACE
+
+///
+/// @brief compiles a library of formulas to a file, then compares loading and running it against lexing and parsing the
+/// @brief text of every formula. the results must be identical, and damaged or stale files must be rejected.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the number of formulas.
+/// @return 0 on success, 1 if a result differs or a damaged file is accepted.
+/// @todo
+///
+int bocan::BenchProgramFile(int argc, char** argv) {
+
+	unsigned long formulas = 50000;
+	if(argc > 0) { formulas = std::strtoul(argv[0], nullptr, 10); }
+	if(formulas == 0) { formulas = 1; }
+
+	// a name is invalid input to the solver, and must not compile either
+	std::string corpus = GenerateMixedCorpus(20, formulas) + "rate*2\n";
+	std::string path = "/tmp/calc-bench-" + std::to_string(::getpid()) + ".calcbin";
+	std::string damaged_path = path + ".damaged";
+
+	std::vector<std::string_view> lines;
+	std::string_view text(corpus);
+	for(std::size_t begin = 0; begin < text.size(); ) {
+		std::size_t end = text.find('\n', begin);
+		lines.push_back(text.substr(begin, end - begin));
+		begin = end + 1;
+	}
+
+	// what every run pays today: every formula is lexed, checked and parsed before it can be solved
+	Solver solver;
+	Bytecode program;
+	Solution solution;
+	Stopwatch compile_watch;
+	for(std::string_view line : lines) { solver.Compile(line.data(), line.size(), &program, &solution); }
+	double compile = compile_watch.Seconds();
+
+	std::vector<Solution> expected(lines.size());
+	Stopwatch solve_watch;
+	for(std::size_t i = 0; i < lines.size(); i++) { solver.Solve(lines[i].data(), lines[i].size(), &expected[i]); }
+	double solve = solve_watch.Seconds();
+
+	unsigned long errors = 0;
+	Stopwatch write_watch;
+	if(ProgramFile::Write(corpus.data(), corpus.size(), path.c_str(), &errors)) {
+		std::fprintf(stderr, ">ERROR. UNABLE TO WRITE '%s'.\n", path.c_str());
+		return 1;
+	}
+	double write = write_watch.Seconds();
+
+	ProgramFile file;
+	Stopwatch open_watch;
+	if(file.Open(path.c_str())) {
+		std::fprintf(stderr, ">ERROR. UNABLE TO LOAD '%s'. %s.\n", path.c_str(), file.GetFailure());
+		return 1;
+	}
+	double open = open_watch.Seconds();
+
+	Vm vm;
+	BytecodeView view;
+	std::vector<Solution> results(file.GetCount());
+	Stopwatch run_watch;
+	for(std::size_t i = 0; i < file.GetCount(); i++) {
+		if(!file.Get(i, &view, &results[i])) { vm.Run(view, nullptr, &results[i]); }
+	}
+	double run = run_watch.Seconds();
+
+	unsigned long mismatches = file.GetCount() == lines.size() ? 0 : 1;
+	for(std::size_t i = 0; i < results.size() && i < expected.size(); i++) {
+		if(!SameSolution(results[i], expected[i]) && mismatches++ < 5) {
+			std::fprintf(stderr, ">MISMATCH ON LINE %zu\n", i + 1);
+		}
+	}
+
+	std::printf("FORMULAS %zu BYTES %zu COMPILE ERRORS %lu\n", lines.size(), corpus.size(), errors);
+	std::printf("%-28s %-12s\n", "STEP", "MS");
+	std::printf("%-28s %-12.3f\n", "lex and parse the text", compile * 1e3);
+	std::printf("%-28s %-12.3f\n", "solve the text", solve * 1e3);
+	std::printf("%-28s %-12.3f\n", "write the file", write * 1e3);
+	std::printf("%-28s %-12.3f\n", "map and check the file", open * 1e3);
+	std::printf("%-28s %-12.3f\n", "run from the file", run * 1e3);
+	std::printf("STARTUP SPEEDUP %.1f\n", compile / open);
+
+	// the whole file is read back and damaged in a few places
+	std::string bytes;
+	{
+		std::FILE* in = std::fopen(path.c_str(), "rb");
+		char buffer[1 << 16];
+		std::size_t count = 0;
+		while(in && (count = std::fread(buffer, 1, sizeof(buffer), in)) > 0) { bytes.append(buffer, count); }
+		if(in) { std::fclose(in); }
+	}
+	file.Close();
+
+	bool rejected = Rejects(Damage(bytes, 0, bytes.size()), damaged_path);
+	rejected = Rejects(Damage(bytes, offsetof(program_file_header, version), bytes.size()), damaged_path) && rejected;
+	rejected = Rejects(Damage(bytes, bytes.size() / 2, bytes.size()), damaged_path) && rejected;
+	rejected = Rejects(Damage(bytes, bytes.size(), bytes.size() - 8), damaged_path) && rejected;
+	rejected = Rejects(MoveFirstProgram(bytes), damaged_path) && rejected;
+
+	std::remove(path.c_str());
+	std::remove(damaged_path.c_str());
+
+	std::printf("MISMATCHES %lu\n", mismatches);
+	return (mismatches || !rejected) ? 1 : 0;
+}
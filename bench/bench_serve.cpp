@@ -0,0 +1,277 @@
+//
+// BENCH_SERVE.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "bench.hpp"
+#include "../src/number/number.hpp"
+#include "../src/server/server.hpp"
+#include "../src/solver/solver.hpp"
+
+namespace {
+
+// what one load generating client saw
+struct client {
+	std::vector<std::string_view>	lines;
+	std::vector<std::string>		expected;
+	bocan::LatencyHistogram			latency;
+	unsigned long					mismatches = 0;
+	bool							failed = false;
+};
+
+// opens a blocking connection to the server's socket
+int Connect(const char* path) {
+
+	int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if(fd < 0) { return -1; }
+
+	sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	std::strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+
+	if(::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+		::close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+bool SendAll(int fd, const char* data, std::size_t size) {
+	while(size) {
+		ssize_t count = ::send(fd, data, size, MSG_NOSIGNAL);
+		if(count <= 0) { return 1; }
+		data += count;
+		size -= static_cast<std::size_t>(count);
+	}
+	return 0;
+}
+
+// the answer the server should give, written the way batch mode writes it
+std::string Expect(bocan::Solver* solver, std::string_view line) {
+
+	bocan::Solution solution;
+	if(solver->Solve(line.data(), line.size(), &solution)) { return "ERROR " + std::to_string(static_cast<int>(solution.error_code)); }
+
+	char buffer[bocan::FORMAT_SIZE];
+	std::size_t len = solution.floating ? bocan::FormatDouble(solution.real, buffer) : bocan::FormatInteger(solution.integer, buffer);
+	return std::string(buffer, len);
+}
+
+// sends every line, keeping up to depth of them waiting for an answer, and checks each answer as it arrives.
+// the latency of a line is from just before it is sent until its answer has been read.
+void RunClient(const char* path, std::size_t depth, client* c) {
+
+	int fd = Connect(path);
+	if(fd < 0) {
+		c->failed = true;
+		return;
+	}
+
+	const std::size_t count = c->lines.size();
+	std::vector<std::chrono::steady_clock::time_point> sent_at(count);
+	std::string request;
+	std::vector<char> input(1 << 16);
+	std::size_t input_size = 0;
+	std::size_t sent = 0;
+	std::size_t received = 0;
+
+	while(received < count) {
+
+		request.clear();
+		auto now = std::chrono::steady_clock::now();
+		while(sent < count && sent - received < depth) {
+			request.append(c->lines[sent]);
+			request += '\n';
+			sent_at[sent++] = now;
+		}
+		if(!request.empty() && SendAll(fd, request.data(), request.size())) {
+			c->failed = true;
+			break;
+		}
+
+		ssize_t read = ::recv(fd, input.data() + input_size, input.size() - input_size, 0);
+		if(read <= 0) {
+			c->failed = true;
+			break;
+		}
+		input_size += static_cast<std::size_t>(read);
+		now = std::chrono::steady_clock::now();
+
+		std::size_t begin = 0;
+		while(true) {
+			const char* newline = static_cast<const char*>(std::memchr(input.data() + begin, '\n', input_size - begin));
+			if(!newline) { break; }
+
+			std::size_t end = static_cast<std::size_t>(newline - input.data());
+			if(std::string_view(input.data() + begin, end - begin) != c->expected[received] && c->mismatches++ < 5) {
+				std::fprintf(stderr, ">MISMATCH '%.*s' GAVE '%.*s' EXPECTED '%s'\n", static_cast<int>(std::min<std::size_t>(c->lines[received].size(), 60)),
+					c->lines[received].data(), static_cast<int>(end - begin), input.data() + begin, c->expected[received].c_str());
+			}
+			c->latency.Record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - sent_at[received]).count()));
+			received++;
+			begin = end + 1;
+		}
+
+		input_size -= begin;
+		std::memmove(input.data(), input.data() + begin, input_size);
+	}
+	::close(fd);
+}
+
+// sends one command and returns the line that answers it
+std::string Query(const char* path, const char* command) {
+
+	int fd = Connect(path);
+	if(fd < 0) { return "UNABLE TO CONNECT"; }
+
+	std::string answer;
+	std::string text = std::string(command) + "\nQUIT\n";
+	if(!SendAll(fd, text.data(), text.size())) {
+		char buffer[512];
+		ssize_t count = 0;
+		while((count = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) { answer.append(buffer, static_cast<std::size_t>(count)); }
+	}
+	::close(fd);
+
+	if(!answer.empty() && answer.back() == '\n') { answer.pop_back(); }
+	return answer;
+}
+
+} // NAMESPACE
+
+///
+/// @brief a load generator for serve mode. several clients each send their own mixed corpus, one with a single
+/// @brief request in flight and then pipelined, check every answer against solving the line here, and report
+/// @brief the throughput and the round trip latency percentiles. the server's own latency percentiles are then
+/// @brief queried with STATS. without --socket a server is started on a thread of this process.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: clients, lines per client, pipeline depth and --socket PATH.
+/// @return 0 on success, 1 if the server could not be reached or an answer differs.
+/// @todo
+///
+int bocan::BenchServe(int argc, char** argv) {
+
+	unsigned long clients = 8;
+	unsigned long lines = 20000;
+	unsigned long depth = 32;
+	const char* path = nullptr;
+
+	int position = 0;
+	for(int i = 0; i < argc; i++) {
+		if(std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+			path = argv[++i];
+			continue;
+		}
+		unsigned long value = std::strtoul(argv[i], nullptr, 10);
+		if(position == 0) { clients = value; }
+		if(position == 1) { lines = value; }
+		if(position == 2) { depth = value; }
+		position++;
+	}
+	if(clients == 0) { clients = 1; }
+	if(lines == 0) { lines = 1; }
+	if(depth == 0) { depth = 1; }
+
+	Server server;
+	std::thread serving;
+	std::string own_path = "/tmp/calc-bench-" + std::to_string(::getpid()) + ".sock";
+
+	if(!path) {
+		path = own_path.c_str();
+		if(server.Listen(path)) { return 1; }
+		serving = std::thread([&server] { server.Run(); });
+	}
+
+	// every client sends its own corpus, so nothing is answered from a cache the others filled
+	Solver solver;
+	std::vector<std::string> corpora(clients);
+	std::vector<client> results(clients);
+
+	for(unsigned long i = 0; i < clients; i++) {
+		corpora[i] = GenerateMixedCorpus(100 + i, lines);
+		std::string_view corpus(corpora[i]);
+		for(std::size_t begin = 0; begin < corpus.size(); ) {
+			std::size_t end = corpus.find('\n', begin);
+			results[i].lines.push_back(corpus.substr(begin, end - begin));
+			results[i].expected.push_back(Expect(&solver, results[i].lines.back()));
+			begin = end + 1;
+		}
+	}
+
+	std::printf("%-8s %-8s %-10s %-10s %-12s %-10s %-10s %-10s %-10s\n", "CLIENTS", "DEPTH", "REQUESTS", "SECONDS", "REQUESTS/S", "P50 US", "P99 US", "P999 US", "MAX US");
+
+	unsigned long mismatches = 0;
+	bool failed = false;
+	const unsigned long depths[] = { 1, depth };
+
+	for(unsigned long d : depths) {
+
+		for(client& c : results) {
+			c.latency.Reset();
+			c.mismatches = 0;
+		}
+
+		Stopwatch watch;
+		std::vector<std::thread> threads;
+		for(unsigned long i = 0; i < clients; i++) {
+			threads.emplace_back(RunClient, path, static_cast<std::size_t>(d), &results[i]);
+		}
+		for(std::thread& t : threads) { t.join(); }
+		double seconds = watch.Seconds();
+
+		// the percentiles of all clients together
+		LatencyHistogram latency;
+		for(const client& c : results) {
+			latency.Add(c.latency);
+			mismatches += c.mismatches;
+			failed = failed || c.failed;
+		}
+
+		unsigned long requests = clients * lines;
+		std::printf("%-8lu %-8lu %-10lu %-10.3f %-12.0f %-10.1f %-10.1f %-10.1f %-10.1f\n", clients, d, requests, seconds, requests / seconds,
+			latency.GetPercentile(0.5) / 1e3, latency.GetPercentile(0.99) / 1e3, latency.GetPercentile(0.999) / 1e3, latency.GetMax() / 1e3);
+
+		if(failed) { break; }
+	}
+
+	std::printf("SERVER %s\n", Query(path, "STATS").c_str());
+
+	if(serving.joinable()) {
+		server.Stop();
+		serving.join();
+	}
+
+	if(failed) { std::fprintf(stderr, ">ERROR. A CLIENT LOST ITS CONNECTION TO '%s'.\n", path); }
+	std::printf("MISMATCHES %lu\n", mismatches);
+	return (failed || mismatches) ? 1 : 0;
+}
@@ -0,0 +1,150 @@
+//
+// BENCH_SHARE.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../src/lexer/lexer.hpp"
+#include "../src/parser/parser.hpp"
+#include "../src/evaluator/evaluator.hpp"
+
+namespace {
+
+// a random parenthesized term of small numbers
+std::string Term(std::mt19937_64& random, int depth) {
+	if(depth == 0) { return std::to_string(1 + random() % 9) + "." + std::to_string(random() % 100); }
+	static const char k_operators[] = "+-*";
+	return "(" + Term(random, depth - 1) + k_operators[random() % 3] + Term(random, depth - 1) + ")";
+}
+
+// expressions as a code generator writes them: every expression draws its terms from a few
+// subterms such as (1.05^12), each scaled by one of a few amounts. unique expressions draw fresh terms.
+std::vector<std::string> Generate(std::uint64_t seed, std::size_t count, bool repetitive) {
+
+	std::mt19937_64 random(seed);
+	std::vector<std::string> expressions;
+
+	for(std::size_t i = 0; i < count; i++) {
+
+		std::vector<std::string> pool;
+		for(int p = 0; p < 4; p++) { pool.push_back(repetitive ? "(1.0" + std::to_string(1 + random() % 9) + "^12)*" + Term(random, 3) : ""); }
+
+		std::string expr;
+		for(int t = 0; t < 32; t++) {
+			if(t) { expr += random() % 2 ? '+' : '-'; }
+			if(repetitive) {
+				expr += std::to_string(100 * (1 + random() % 4)) + "*" + pool[random() % pool.size()];
+			} else {
+				expr += std::to_string(1 + random() % 1000) + "*(1." + std::to_string(random() % 100) + "^" + std::to_string(random() % 20) + ")*" + Term(random, 3);
+			}
+		}
+		expressions.push_back(expr);
+	}
+	return expressions;
+}
+
+} // NAMESPACE
+
+///
+/// @brief parses and solves generated expressions with and without shared subtrees, on a corpus whose
+/// @brief expressions repeat the same subterms and on one whose terms are all different. the solutions must match bit for bit.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the number of expressions in each corpus.
+/// @return 0 on success, 1 if a solution differs.
+/// @todo
+///
+int bocan::BenchShare(int argc, char** argv) {
+
+	unsigned long count = 5000;
+	if(argc > 0) { count = std::strtoul(argv[0], nullptr, 10); }
+
+	struct corpus {
+		const char*					name;
+		std::vector<std::string>	expressions;
+	};
+
+	corpus corpora[] = {
+		{ "repetitive", Generate(23, count, true) },
+		{ "unique", Generate(24, count, false) },
+	};
+
+	std::printf("%-12s %-8s %-12s %-10s %-10s %-10s %-10s\n", "CORPUS", "SHARING", "NODES", "SHARED", "KB", "PARSE NS", "EVAL NS");
+
+	unsigned long mismatches = 0;
+
+	for(const corpus& c : corpora) {
+
+		std::vector<double> expected;
+
+		for(bool share : { false, true }) {
+
+			Lexer lexer;
+			Parser parser;
+			Evaluator evaluator;
+			std::vector<Token> tokens;
+			Ast ast;
+			parser.SetSharing(share);
+
+			std::size_t nodes = 0;
+			std::size_t shared = 0;
+			std::size_t bytes = 0;
+			double parse_time = 0;
+			double evaluate_time = 0;
+
+			for(std::size_t i = 0; i < c.expressions.size(); i++) {
+
+				const std::string& expr = c.expressions[i];
+				lexer.Tokenize(expr.data(), expr.size(), &tokens);
+
+				Stopwatch parse_watch;
+				parser.Parse(expr.data(), tokens, lexer.IsFloating(), &ast);
+				parse_time += parse_watch.Seconds();
+
+				double result = 0;
+				Stopwatch evaluate_watch;
+				bool err = evaluator.Evaluate(ast, &result);
+				evaluate_time += evaluate_watch.Seconds();
+				if(err) { result = -1; }
+
+				nodes += ast.nodes.size();
+				shared += ast.shared;
+				bytes += ast.nodes.size() * sizeof(Node) + ast.floats.size() * sizeof(double);
+
+				if(!share) {
+					expected.push_back(result);
+				} else if(std::memcmp(&expected[i], &result, sizeof(double)) != 0) {
+					mismatches++;
+				}
+			}
+
+			const double n = static_cast<double>(c.expressions.size());
+			std::printf("%-12s %-8s %-12zu %-10zu %-10.1f %-10.0f %-10.0f\n", c.name, share ? "yes" : "no", nodes, shared,
+				bytes / 1024.0, parse_time * 1e9 / n, evaluate_time * 1e9 / n);
+		}
+	}
+
+	std::printf("MISMATCHES %lu\n", mismatches);
+	return mismatches ? 1 : 0;
+}
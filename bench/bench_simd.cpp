@@ -0,0 +1,148 @@
+//
+// BENCH_SIMD.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "../src/expression/expression.hpp"
+#include "../src/kernels/kernels.hpp"
+
+namespace {
+
+// one formula per operator, then a whole formula. the divisors are never zero.
+const char* const k_formulas[] = {
+	"a+b",
+	"a-b",
+	"a*b",
+	"a/b",
+	"-a",
+	"a^b",
+	"a*(b-c)^2/d",
+};
+
+const int ROUNDS = 3;
+
+} // NAMESPACE
+
+///
+/// @brief solves each formula over columns of inputs, one row at a time and then with every kernel set the processor supports.
+/// @brief every kernel set must give exactly the same results as the row at a time path.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the number of rows.
+/// @return 0 on success, 1 if a formula fails or the results differ.
+/// @todo
+///
+int bocan::BenchSimd(int argc, char** argv) {
+
+	unsigned long rows = 1000000;
+	if(argc > 0) { rows = std::strtoul(argv[0], nullptr, 10); }
+	if(rows == 0) { rows = 1; }
+
+	const kernel_isa isas[] = { ISA_SCALAR, ISA_AVX2, ISA_AVX512 };
+
+	// four columns of doubles and the same values as longs
+	std::mt19937_64 random(8);
+	std::vector<double> doubles[4];
+	std::vector<long> longs[4];
+
+	for(int c = 0; c < 4; c++) {
+		doubles[c].resize(rows);
+		longs[c].resize(rows);
+		for(unsigned long i = 0; i < rows; i++) {
+			longs[c][i] = 1 + static_cast<long>(random() % 9);
+			doubles[c][i] = static_cast<double>(longs[c][i]);
+		}
+	}
+
+	const double* double_columns[4] = { doubles[0].data(), doubles[1].data(), doubles[2].data(), doubles[3].data() };
+	const long* long_columns[4] = { longs[0].data(), longs[1].data(), longs[2].data(), longs[3].data() };
+
+	std::vector<double> expected(rows);
+	std::vector<double> results(rows);
+	std::vector<double> row(4);
+
+	std::printf("%-14s %-8s %-8s %-12s %-8s\n", "FORMULA", "INPUT", "PATH", "MROWS/S", "SPEEDUP");
+
+	bool failed = false;
+
+	for(const char* formula : k_formulas) {
+
+		Expression expression;
+		Solution solution;
+
+		if(expression.Compile(formula, std::strlen(formula), &solution)) {
+			std::fprintf(stderr, ">ERROR %d. UNABLE TO COMPILE '%s'.\n", solution.error_code, formula);
+			return 1;
+		}
+
+		const std::size_t variables = expression.GetVariableCount();
+
+		// one row at a time through the scalar program
+		double base = 0;
+		for(int round = 0; round < ROUNDS; round++) {
+			Stopwatch watch;
+			for(unsigned long i = 0; i < rows; i++) {
+				for(std::size_t v = 0; v < variables; v++) { row[v] = doubles[v][i]; }
+				expression.Evaluate(row.data(), &solution);
+				expected[i] = solution.real;
+			}
+			double seconds = watch.Seconds();
+			if(round == 0 || seconds < base) { base = seconds; }
+		}
+		std::printf("%-14s %-8s %-8s %-12.1f %-8.2f\n", formula, "double", "row", rows / base / 1e6, 1.0);
+
+		for(int input = 0; input < 2; input++) {
+			for(kernel_isa isa : isas) {
+
+				const Kernels* kernels = GetKernels(isa);
+				if(!kernels) { continue; }
+				expression.SetKernels(*kernels);
+
+				double best = 0;
+				bool err = false;
+
+				for(int round = 0; round < ROUNDS; round++) {
+					Stopwatch watch;
+					if(input == 0) {
+						err = expression.Evaluate(double_columns, rows, results.data(), &solution);
+					} else {
+						err = expression.Evaluate(long_columns, rows, results.data(), &solution);
+					}
+					double seconds = watch.Seconds();
+					if(round == 0 || seconds < best) { best = seconds; }
+				}
+
+				if(err || std::memcmp(results.data(), expected.data(), rows * sizeof(double)) != 0) {
+					std::fprintf(stderr, ">ERROR. '%s' WITH %s KERNELS DOES NOT MATCH.\n", formula, kernels->name);
+					failed = true;
+				}
+
+				std::printf("%-14s %-8s %-8s %-12.1f %-8.2f\n", formula, input == 0 ? "double" : "long",
+					kernels->name, rows / best / 1e6, base / best);
+			}
+		}
+	}
+
+	return failed ? 1 : 0;
+}
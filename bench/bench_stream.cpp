@@ -0,0 +1,178 @@
+//
+// BENCH_STREAM.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../src/solver/solver.hpp"
+#include "../src/stream/stream.hpp"
+
+namespace {
+
+// short pieces of valid and invalid syntax. joined at random they cover numbers and exponents cut
+// at every point, implicit multiplication, negative signs and most of the error codes.
+const char* const k_pieces[] = {
+	"12", "3.5", ".5", "7.", "1e3", "2.5E-2", "4e", "6e+", ".", "0", "-", "--", "+", "*", "x", "/", "^",
+	"(", ")", "(-", "2)", " ", "\t", "a", "..", "1/0", "(3)(4)", "9^0.5", "-2^2"
+};
+
+// solves the text in pieces of the given size
+bool SolveInPieces(bocan::StreamSolver* stream, const std::string& text, std::size_t piece, bocan::Solution* solution) {
+	stream->Begin();
+	for(std::size_t i = 0; i < text.size(); i += piece) {
+		if(stream->Feed(text.data() + i, std::min(piece, text.size() - i))) { break; }
+	}
+	return stream->Finish(solution);
+}
+
+// a long sum of products, as a generator of test data would write it
+std::string MakeSum(std::mt19937_64* random, std::size_t size, bool floating) {
+
+	std::string text;
+	text.reserve(size + 64);
+
+	while(text.size() < size) {
+		if(!text.empty()) { text += "+-"[(*random)() % 2]; }
+		text += std::to_string(1 + (*random)() % 999);
+		if(floating) { text += "." + std::to_string((*random)() % 100); }
+		text += '*';
+		text += "(" + std::to_string(1 + (*random)() % 99) + "-" + std::to_string((*random)() % 99) + ")";
+		if((*random)() % 4 == 0) { text += "x3"; }
+	}
+	return text;
+}
+
+} // NAMESPACE
+
+///
+/// @brief checks the streaming solver against Solver::Solve() on random text fed in pieces of every size from one
+/// @brief byte up, then solves a long sum of products both ways and reports the throughput and the memory each needs.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the size of the long expression in megabytes.
+/// @return 0 on success, 1 if a streamed result differs.
+/// @todo
+///
+int bocan::BenchStream(int argc, char** argv) {
+
+	unsigned long megabytes = 32;
+	if(argc > 0) { megabytes = std::strtoul(argv[0], nullptr, 10); }
+	if(megabytes == 0) { megabytes = 1; }
+
+	std::mt19937_64 random(15);
+	Solver solver;
+	StreamSolver stream;
+	unsigned long checks = 0;
+	unsigned long mismatches = 0;
+
+	const std::size_t piece_count = sizeof(k_pieces) / sizeof(k_pieces[0]);
+	const std::size_t pieces[] = { 1, 2, 3, 7, 64 };
+
+	for(int i = 0; i < 100000; i++) {
+
+		std::string text;
+		std::size_t count = 1 + random() % 10;
+		for(std::size_t j = 0; j < count; j++) { text += k_pieces[random() % piece_count]; }
+
+		Solution expected;
+		solver.Solve(text.data(), text.size(), &expected);
+
+		for(std::size_t piece : pieces) {
+			Solution solution;
+			SolveInPieces(&stream, text, piece, &solution);
+			checks++;
+			if(!SameSolution(solution, expected) && mismatches++ < 10) {
+				std::fprintf(stderr, ">MISMATCH '%s' IN PIECES OF %zu GAVE ERROR %d AT %zu EXPECTED ERROR %d AT %zu\n", text.c_str(), piece,
+					static_cast<int>(solution.error_code), solution.error_pos, static_cast<int>(expected.error_code), expected.error_pos);
+			}
+		}
+	}
+
+	std::printf("RANDOM CHECKS %lu MISMATCHES %lu\n", checks, mismatches);
+
+	// nesting at and past the parser's limit, after an arithmetic error, left open and followed by a syntax error
+	const char* const prefixes[] = { "", "1/0+" };
+	const char* const suffixes[] = { "", "+*" };
+	unsigned long deep_checks = 0;
+
+	for(int depth = MAX_DEPTH; depth <= MAX_DEPTH + 1; depth++) {
+		for(const char* prefix : prefixes) {
+			for(const char* suffix : suffixes) {
+				for(int closed = 0; closed < 2; closed++) {
+
+					std::string text = prefix + std::string(depth, '(') + "2" + std::string(closed ? depth : 0, ')') + suffix;
+
+					Solution expected;
+					solver.Solve(text.data(), text.size(), &expected);
+
+					for(std::size_t piece : { std::size_t(1), std::size_t(64), StreamSolver::CHUNK_SIZE }) {
+						Solution solution;
+						SolveInPieces(&stream, text, piece, &solution);
+						deep_checks++;
+
+						// past the limit the stacks stop growing
+						bool bounded = stream.GetDeepestStack() <= static_cast<std::size_t>(MAX_DEPTH) + 4;
+						if((!SameSolution(solution, expected) || !bounded) && mismatches++ < 10) {
+							std::fprintf(stderr, ">MISMATCH AT DEPTH %d IN PIECES OF %zu GAVE ERROR %d AT %zu EXPECTED ERROR %d AT %zu, STACK %zu\n", depth, piece,
+								static_cast<int>(solution.error_code), solution.error_pos, static_cast<int>(expected.error_code), expected.error_pos, stream.GetDeepestStack());
+						}
+					}
+				}
+			}
+		}
+	}
+
+	std::printf("DEEP CHECKS %lu MISMATCHES %lu\n", deep_checks, mismatches);
+	std::printf("%-10s %-10s %-12s %-12s %-14s %-14s\n", "TYPE", "MB", "WHOLE MB/S", "STREAM MB/S", "WHOLE TOKENS", "STREAM DEPTH");
+
+	for(int floating = 0; floating < 2; floating++) {
+
+		std::string text = MakeSum(&random, megabytes << 20, floating);
+
+		Solution expected;
+		Stopwatch whole_watch;
+		solver.Solve(text.data(), text.size(), &expected);
+		double whole = whole_watch.Seconds();
+
+		Solution solution;
+		Stopwatch stream_watch;
+		SolveInPieces(&stream, text, StreamSolver::CHUNK_SIZE, &solution);
+		double streamed = stream_watch.Seconds();
+
+		if(!SameSolution(solution, expected) && mismatches++ < 10) {
+			std::fprintf(stderr, ">MISMATCH ON THE %s SUM\n", floating ? "FLOATING" : "INTEGER");
+		}
+
+		// the whole text needs a token for every operand and operator, and a node and a constant besides
+		std::size_t tokens = std::count_if(text.begin(), text.end(), [](char c) { return c < '0' || c > '9'; });
+		double mb = static_cast<double>(text.size()) / (1 << 20);
+		std::printf("%-10s %-10.1f %-12.1f %-12.1f %-14zu %-14zu\n", floating ? "double" : "long", mb, mb / whole, mb / streamed,
+			tokens, stream.GetDeepestStack());
+	}
+
+	std::printf("MISMATCHES %lu\n", mismatches);
+	return mismatches ? 1 : 0;
+}
@@ -0,0 +1,303 @@
+//
+// BENCH_SUITE.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../src/calculator/calculator.hpp"
+#include "../src/evaluator/evaluator.hpp"
+#include "../src/lexer/lexer.hpp"
+#include "../src/number/number.hpp"
+#include "../src/parser/parser.hpp"
+
+namespace {
+
+// the shape of the expressions in one generated corpus
+struct shape {
+	const char*	name;
+	std::size_t	operators;	// binary operators per expression, not counting those inside groups
+	int			depth;		// parentheses are nested exactly this deep
+	const char*	mix;		// operators chosen from, at random
+	bool		floating;	// literals have a radix point
+	int			digits;		// digits per literal
+};
+
+const shape k_shapes[] = {
+	{ "short", 4, 0, "+-*", false, 3 },
+	{ "long", 400, 0, "+-*", false, 3 },
+	{ "nested", 6, 8, "+-*", false, 3 },
+	{ "floating", 16, 2, "+-*/", true, 4 },
+	{ "long-literals", 16, 0, "+-*", false, 18 },
+	{ "long-floats", 16, 0, "+-*/", true, 17 },
+	{ "powers", 8, 2, "+-*/^", true, 2 },
+};
+
+enum phase {
+	PHASE_LEX,
+	PHASE_PARSE,
+	PHASE_EVALUATE,
+	PHASE_FORMAT,
+	PHASE_CALCULATOR,
+	PHASE_COUNT
+};
+
+const char* const k_phase_names[PHASE_COUNT] = { "lex", "parse", "evaluate", "format", "calculator" };
+
+// latency of every expression in one phase, in nanoseconds
+struct timing {
+	std::vector<double>	samples;
+	double				seconds = 0;
+
+	double Percentile(double p) const {
+		if(samples.empty()) { return 0; }
+		return samples[std::min(samples.size() - 1, static_cast<std::size_t>(p * samples.size()))];
+	}
+};
+
+class CorpusGenerator {
+
+public:
+	CorpusGenerator(std::uint64_t seed, const shape& s) : m_random(seed), m_shape(s) {}
+
+	std::string Expression() { return Chain(m_shape.operators, m_shape.depth); }
+
+private:
+	std::string Literal() {
+		std::string text(1, static_cast<char>('1' + m_random() % 9));
+		for(int i = 1; i < m_shape.digits; i++) { text += static_cast<char>('0' + m_random() % 10); }
+		if(m_shape.floating) { text.insert(1 + m_random() % text.size(), 1, '.'); }
+		if(text.back() == '.') { text += '5'; }
+		return text;
+	}
+
+	// the first operand of each chain opens the next level, so the nesting depth is always reached
+	std::string Chain(std::size_t operators, int depth) {
+		std::string text = depth ? "(" + Chain(2 + m_random() % 3, depth - 1) + ")" : Literal();
+		for(std::size_t i = 0; i < operators; i++) {
+			char oper = m_shape.mix[m_random() % std::strlen(m_shape.mix)];
+			text += oper;
+			if(oper == '^') {
+				text += static_cast<char>('2' + m_random() % 2);
+			} else if(depth && m_random() % 4 == 0) {
+				text += "(" + Chain(2 + m_random() % 3, depth - 1) + ")";
+			} else {
+				text += Literal();
+			}
+		}
+		return text;
+	}
+
+	std::mt19937_64	m_random;
+	const shape&	m_shape;
+};
+
+double Nanoseconds(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+	return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+// discards everything written to it, so the calculator's output costs formatting but no terminal
+class NullBuffer : public std::streambuf {
+protected:
+	int overflow(int c) override { return c; }
+	std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+///
+/// @brief times each phase of solving every expression of a corpus, then the calculator's own Input, Solve and Output.
+/// @param[in] vector reference to the expressions.
+/// @param[out] timing pointer to one timing per phase.
+/// @return
+/// @todo
+///
+void TimeCorpus(const std::vector<std::string>& expressions, timing* timings) {
+
+	using clock = std::chrono::steady_clock;
+
+	bocan::Lexer lexer;
+	bocan::Parser parser;
+	bocan::Evaluator evaluator;
+	std::vector<bocan::Token> tokens;
+	bocan::Ast ast;
+	char buffer[bocan::FORMAT_SIZE];
+
+	for(const std::string& text : expressions) {
+
+		clock::time_point t0 = clock::now();
+		bool err = lexer.Tokenize(text.data(), text.size(), &tokens);
+		clock::time_point t1 = clock::now();
+		bool floating = lexer.IsFloating();
+		err = err || parser.Parse(text.data(), tokens, floating, &ast);
+		clock::time_point t2 = clock::now();
+
+		long integer = 0;
+		double real = 0;
+		err = err || (floating ? evaluator.Evaluate(ast, &real) : evaluator.Evaluate(ast, &integer));
+		clock::time_point t3 = clock::now();
+		std::size_t len = floating ? bocan::FormatDouble(real, buffer) : bocan::FormatInteger(integer, buffer);
+		clock::time_point t4 = clock::now();
+
+		if(err || len == 0) { continue; }
+
+		timings[PHASE_LEX].samples.push_back(Nanoseconds(t0, t1));
+		timings[PHASE_PARSE].samples.push_back(Nanoseconds(t1, t2));
+		timings[PHASE_EVALUATE].samples.push_back(Nanoseconds(t2, t3));
+		timings[PHASE_FORMAT].samples.push_back(Nanoseconds(t3, t4));
+	}
+
+	// the calculator reads from std::cin and writes to std::cout and std::cerr, so they are redirected
+	std::string input;
+	for(const std::string& text : expressions) { input += text + "\n"; }
+
+	std::istringstream in(input);
+	NullBuffer null;
+	std::streambuf* cin_buffer = std::cin.rdbuf(in.rdbuf());
+	std::streambuf* cout_buffer = std::cout.rdbuf(&null);
+	std::streambuf* cerr_buffer = std::cerr.rdbuf(&null);
+
+	bocan::Calculator calculator;
+	calculator.Initialize();
+	char* argv[] = { nullptr };
+
+	for(std::size_t i = 0; i < expressions.size(); i++) {
+		clock::time_point start = clock::now();
+		if(!calculator.Input(1, argv)) {
+			calculator.Solve();
+			calculator.Output();
+		}
+		timings[PHASE_CALCULATOR].samples.push_back(Nanoseconds(start, clock::now()));
+	}
+
+	std::cin.rdbuf(cin_buffer);
+	std::cout.rdbuf(cout_buffer);
+	std::cerr.rdbuf(cerr_buffer);
+
+	for(int p = 0; p < PHASE_COUNT; p++) {
+		timing& t = timings[p];
+		for(double sample : t.samples) { t.seconds += sample * 1e-9; }
+		std::sort(t.samples.begin(), t.samples.end());
+	}
+}
+
+} // NAMESPACE
+
+///
+/// @brief generates reproducible corpora that vary the expression length, nesting depth, operator mix, number type and
+/// @brief literal length, and reports the throughput and latency percentiles of each phase of solving them.
+/// @brief with '--json file' the results are also written as JSON, so runs of different versions can be compared.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the number of expressions per corpus, and '--json file'.
+/// @return 0 on success, 1 if the JSON file could not be written.
+/// @todo
+///
+int bocan::BenchSuite(int argc, char** argv) {
+
+	unsigned long lines = 20000;
+	const char* json_path = nullptr;
+
+	for(int i = 0; i < argc; i++) {
+		if(std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+			json_path = argv[++i];
+		} else {
+			lines = std::strtoul(argv[i], nullptr, 10);
+		}
+	}
+	if(lines == 0) { lines = 1; }
+
+	std::FILE* json = nullptr;
+	if(json_path) {
+		json = std::fopen(json_path, "w");
+		if(!json) {
+			std::fprintf(stderr, ">ERROR. UNABLE TO OPEN FILE '%s'.\n", json_path);
+			return 1;
+		}
+		std::fprintf(json, "{\n  \"benchmark\": \"suite\",\n  \"compiler\": \"%s\",\n  \"optimized\": %s,\n  \"expressions\": %lu,\n  \"corpora\": [",
+			__VERSION__,
+#ifdef __OPTIMIZE__
+			"true",
+#else
+			"false",
+#endif
+			lines);
+	}
+
+	std::printf("%lu EXPRESSIONS PER CORPUS. LATENCIES IN NS PER EXPRESSION\n", lines);
+	std::printf("%-14s %-11s %-10s %-10s %-10s %-10s %-10s %-10s\n", "CORPUS", "PHASE", "MB/S", "MEAN", "P50", "P90", "P99", "MAX");
+
+	std::uint64_t seed = 16;
+
+	for(const shape& s : k_shapes) {
+
+		CorpusGenerator generator(seed++, s);
+		std::vector<std::string> expressions;
+		std::size_t bytes = 0;
+		for(unsigned long i = 0; i < lines; i++) {
+			expressions.push_back(generator.Expression());
+			bytes += expressions.back().size();
+		}
+
+		timing timings[PHASE_COUNT];
+		TimeCorpus(expressions, timings);
+
+		if(json) {
+			std::fprintf(json, "%s\n    { \"name\": \"%s\", \"operators\": %zu, \"depth\": %d, \"mix\": \"%s\", \"floating\": %s, \"digits\": %d, \"bytes\": %zu, \"phases\": {",
+				&s == k_shapes ? "" : ",", s.name, s.operators, s.depth, s.mix, s.floating ? "true" : "false", s.digits, bytes);
+		}
+
+		for(int p = 0; p < PHASE_COUNT; p++) {
+
+			const timing& t = timings[p];
+			double mb_per_second = t.seconds > 0 ? bytes / t.seconds / (1 << 20) : 0;
+			double mean = t.samples.empty() ? 0 : t.seconds * 1e9 / t.samples.size();
+
+			std::printf("%-14s %-11s %-10.1f %-10.0f %-10.0f %-10.0f %-10.0f %-10.0f\n", p ? "" : s.name, k_phase_names[p],
+				mb_per_second, mean, t.Percentile(0.50), t.Percentile(0.90), t.Percentile(0.99), t.Percentile(1.0));
+
+			if(json) {
+				std::fprintf(json, "%s\n      \"%s\": { \"expressions\": %zu, \"mb_per_second\": %.3f, \"mean_ns\": %.1f, \"p50_ns\": %.1f, \"p90_ns\": %.1f, \"p99_ns\": %.1f, \"max_ns\": %.1f }",
+					p ? "," : "", k_phase_names[p], t.samples.size(), mb_per_second, mean, t.Percentile(0.50), t.Percentile(0.90),
+					t.Percentile(0.99), t.Percentile(1.0));
+			}
+		}
+
+		if(json) { std::fprintf(json, "\n    } }"); }
+	}
+
+	if(json) {
+		std::fprintf(json, "\n  ]\n}\n");
+		bool err = std::ferror(json);
+		std::fclose(json);
+		if(err) {
+			std::fprintf(stderr, ">ERROR. UNABLE TO WRITE FILE '%s'.\n", json_path);
+			return 1;
+		}
+		std::printf("RESULTS WRITTEN TO %s\n", json_path);
+	}
+	return 0;
+}
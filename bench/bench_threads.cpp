@@ -0,0 +1,74 @@
+//
+// BENCH_THREADS.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include "bench.hpp"
+#include "../src/batch/batch.hpp"
+
+///
+/// @brief measures batch throughput on a mixed-length corpus while the thread count doubles from 1 to N.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the maximum thread count and the number of lines.
+/// @return 0 on success, 1 if the output could not be opened.
+/// @todo
+///
+int bocan::BenchThreads(int argc, char** argv) {
+
+	unsigned long max_threads = std::thread::hardware_concurrency();
+	unsigned long lines = 50000;
+
+	if(argc > 0) { max_threads = std::strtoul(argv[0], nullptr, 10); }
+	if(argc > 1) { lines = std::strtoul(argv[1], nullptr, 10); }
+	if(max_threads == 0) { max_threads = 1; }
+
+	std::string corpus = GenerateMixedCorpus(4, lines);
+
+	std::FILE* null = std::fopen("/dev/null", "w");
+	if(!null) { return 1; }
+
+	std::printf("%-8s %-10s %-14s %-10s %-8s\n", "THREADS", "SECONDS", "LINES/S", "MB/S", "SPEEDUP");
+
+	double base = 0;
+
+	for(unsigned long threads = 1; ; threads *= 2) {
+
+		if(threads > max_threads) { threads = max_threads; }
+
+		Batch batch(static_cast<unsigned int>(threads));
+
+		Stopwatch watch;
+		batch.Solve(corpus.data(), corpus.size(), null);
+		double seconds = watch.Seconds();
+
+		if(threads == 1) { base = seconds; }
+
+		std::printf("%-8lu %-10.4f %-14.0f %-10.1f %-8.2f\n", threads, seconds,
+			batch.GetLineCount() / seconds, corpus.size() / seconds / 1e6, base / seconds);
+
+		if(threads == max_threads) { break; }
+	}
+
+	std::fclose(null);
+	return 0;
+}
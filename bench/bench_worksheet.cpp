@@ -0,0 +1,151 @@
+//
+// BENCH_WORKSHEET.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../src/worksheet/worksheet.hpp"
+
+namespace {
+
+// names are letters only, so numbers are written in base 26 after a prefix
+std::string Name(const char* prefix, std::size_t index) {
+	std::string name(prefix);
+	do {
+		name += static_cast<char>('a' + index % 26);
+		index /= 26;
+	} while(index);
+	return name;
+}
+
+// a definition and its text, kept so the worksheet can be built again from scratch
+struct line {
+	std::string	name;
+	std::string	text;
+};
+
+} // NAMESPACE
+
+///
+/// @brief builds a worksheet of groups of definitions, each group hanging off one input, and a total over every group.
+/// @brief each input is then changed in turn, and the time and number of definitions solved again are compared
+/// @brief against defining the whole worksheet. the values must match a worksheet built again from the final text.
+/// @param[in] integer is the number of arguments.
+/// @param[in] char pointer pointer to the arguments: the number of definitions.
+/// @return 0 on success, 1 if a value differs or a circular definition is accepted.
+/// @todo
+///
+int bocan::BenchWorksheet(int argc, char** argv) {
+
+	unsigned long count = 10000;
+	if(argc > 0) { count = std::strtoul(argv[0], nullptr, 10); }
+
+	const std::size_t group_size = 100;
+	const std::size_t groups = std::max<std::size_t>(1, count / group_size);
+
+	std::mt19937_64 random(21);
+	std::vector<line> inputs;
+	std::vector<line> definitions;
+	std::string total;
+
+	for(std::size_t g = 0; g < groups; g++) {
+
+		inputs.push_back({ Name("k", g), std::to_string(1 + random() % 100) + "." + std::to_string(random() % 100) });
+
+		for(std::size_t i = 0; i < group_size; i++) {
+			std::string name = Name(Name("d", g).append("q").c_str(), i);
+			std::string text = inputs.back().name + "*2";
+			if(i) {
+				std::string previous = definitions.back().name;
+				std::string earlier = definitions[definitions.size() - 1 - random() % i].name;
+				text = previous + "*1.001 + " + inputs.back().name + " - " + earlier + "/7";
+			}
+			definitions.push_back({ name, text });
+		}
+		total += (g ? "+" : "") + definitions.back().name;
+	}
+	definitions.push_back({ "total", total });
+
+	auto define = [](Worksheet* sheet, const line& l, Solution* solution) {
+		return sheet->Define(l.name, l.text.data(), l.text.size(), solution);
+	};
+
+	Worksheet sheet;
+	Solution solution;
+
+	Stopwatch build_watch;
+	for(const line& l : inputs) { define(&sheet, l, &solution); }
+	for(const line& l : definitions) { define(&sheet, l, &solution); }
+	double build = build_watch.Seconds();
+
+	// change every input in turn
+	double change_total = 0;
+	double change_max = 0;
+	std::size_t updated_total = 0;
+
+	for(line& l : inputs) {
+		l.text = std::to_string(1 + random() % 100) + "." + std::to_string(random() % 100);
+
+		Stopwatch watch;
+		define(&sheet, l, &solution);
+		double seconds = watch.Seconds();
+
+		change_total += seconds;
+		change_max = std::max(change_max, seconds);
+		updated_total += sheet.GetUpdateCount();
+	}
+
+	// a definition that would use itself is refused, and changes nothing
+	Solution before;
+	sheet.Lookup("total", &before);
+	bool refused = define(&sheet, line{ inputs[0].name, definitions[group_size / 2].name + "+1" }, &solution) && solution.error_code == CIRCULAR_DEFINITION;
+	sheet.Lookup("total", &solution);
+	refused = refused && SameSolution(before, solution);
+
+	// the same text defined from scratch gives the same values
+	Worksheet fresh;
+	for(const line& l : inputs) { define(&fresh, l, &solution); }
+	for(const line& l : definitions) { define(&fresh, l, &solution); }
+
+	unsigned long mismatches = 0;
+	for(const line& l : definitions) {
+		Solution a;
+		Solution b;
+		sheet.Lookup(l.name, &a);
+		fresh.Lookup(l.name, &b);
+		if(!SameSolution(a, b) && mismatches++ < 5) { std::fprintf(stderr, ">MISMATCH ON '%s'\n", l.name.c_str()); }
+	}
+
+	sheet.Lookup("total", &solution);
+	std::printf("DEFINITIONS %zu INPUTS %zu TOTAL %.17g\n", definitions.size(), inputs.size(), solution.real);
+	std::printf("%-28s %-12s %-12s\n", "STEP", "US", "SOLVED");
+	std::printf("%-28s %-12.1f %-12zu\n", "define every definition", build * 1e6, definitions.size() + inputs.size());
+	std::printf("%-28s %-12.1f %-12.1f\n", "change one input (mean)", change_total / inputs.size() * 1e6, static_cast<double>(updated_total) / inputs.size());
+	std::printf("%-28s %-12.1f\n", "change one input (max)", change_max * 1e6);
+	std::printf("CIRCULAR DEFINITION %s\n", refused ? "REFUSED" : "ACCEPTED <- SHOULD BE REFUSED");
+	std::printf("MISMATCHES %lu\n", mismatches);
+	return (mismatches || !refused) ? 1 : 0;
+}
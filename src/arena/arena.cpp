@@ -0,0 +1,84 @@
+//
+// ARENA.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "arena.hpp"
+
+using bocan::Arena;
+
+///
+/// @brief takes memory from the current block, moving on to the next block, or adding a new one, when it is full.
+/// @param[in] size_t is the number of bytes.
+/// @param[in] size_t is the alignment, a power of two.
+/// @return pointer to the memory. it is not initialized.
+/// @todo
+///
+void* Arena::Allocate(std::size_t size, std::size_t align) {
+
+	while(m_block < m_blocks.size()) {
+
+		block& current = m_blocks[m_block];
+		std::uintptr_t base = reinterpret_cast<std::uintptr_t>(current.data.get());
+		std::size_t start = ((base + m_used + align - 1) & ~(align - 1)) - base;
+
+		if(start + size <= current.size) {
+			m_used = start + size;
+			return current.data.get() + start;
+		}
+
+		// blocks after this one were kept from an earlier use
+		if(m_block + 1 == m_blocks.size()) { break; }
+		m_block++;
+		m_used = 0;
+	}
+
+	// room for the worst case of aligning the start of a new block
+	std::size_t bytes = std::max(m_block_size, size + align);
+	m_blocks.push_back(block{ std::unique_ptr<unsigned char[]>(new unsigned char[bytes]), bytes });
+
+	m_block = m_blocks.size() - 1;
+	m_used = 0;
+	return Allocate(size, align);
+}
+
+///
+/// @brief adds up the size of every block.
+/// @return the number of bytes the arena holds.
+/// @todo
+///
+std::size_t Arena::GetCapacity() const {
+	std::size_t total = 0;
+	for(const block& b : m_blocks) { total += b.size; }
+	return total;
+}
+
+///
+/// @brief returns the arena of the calling thread, created on first use.
+/// @return reference to the arena.
+/// @todo
+///
+Arena& Arena::GetThreadArena() {
+	thread_local Arena arena;
+	return arena;
+}
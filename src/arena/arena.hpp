@@ -0,0 +1,92 @@
+//
+// ARENA.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace bocan {
+
+// a bump allocator for temporary storage. memory is handed out from large blocks by moving an offset, and is
+// given back all at once, by Reset() or by rewinding to a mark taken earlier. blocks are kept for the next use,
+// so once an arena has grown to what a workload needs it makes no more heap allocations. nothing is constructed
+// or destroyed, it is meant for plain data such as limbs. it is not thread safe, each thread has its own.
+class Arena {
+
+public:
+	explicit Arena(std::size_t block_size = BLOCK_SIZE) : m_block_size(block_size) {}
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	// a position in the arena. everything allocated after it is given back by Rewind().
+	struct mark {
+		std::size_t	block;
+		std::size_t	used;
+	};
+
+	void*	Allocate(std::size_t, std::size_t);
+
+	template<typename T>
+	T*		Allocate(std::size_t count) { return static_cast<T*>(Allocate(count * sizeof(T), alignof(T))); }
+
+	void	Reset() { m_block = 0; m_used = 0; }
+	mark	GetMark() const { return mark{ m_block, m_used }; }
+	void	Rewind(const mark& m) { m_block = m.block; m_used = m.used; }
+
+	std::size_t	GetBlockCount() const { return m_blocks.size(); }
+	std::size_t	GetCapacity() const;
+
+	static Arena&	GetThreadArena();
+
+	static const std::size_t BLOCK_SIZE = 1 << 16;
+
+private:
+	struct block {
+		std::unique_ptr<unsigned char[]>	data;
+		std::size_t							size;
+	};
+
+	std::vector<block>	m_blocks;
+	std::size_t			m_block = 0;
+	std::size_t			m_used = 0;
+	std::size_t			m_block_size;
+};
+
+// gives back everything allocated from an arena within a scope, so nested and recursive code can use one arena
+class ArenaScope {
+
+public:
+	explicit ArenaScope(Arena& arena) : m_arena(arena), m_mark(arena.GetMark()) {}
+	~ArenaScope() { m_arena.Rewind(m_mark); }
+
+	ArenaScope(const ArenaScope&) = delete;
+	ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+	Arena&		m_arena;
+	Arena::mark	m_mark;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// ARENA_HPP
@@ -0,0 +1,440 @@
+//
+// BATCH.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "batch.hpp"
+#include "../number/number.hpp"
+
+using bocan::Batch;
+
+///
+/// @brief creates the thread pool and one solver per thread.
+/// @param[in] unsigned integer is the number of threads solving expressions. zero is treated as one.
+/// @param[in] size_t is the capacity of each solver's own cache of solutions. zero solves every line without a cache.
+/// @return
+/// @todo
+///
+Batch::Batch(unsigned int threads, std::size_t cache) : m_threads(threads ? threads : 1), m_pool(m_threads) {
+	m_solvers.reset(new Solver[m_threads]);
+	if(cache) {
+		m_caches.reserve(m_threads);
+		for(unsigned int i = 0; i < m_threads; i++) {
+			m_caches.emplace_back(cache);
+			m_solvers[i].SetCache(&m_caches[i]);
+		}
+	}
+	m_window = m_threads * CHUNKS_PER_THREAD;
+	m_chunks.reset(new chunk[m_window]);
+}
+
+///
+/// @brief selects the numbers every line is solved with, as the calculator's --bigint and --decimal options do.
+/// @brief lines solved with exact integers or decimals are not looked up in, or stored in, the caches.
+/// @param[in] boolean true to solve integer expressions exactly, however large.
+/// @param[in] DecimalFormat pointer to the scale and rounding of exact decimals, or nullptr for binary numbers.
+/// @return
+/// @todo
+///
+void Batch::SetNumbers(bool bigint, const DecimalFormat* format) {
+	m_bigint = bigint;
+	m_decimal = format != nullptr;
+	if(format) { m_format = *format; }
+}
+
+///
+/// @brief gives each solver its own counters of time spent in each phase, operations and numbers read.
+/// @param
+/// @return
+/// @todo
+///
+void Batch::EnableStats() {
+	m_stats.assign(m_threads, SolveStats());
+	for(unsigned int i = 0; i < m_threads; i++) { m_solvers[i].SetStats(&m_stats[i]); }
+}
+
+///
+/// @brief adds together the counters of every solver. formatting the results is counted as well.
+/// @param[out] SolveStats pointer receiving the totals.
+/// @return
+/// @todo
+///
+void Batch::GetStats(SolveStats* stats) const {
+	*stats = SolveStats();
+	for(const SolveStats& s : m_stats) { stats->Add(s); }
+}
+
+///
+/// @brief solves every line of the input and writes the results to stdout.
+/// @brief regular files are memory mapped and solved in place. pipes and stdin are read in chunks.
+/// @param[in] char pointer to the path of the input file, or nullptr to read from stdin.
+/// @return 0 if the input was read, 1 if the input file could not be opened or read.
+/// @todo
+///
+int Batch::Run(const char* path) {
+
+	auto start = std::chrono::steady_clock::now();
+
+	bool read_err = false;
+
+	if(path && !m_file.Open(path)) {
+		Solve(m_file.Data(), m_file.Size(), stdout);
+		m_file.Close();
+	} else {
+		std::FILE* in = stdin;
+		if(path) {
+			in = std::fopen(path, "rb");
+			if(!in) {
+				std::fprintf(stderr, ">ERROR. UNABLE TO OPEN FILE '%s'.\n", path);
+				return 1;
+			}
+		}
+
+		m_data = nullptr;
+		m_size = 0;
+		m_offset = 0;
+		m_in = in;
+		m_eof = false;
+		m_carry.clear();
+
+		read_err = Pipeline(stdout);
+		if(path) { std::fclose(in); }
+		m_in = nullptr;
+	}
+
+	std::fflush(stdout);
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	std::fprintf(stderr, ">BATCH %lu LINES %lu ERRORS %.6f SECONDS\n", m_lines, m_errors, elapsed.count());
+
+	if(!m_caches.empty()) {
+		unsigned long hits = 0;
+		unsigned long misses = 0;
+		unsigned long evictions = 0;
+		unsigned long groups = 0;
+		for(const SolutionCache& cache : m_caches) {
+			hits += cache.GetHitCount();
+			misses += cache.GetMissCount();
+			evictions += cache.GetEvictionCount();
+			groups += cache.GetGroupHitCount();
+		}
+		std::fprintf(stderr, ">CACHE %lu HITS %lu MISSES %lu EVICTIONS %lu GROUP HITS\n", hits, misses, evictions, groups);
+	}
+
+	if(read_err) {
+		std::fprintf(stderr, ">ERROR. UNABLE TO READ INPUT.\n");
+		return 1;
+	}
+	return 0;
+}
+
+///
+/// @brief solves every line of a block of memory in place. lines are never copied.
+/// @param[in] char pointer to the first character of the input.
+/// @param[in] size_t is the length of the input in bytes.
+/// @param[in] FILE pointer to the stream receiving the results.
+/// @return 0 on success, 1 if the results could not be written.
+/// @todo
+///
+bool Batch::Solve(const char* data, std::size_t size, std::FILE* out) {
+	m_data = data;
+	m_size = size;
+	m_offset = 0;
+	m_in = nullptr;
+	m_eof = false;
+	return Pipeline(out);
+}
+
+///
+/// @brief keeps a window of chunks queued on the pool and writes each chunk as soon as it and every chunk before it are done.
+/// @brief the waiting thread runs queued chunks itself, so a single thread needs no workers.
+/// @param[in] FILE pointer to the stream receiving the results.
+/// @return 0 on success, 1 on a read or write error.
+/// @todo
+///
+bool Batch::Pipeline(std::FILE* out) {
+
+	m_lines = 0;
+	m_errors = 0;
+
+	std::size_t head = 0;
+	std::size_t tail = 0;
+	std::size_t released = 0;
+	bool more = true;
+	bool io_err = false;
+
+	while(true) {
+
+		// fill the window
+		while(more && tail - head < m_window) {
+			chunk* c = &m_chunks[tail % m_window];
+
+			more = NextChunk(c);
+			if(c->size == 0) { break; }
+
+			c->done.store(false, std::memory_order_relaxed);
+			m_pool.Submit([this, c] {
+				SolveChunk(c);
+				c->done.store(true, std::memory_order_release);
+			});
+			tail++;
+		}
+
+		if(head == tail) { break; }
+
+		// write the oldest chunk once it is solved
+		chunk* c = &m_chunks[head % m_window];
+		m_pool.WaitUntil([c] { return c->done.load(std::memory_order_acquire); });
+
+		if(std::fwrite(c->output.data(), 1, c->output_size, out) != c->output_size) { io_err = true; }
+		m_lines += c->lines;
+		m_errors += c->errors;
+		head++;
+
+		// pages of a mapped file that have been solved are no longer needed
+		if(m_data && c->end - released >= RELEASE_SIZE) {
+			m_file.Release(c->end);
+			released = c->end;
+		}
+	}
+
+	if(m_in && std::ferror(m_in)) { io_err = true; }
+	return io_err;
+}
+
+///
+/// @brief takes the next run of whole lines from the input.
+/// @param[out] chunk pointer receiving the lines. its size is zero if the input is exhausted.
+/// @return boolean true if more input may follow this chunk.
+/// @todo
+///
+bool Batch::NextChunk(chunk* c) {
+
+	c->lines = 0;
+	c->errors = 0;
+	c->output_size = 0;
+
+	if(m_in) { return ReadChunk(c); }
+
+	std::size_t begin = m_offset;
+	std::size_t end = begin + CHUNK_SIZE;
+
+	// extend the chunk to the end of its last line
+	if(end >= m_size) {
+		end = m_size;
+	} else {
+		const char* newline = static_cast<const char*>(std::memchr(m_data + end, '\n', m_size - end));
+		end = newline ? static_cast<std::size_t>(newline - m_data) + 1 : m_size;
+	}
+
+	c->data = m_data + begin;
+	c->size = end - begin;
+	c->end = end;
+	m_offset = end;
+
+	return end < m_size;
+}
+
+///
+/// @brief reads the next run of whole lines from the input stream into the chunk's own buffer.
+/// @brief the part of a line cut off at the end of a read is carried over to the next chunk.
+/// @param[out] chunk pointer receiving the lines.
+/// @return boolean true if more input may follow this chunk.
+/// @todo
+///
+bool Batch::ReadChunk(chunk* c) {
+
+	std::vector<char>& input = c->input;
+	std::size_t size = m_carry.size();
+
+	input.resize(size + CHUNK_SIZE);
+	if(size) { std::memcpy(input.data(), m_carry.data(), size); }
+	m_carry.clear();
+
+	std::size_t last = 0;
+	bool found = false;
+
+	while(!m_eof) {
+		std::size_t count = std::fread(input.data() + size, 1, input.size() - size, m_in);
+		if(count < input.size() - size) { m_eof = true; }
+
+		// look for the last newline in the new data
+		for(std::size_t i = size + count; i > size; i--) {
+			if(input[i - 1] == '\n') {
+				last = i;
+				found = true;
+				break;
+			}
+		}
+		size += count;
+
+		// a line longer than the chunk keeps growing the chunk
+		if(found) { break; }
+		if(!m_eof) { input.resize(input.size() * 2); }
+	}
+
+	if(m_eof) { last = size; }
+
+	m_carry.assign(input.data() + last, input.data() + size);
+
+	c->data = input.data();
+	c->size = last;
+	c->end = 0;
+
+	return !m_eof || !m_carry.empty();
+}
+
+///
+/// @brief solves every line of a chunk with the solver owned by the calling thread.
+/// @param[in,out] chunk pointer to the lines, receiving the results.
+/// @return
+/// @todo
+///
+void Batch::SolveChunk(chunk* c) {
+
+	Solver* solver = &m_solvers[ThreadPool::GetThreadIndex() % m_threads];
+
+	const char* data = c->data;
+	std::size_t size = c->size;
+	std::size_t begin = 0;
+
+	while(begin < size) {
+
+		const char* newline = static_cast<const char*>(std::memchr(data + begin, '\n', size - begin));
+
+		// the last line of the input may not end with a newline
+		std::size_t end = newline ? static_cast<std::size_t>(newline - data) : size;
+
+		SolveLine(solver, c, data + begin, end - begin);
+		begin = end + 1;
+	}
+}
+
+///
+/// @brief solves one expression and appends its result, or its error code, to the chunk's output.
+/// @brief blank lines are copied through so the output stays aligned with the input.
+/// @param[in] Solver pointer owned by the calling thread.
+/// @param[in,out] chunk pointer receiving the result.
+/// @param[in] char pointer to the first character of the line.
+/// @param[in] size_t is the length of the line without the newline.
+/// @return
+/// @todo
+///
+void Batch::SolveLine(Solver* solver, chunk* c, const char* line, std::size_t size) {
+
+	c->lines++;
+
+	if(c->output_size + MAX_RESULT_SIZE > c->output.size()) {
+		c->output.resize(c->output.size() * 2 + MAX_RESULT_SIZE);
+	}
+
+	// ignore the carriage return of windows line endings
+	if(size && line[size - 1] == '\r') { size--; }
+
+	if(size == 0) {
+		c->output[c->output_size++] = '\n';
+		return;
+	}
+
+	if(m_bigint || m_decimal) {
+		SolveExact(solver, c, line, size);
+		return;
+	}
+
+	Solution solution;
+
+	if(solver->Solve(line, size, &solution)) {
+		WriteError(c, solution.error_code);
+		return;
+	}
+
+	// formatted straight into the chunk's output, as the shortest text that reads back as the same value
+	char* out = c->output.data() + c->output_size;
+	std::size_t len = 0;
+	{
+		PhaseTimer timer(solver->GetStats(), STAT_FORMAT);
+		len = solution.floating ? FormatDouble(solution.real, out) : FormatInteger(solution.integer, out);
+	}
+
+	out[len] = '\n';
+	c->output_size += len + 1;
+}
+
+///
+/// @brief solves one expression with exact integers or decimals and appends its result, or its error code, to the chunk's output.
+/// @brief an integer of any length is formatted into the chunk's own string first, so the output grows to fit it.
+/// @param[in] Solver pointer owned by the calling thread.
+/// @param[in,out] chunk pointer receiving the result.
+/// @param[in] char pointer to the first character of the line.
+/// @param[in] size_t is the length of the line without the carriage return or newline.
+/// @return
+/// @todo
+///
+void Batch::SolveExact(Solver* solver, chunk* c, const char* line, std::size_t size) {
+
+	Solution solution;
+
+	bool err = solver->Tokenize(line, size, &solution);
+	if(!err) {
+		err = m_decimal ? solver->EvaluateDecimal(m_format, &c->decimal, &solution) : solver->EvaluateBig(&c->big, &solution);
+	}
+	if(err) {
+		WriteError(c, solution.error_code);
+		return;
+	}
+
+	PhaseTimer timer(solver->GetStats(), STAT_FORMAT);
+	char* out = c->output.data() + c->output_size;
+	std::size_t len = 0;
+
+	if(m_decimal) {
+		len = c->decimal.Format(m_format.scale, out);
+	} else if(solution.floating) {
+		len = FormatDouble(solution.real, out);
+	} else {
+		c->big.ToString(&c->text);
+		len = c->text.size();
+		if(c->output_size + len + 1 > c->output.size()) {
+			c->output.resize(c->output_size + len + 1 + MAX_RESULT_SIZE);
+			out = c->output.data() + c->output_size;
+		}
+		std::memcpy(out, c->text.data(), len);
+	}
+
+	out[len] = '\n';
+	c->output_size += len + 1;
+}
+
+///
+/// @brief appends an error code for the current line to the chunk's output.
+/// @param[in,out] chunk pointer receiving the error.
+/// @param[in] enumerator corresponding to the error_code enum.
+/// @return
+/// @todo
+///
+void Batch::WriteError(chunk* c, errors error_code) {
+	c->errors++;
+	c->output_size += std::snprintf(c->output.data() + c->output_size, MAX_RESULT_SIZE, "ERROR %d\n", static_cast<int>(error_code));
+}
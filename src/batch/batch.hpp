@@ -0,0 +1,123 @@
+//
+// BATCH.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../calculator/errors.hpp"
+#include "../cache/cache.hpp"
+#include "../solver/solver.hpp"
+#include "../mapped_file/mapped_file.hpp"
+#include "../thread_pool/thread_pool.hpp"
+
+namespace bocan {
+
+// solves a newline delimited stream of expressions and writes one result per line, in order.
+// errors are written inline as "ERROR <code>" and a summary is printed to stderr at the end.
+// the input is cut into chunks of whole lines that are solved on a thread pool. finished chunks are
+// written strictly in input order, and only a small window of chunks is in flight at any time.
+class Batch {
+
+public:
+	explicit Batch(unsigned int threads = 1, std::size_t cache = 0);
+
+	int		Run(const char*);
+	bool	Solve(const char*, std::size_t, std::FILE*);
+
+	void	SetNumbers(bool, const DecimalFormat*);
+	void	EnableStats();
+	void	GetStats(SolveStats*) const;
+
+	unsigned long	GetLineCount() const { return m_lines; }
+	unsigned long	GetErrorCount() const { return m_errors; }
+
+private:
+	// a run of whole lines and the text of their results
+	struct chunk {
+		const char*			data = nullptr;
+		std::size_t			size = 0;
+		std::size_t			end = 0;
+		std::vector<char>	input;
+		std::vector<char>	output;
+		std::size_t			output_size = 0;
+		unsigned long		lines = 0;
+		unsigned long		errors = 0;
+		std::atomic<bool>	done;
+		BigInt				big;
+		Decimal				decimal;
+		std::string			text;
+	};
+
+	bool	Pipeline(std::FILE*);
+	bool	NextChunk(chunk*);
+	bool	ReadChunk(chunk*);
+	void	SolveChunk(chunk*);
+	void	SolveLine(Solver*, chunk*, const char*, std::size_t);
+	void	SolveExact(Solver*, chunk*, const char*, std::size_t);
+	void	WriteError(chunk*, errors);
+
+	unsigned int	m_threads;
+	ThreadPool		m_pool;
+	std::unique_ptr<Solver[]>	m_solvers;
+	std::vector<SolutionCache>	m_caches;
+	std::vector<SolveStats>		m_stats;
+	std::unique_ptr<chunk[]>	m_chunks;
+	std::size_t		m_window;
+
+	// exact integers as in --bigint, or exact decimals as in --decimal. neither is cached.
+	bool			m_bigint = false;
+	bool			m_decimal = false;
+	DecimalFormat	m_format;
+
+	// input is either a block of memory (a mapped file) or a stream read chunk by chunk
+	MappedFile			m_file;
+	const char*			m_data = nullptr;
+	std::size_t			m_size = 0;
+	std::size_t			m_offset = 0;
+	std::FILE*			m_in = nullptr;
+	bool				m_eof = false;
+	std::vector<char>	m_carry;
+
+	unsigned long	m_lines = 0;
+	unsigned long	m_errors = 0;
+
+	// target size of a chunk. chunks are extended to the end of their last line.
+	static const std::size_t CHUNK_SIZE = 1 << 18;
+
+	// mapped input is handed back to the kernel in steps of this size
+	static const std::size_t RELEASE_SIZE = 1 << 26;
+
+	// chunks in flight per thread
+	static const std::size_t CHUNKS_PER_THREAD = 4;
+
+	// longest text a single result can take, a formatted number or error code and its newline
+	static const std::size_t MAX_RESULT_SIZE = 64;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// BATCH_HPP
@@ -0,0 +1,692 @@
+//
+// BIGINT.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bigint.hpp"
+#include "../arena/arena.hpp"
+
+using bocan::BigInt;
+
+///
+/// @brief creates an integer with the value of a long.
+/// @param[in] long is the value.
+/// @return
+/// @todo
+///
+BigInt::BigInt(long value) {
+
+	unsigned long magnitude = static_cast<unsigned long>(value);
+	if(value < 0) { magnitude = 0UL - magnitude; }
+
+	while(magnitude) {
+		m_limbs.push_back(static_cast<std::uint32_t>(magnitude % BASE));
+		magnitude /= BASE;
+	}
+	m_negative = value < 0;
+}
+
+///
+/// @brief reads a run of decimal digits, nine at a time from the least significant end.
+/// @param[in] char pointer to the first digit. it need not be null terminated.
+/// @param[in] size_t is the number of digits.
+/// @return 0 if the text was read, 1 if it is empty or holds anything but digits.
+/// @todo
+///
+bool BigInt::Parse(const char* digits, std::size_t len) {
+
+	m_limbs.clear();
+	m_negative = false;
+
+	if(len == 0) { return 1; }
+	m_limbs.reserve(len / BASE_DIGITS + 1);
+
+	for(std::size_t end = len; end > 0;) {
+
+		std::size_t begin = end > static_cast<std::size_t>(BASE_DIGITS) ? end - BASE_DIGITS : 0;
+		std::uint32_t limb = 0;
+
+		for(std::size_t i = begin; i < end; i++) {
+			if(digits[i] < '0' || digits[i] > '9') { return 1; }
+			limb = limb * 10 + static_cast<std::uint32_t>(digits[i] - '0');
+		}
+		m_limbs.push_back(limb);
+		end = begin;
+	}
+
+	Trim(&m_limbs);
+	return 0;
+}
+
+///
+/// @brief writes the integer in decimal. every limb below the most significant one is exactly nine digits.
+/// @return standard string holding the digits, with a leading '-' if negative.
+/// @todo
+///
+std::string BigInt::ToString() const {
+	std::string text;
+	ToString(&text);
+	return text;
+}
+
+///
+/// @brief writes the integer in decimal into an existing string, reusing its storage.
+/// @param[out] string pointer receiving the digits, with a leading '-' if negative.
+/// @return
+/// @todo
+///
+void BigInt::ToString(std::string* out) const {
+
+	std::string& text = *out;
+	text.clear();
+
+	if(m_limbs.empty()) {
+		text.push_back('0');
+		return;
+	}
+
+	text.reserve(m_limbs.size() * BASE_DIGITS + 1);
+
+	if(m_negative) { text.push_back('-'); }
+	text.append(std::to_string(m_limbs.back()));
+
+	char digits[BASE_DIGITS];
+
+	for(std::size_t i = m_limbs.size() - 1; i-- > 0;) {
+		std::uint32_t limb = m_limbs[i];
+		for(int d = BASE_DIGITS - 1; d >= 0; d--) {
+			digits[d] = static_cast<char>('0' + limb % 10);
+			limb /= 10;
+		}
+		text.append(digits, BASE_DIGITS);
+	}
+}
+
+///
+/// @brief converts the integer to a long.
+/// @param[out] long pointer receiving the value.
+/// @return 0 if the value fits in a long, 1 if it does not.
+/// @todo
+///
+bool BigInt::ToLong(long* value) const {
+
+	unsigned long magnitude = 0;
+
+	for(std::size_t i = m_limbs.size(); i-- > 0;) {
+		if(magnitude > (ULONG_MAX - m_limbs[i]) / BASE) { return 1; }
+		magnitude = magnitude * BASE + m_limbs[i];
+	}
+
+	unsigned long limit = static_cast<unsigned long>(LONG_MAX) + (m_negative ? 1 : 0);
+	if(magnitude > limit) { return 1; }
+
+	*value = static_cast<long>(m_negative ? 0UL - magnitude : magnitude);
+	return 0;
+}
+
+///
+/// @brief counts the decimal digits of the integer, not counting the sign.
+/// @return the number of digits, 1 for zero.
+/// @todo
+///
+std::size_t BigInt::GetDigitCount() const {
+
+	if(m_limbs.empty()) { return 1; }
+
+	std::size_t count = (m_limbs.size() - 1) * BASE_DIGITS;
+	for(std::uint32_t top = m_limbs.back(); top; top /= 10) { count++; }
+	return count;
+}
+
+///
+/// @brief estimates the common logarithm of the magnitude from its two most significant limbs.
+/// @return log10 of the magnitude, or 0 for zero.
+/// @todo
+///
+double BigInt::GetLog10() const {
+
+	if(m_limbs.empty()) { return 0; }
+
+	std::size_t n = m_limbs.size();
+	double top = m_limbs[n - 1];
+	if(n > 1) { top += m_limbs[n - 2] / static_cast<double>(BASE); }
+
+	return std::log10(top) + static_cast<double>((n - 1) * BASE_DIGITS);
+}
+
+///
+/// @brief adds two integers.
+/// @param[in] BigInt reference to the left operand.
+/// @param[in] BigInt reference to the right operand.
+/// @param[out] BigInt pointer receiving the sum. it may be either operand.
+/// @return
+/// @todo
+///
+void BigInt::Add(const BigInt& lhs, const BigInt& rhs, BigInt* result) {
+	AddSigned(lhs, rhs, false, result);
+}
+
+///
+/// @brief subtracts one integer from another.
+/// @param[in] BigInt reference to the left operand.
+/// @param[in] BigInt reference to the right operand.
+/// @param[out] BigInt pointer receiving the difference. it may be either operand.
+/// @return
+/// @todo
+///
+void BigInt::Subtract(const BigInt& lhs, const BigInt& rhs, BigInt* result) {
+	AddSigned(lhs, rhs, true, result);
+}
+
+///
+/// @brief multiplies two integers. large operands are split with Karatsuba's method.
+/// @param[in] BigInt reference to the left operand.
+/// @param[in] BigInt reference to the right operand.
+/// @param[out] BigInt pointer receiving the product. it may be either operand.
+/// @return
+/// @todo
+///
+void BigInt::Multiply(const BigInt& lhs, const BigInt& rhs, BigInt* result) {
+
+	if(lhs.IsZero() || rhs.IsZero()) {
+		result->m_limbs.clear();
+		result->m_negative = false;
+		return;
+	}
+
+	Arena& scratch = Arena::GetThreadArena();
+	ArenaScope scope(scratch);
+
+	std::size_t size = lhs.m_limbs.size() + rhs.m_limbs.size();
+	std::uint32_t* product = scratch.Allocate<std::uint32_t>(size);
+	std::fill_n(product, size, 0);
+	MultiplyMagnitude(lhs.m_limbs.data(), lhs.m_limbs.size(), rhs.m_limbs.data(), rhs.m_limbs.size(), product);
+
+	result->m_negative = lhs.m_negative != rhs.m_negative;
+	Assign(product, Length(product, size), &result->m_limbs);
+}
+
+///
+/// @brief divides one integer by another. the quotient is truncated toward zero, the same as for longs.
+/// @param[in] BigInt reference to the dividend.
+/// @param[in] BigInt reference to the divisor.
+/// @param[out] BigInt pointer receiving the quotient. it may be either operand.
+/// @param[out] boolean pointer set true if the division left a remainder.
+/// @return 0 on success, 1 if the divisor is zero.
+/// @todo
+///
+bool BigInt::Divide(const BigInt& lhs, const BigInt& rhs, BigInt* quotient, bool* remainder) {
+
+	if(rhs.IsZero()) { return 1; }
+
+	if(CompareMagnitude(lhs.m_limbs, rhs.m_limbs) < 0) {
+		*remainder = !lhs.IsZero();
+		quotient->m_limbs.clear();
+		quotient->m_negative = false;
+		return 0;
+	}
+
+	Arena& scratch = Arena::GetThreadArena();
+	ArenaScope scope(scratch);
+
+	std::size_t size = lhs.m_limbs.size() - rhs.m_limbs.size() + 1;
+	std::uint32_t* q = scratch.Allocate<std::uint32_t>(size);
+	*remainder = DivideMagnitude(lhs.m_limbs, rhs.m_limbs, q);
+
+	bool negative = lhs.m_negative != rhs.m_negative;
+	Assign(q, Length(q, size), &quotient->m_limbs);
+	quotient->m_negative = !quotient->m_limbs.empty() && negative;
+	return 0;
+}
+
+///
+/// @brief raises an integer to a power by repeated squaring, scanning the exponent from its highest bit.
+/// @param[in] BigInt reference to the base.
+/// @param[in] unsigned long is the exponent.
+/// @param[out] BigInt pointer receiving the power. it may be the base.
+/// @return
+/// @todo
+///
+void BigInt::Power(const BigInt& base, unsigned long exponent, BigInt* result) {
+
+	if(exponent == 0) {
+		*result = BigInt(1);
+		return;
+	}
+
+	int bit = 63;
+	while(!((exponent >> bit) & 1)) { bit--; }
+
+	// the power is built in the result, so the base is copied first if they are the same
+	BigInt copy;
+	const BigInt* factor = &base;
+	if(result == &base) {
+		copy = base;
+		factor = &copy;
+	} else {
+		*result = base;
+	}
+
+	while(bit-- > 0) {
+		Multiply(*result, *result, result);
+		if((exponent >> bit) & 1) { Multiply(*result, *factor, result); }
+	}
+}
+
+///
+/// @brief compares the magnitudes of two trimmed integers.
+/// @param[in] vector reference to the limbs of the left operand.
+/// @param[in] vector reference to the limbs of the right operand.
+/// @return -1, 0 or 1 as the left magnitude is less than, equal to or greater than the right.
+/// @todo
+///
+int BigInt::CompareMagnitude(const limbs& lhs, const limbs& rhs) {
+
+	if(lhs.size() != rhs.size()) { return lhs.size() < rhs.size() ? -1 : 1; }
+
+	for(std::size_t i = lhs.size(); i-- > 0;) {
+		if(lhs[i] != rhs[i]) { return lhs[i] < rhs[i] ? -1 : 1; }
+	}
+	return 0;
+}
+
+///
+/// @brief adds two magnitudes.
+/// @param[in] vector reference to the limbs of the left operand.
+/// @param[in] vector reference to the limbs of the right operand.
+/// @param[out] vector pointer receiving the limbs of the sum.
+/// @return
+/// @todo
+///
+void BigInt::AddMagnitude(const limbs& lhs, const limbs& rhs, limbs* result) {
+
+	const limbs& longer = lhs.size() >= rhs.size() ? lhs : rhs;
+	const limbs& shorter = lhs.size() >= rhs.size() ? rhs : lhs;
+
+	Arena& scratch = Arena::GetThreadArena();
+	ArenaScope scope(scratch);
+
+	std::size_t size = longer.size() + 1;
+	std::uint32_t* sum = scratch.Allocate<std::uint32_t>(size);
+	std::copy(longer.begin(), longer.end(), sum);
+	sum[size - 1] = 0;
+	AddInto(sum, size, shorter.data(), shorter.size());
+
+	Assign(sum, Length(sum, size), result);
+}
+
+///
+/// @brief subtracts a smaller magnitude from a larger one.
+/// @param[in] vector reference to the limbs of the larger operand.
+/// @param[in] vector reference to the limbs of the smaller operand.
+/// @param[out] vector pointer receiving the limbs of the difference.
+/// @return
+/// @todo
+///
+void BigInt::SubtractMagnitude(const limbs& larger, const limbs& smaller, limbs* result) {
+
+	Arena& scratch = Arena::GetThreadArena();
+	ArenaScope scope(scratch);
+
+	std::uint32_t* difference = scratch.Allocate<std::uint32_t>(larger.size());
+	std::copy(larger.begin(), larger.end(), difference);
+	SubtractInto(difference, larger.size(), smaller.data(), smaller.size());
+
+	Assign(difference, Length(difference, larger.size()), result);
+}
+
+///
+/// @brief adds or subtracts two signed integers by adding or subtracting their magnitudes.
+/// @param[in] BigInt reference to the left operand.
+/// @param[in] BigInt reference to the right operand.
+/// @param[in] boolean true to subtract the right operand instead of adding it.
+/// @param[out] BigInt pointer receiving the result.
+/// @return
+/// @todo
+///
+void BigInt::AddSigned(const BigInt& lhs, const BigInt& rhs, bool subtract, BigInt* result) {
+
+	bool lhs_negative = lhs.m_negative;
+	bool rhs_negative = rhs.m_negative != (subtract && !rhs.IsZero());
+
+	if(lhs_negative == rhs_negative) {
+		AddMagnitude(lhs.m_limbs, rhs.m_limbs, &result->m_limbs);
+		result->m_negative = lhs_negative && !result->m_limbs.empty();
+		return;
+	}
+
+	if(CompareMagnitude(lhs.m_limbs, rhs.m_limbs) >= 0) {
+		SubtractMagnitude(lhs.m_limbs, rhs.m_limbs, &result->m_limbs);
+		result->m_negative = lhs_negative && !result->m_limbs.empty();
+	} else {
+		SubtractMagnitude(rhs.m_limbs, lhs.m_limbs, &result->m_limbs);
+		result->m_negative = rhs_negative;
+	}
+}
+
+///
+/// @brief divides magnitudes with Knuth's algorithm D. both operands are scaled so the top limb of the divisor
+/// @brief is at least half the base, which keeps each estimated quotient limb at most two too large.
+/// @param[in] vector reference to the limbs of the dividend. it is not smaller than the divisor.
+/// @param[in] vector reference to the limbs of the divisor. it is not zero.
+/// @param[out] uint32_t pointer receiving the limbs of the quotient. it holds one more limb than the difference in lengths.
+/// @return boolean true if the division left a remainder.
+/// @todo
+///
+bool BigInt::DivideMagnitude(const limbs& dividend, const limbs& divisor, std::uint32_t* quotient) {
+
+	const std::size_t n = dividend.size();
+	const std::size_t m = divisor.size();
+
+	std::fill_n(quotient, n - m + 1, 0);
+
+	// a single limb divisor needs no estimate
+	if(m == 1) {
+		std::uint64_t rest = 0;
+		for(std::size_t i = n; i-- > 0;) {
+			std::uint64_t current = rest * BASE + dividend[i];
+			quotient[i] = static_cast<std::uint32_t>(current / divisor[0]);
+			rest = current % divisor[0];
+		}
+		return rest != 0;
+	}
+
+	const std::uint64_t scale = BASE / (static_cast<std::uint64_t>(divisor[m - 1]) + 1);
+
+	Arena& scratch = Arena::GetThreadArena();
+	ArenaScope scope(scratch);
+
+	std::uint32_t* u = scratch.Allocate<std::uint32_t>(n + 1);
+	std::uint32_t* v = scratch.Allocate<std::uint32_t>(m);
+	std::uint64_t carry = 0;
+
+	for(std::size_t i = 0; i < n; i++) {
+		std::uint64_t product = dividend[i] * scale + carry;
+		u[i] = static_cast<std::uint32_t>(product % BASE);
+		carry = product / BASE;
+	}
+	u[n] = static_cast<std::uint32_t>(carry);
+
+	carry = 0;
+	for(std::size_t i = 0; i < m; i++) {
+		std::uint64_t product = divisor[i] * scale + carry;
+		v[i] = static_cast<std::uint32_t>(product % BASE);
+		carry = product / BASE;
+	}
+
+	for(std::size_t j = n - m + 1; j-- > 0;) {
+
+		// estimate the quotient limb from the top two limbs, then correct it with the third
+		std::uint64_t top = static_cast<std::uint64_t>(u[j + m]) * BASE + u[j + m - 1];
+		std::uint64_t estimate = top / v[m - 1];
+		std::uint64_t rest = top % v[m - 1];
+
+		while(estimate >= BASE || estimate * v[m - 2] > rest * BASE + u[j + m - 2]) {
+			estimate--;
+			rest += v[m - 1];
+			if(rest >= BASE) { break; }
+		}
+
+		// multiply and subtract
+		std::uint32_t borrow = 0;
+		carry = 0;
+		for(std::size_t i = 0; i < m; i++) {
+			std::uint64_t product = estimate * v[i] + carry;
+			carry = product / BASE;
+			std::uint32_t subtrahend = static_cast<std::uint32_t>(product - carry * BASE) + borrow;
+			std::uint32_t digit = u[i + j];
+			borrow = digit < subtrahend;
+			u[i + j] = borrow ? digit + BASE - subtrahend : digit - subtrahend;
+		}
+		std::int64_t digit = static_cast<std::int64_t>(u[j + m]) - static_cast<std::int64_t>(carry) - borrow;
+
+		// the estimate was one too large, add the divisor back
+		if(digit < 0) {
+			u[j + m] = static_cast<std::uint32_t>(digit + BASE);
+			estimate--;
+			carry = 0;
+			for(std::size_t i = 0; i < m; i++) {
+				std::uint64_t sum = static_cast<std::uint64_t>(u[i + j]) + v[i] + carry;
+				u[i + j] = static_cast<std::uint32_t>(sum % BASE);
+				carry = sum / BASE;
+			}
+			u[j + m] = static_cast<std::uint32_t>((u[j + m] + carry) % BASE);
+		} else {
+			u[j + m] = static_cast<std::uint32_t>(digit);
+		}
+
+		quotient[j] = static_cast<std::uint32_t>(estimate);
+	}
+
+	// the scaled remainder is left in the low limbs
+	return Length(u, m) != 0;
+}
+
+///
+/// @brief multiplies two magnitudes. operands below the threshold use the schoolbook method, a short operand is
+/// @brief multiplied by slices of a long one, and operands of similar length are split in half with Karatsuba's method,
+/// @brief which needs three half size products instead of four.
+/// @param[in] uint32_t pointer to the limbs of the left operand.
+/// @param[in] size_t is the number of limbs of the left operand.
+/// @param[in] uint32_t pointer to the limbs of the right operand.
+/// @param[in] size_t is the number of limbs of the right operand.
+/// @param[out] uint32_t pointer to the product. it holds the sum of both lengths in limbs and is zero on entry.
+/// @return
+/// @todo
+///
+void BigInt::MultiplyMagnitude(const std::uint32_t* a, std::size_t n, const std::uint32_t* b, std::size_t m, std::uint32_t* out) {
+
+	if(n < m) {
+		std::swap(a, b);
+		std::swap(n, m);
+	}
+
+	if(m == 0) { return; }
+
+	if(m < KARATSUBA_THRESHOLD) {
+		Schoolbook(a, n, b, m, out);
+		return;
+	}
+
+	// unbalanced, multiply by slices of the longer operand and add the partial products
+	Arena& scratch = Arena::GetThreadArena();
+	ArenaScope scope(scratch);
+
+	if(2 * m <= n) {
+		std::uint32_t* partial = scratch.Allocate<std::uint32_t>(2 * m);
+		for(std::size_t i = 0; i < n; i += m) {
+			std::size_t len = std::min(m, n - i);
+			std::fill_n(partial, 2 * m, 0);
+			MultiplyMagnitude(a + i, len, b, m, partial);
+			AddInto(out + i, n + m - i, partial, Length(partial, len + m));
+		}
+		return;
+	}
+
+	// a = a1 * BASE^k + a0 and b = b1 * BASE^k + b0, with m > k since 2m > n
+	const std::size_t k = n / 2;
+
+	// a0 * b0 goes to the low limbs and a1 * b1 to the high limbs
+	MultiplyMagnitude(a, k, b, k, out);
+	MultiplyMagnitude(a + k, n - k, b + k, m - k, out + 2 * k);
+
+	std::size_t size_a = n - k + 1;
+	std::uint32_t* sum_a = scratch.Allocate<std::uint32_t>(size_a);
+	std::fill_n(sum_a, size_a, 0);
+	std::copy(a + k, a + n, sum_a);
+	AddInto(sum_a, size_a, a, Length(a, k));
+
+	std::size_t size_b = std::max(k, m - k) + 1;
+	std::uint32_t* sum_b = scratch.Allocate<std::uint32_t>(size_b);
+	std::fill_n(sum_b, size_b, 0);
+	if(m - k >= k) {
+		std::copy(b + k, b + m, sum_b);
+		AddInto(sum_b, size_b, b, Length(b, k));
+	} else {
+		std::copy(b, b + k, sum_b);
+		AddInto(sum_b, size_b, b + k, Length(b + k, m - k));
+	}
+
+	std::size_t len_a = Length(sum_a, size_a);
+	std::size_t len_b = Length(sum_b, size_b);
+
+	// (a0 + a1) * (b0 + b1) - a0 * b0 - a1 * b1 is the middle term
+	std::size_t size_middle = len_a + len_b;
+	std::uint32_t* middle = scratch.Allocate<std::uint32_t>(size_middle);
+	std::fill_n(middle, size_middle, 0);
+	MultiplyMagnitude(sum_a, len_a, sum_b, len_b, middle);
+	SubtractInto(middle, size_middle, out, Length(out, 2 * k));
+	SubtractInto(middle, size_middle, out + 2 * k, Length(out + 2 * k, n + m - 2 * k));
+
+	AddInto(out + k, n + m - k, middle, Length(middle, size_middle));
+}
+
+///
+/// @brief multiplies two magnitudes column by column. each column is summed before it is reduced, so there is
+/// @brief one division per limb of the product rather than one per pair of limbs.
+/// @param[in] uint32_t pointer to the limbs of the longer operand.
+/// @param[in] size_t is the number of limbs of the longer operand.
+/// @param[in] uint32_t pointer to the limbs of the shorter operand.
+/// @param[in] size_t is the number of limbs of the shorter operand, below the Karatsuba threshold.
+/// @param[out] uint32_t pointer to the product. it holds the sum of both lengths in limbs.
+/// @return
+/// @todo
+///
+void BigInt::Schoolbook(const std::uint32_t* a, std::size_t n, const std::uint32_t* b, std::size_t m, std::uint32_t* out) {
+
+	// a column is kept as high * BASE^2 + low. each product is below BASE^2, so low can take
+	// PRODUCTS_PER_FOLD of them before it has to be folded into high.
+	const std::uint64_t square = static_cast<std::uint64_t>(BASE) * BASE;
+	const std::size_t PRODUCTS_PER_FOLD = 16;
+	std::uint64_t carry = 0;
+
+	for(std::size_t column = 0; column + 1 < n + m; column++) {
+
+		std::uint64_t low = carry;
+		std::uint64_t high = 0;
+
+		std::size_t i = column >= m ? column - m + 1 : 0;
+		std::size_t end = std::min(column, n - 1) + 1;
+
+		while(i < end) {
+			std::size_t stop = std::min(end, i + PRODUCTS_PER_FOLD);
+			for(; i < stop; i++) {
+				low += static_cast<std::uint64_t>(a[i]) * b[column - i];
+			}
+			high += low / square;
+			low %= square;
+		}
+
+		out[column] = static_cast<std::uint32_t>(low % BASE);
+		carry = high * BASE + low / BASE;
+	}
+	out[n + m - 1] = static_cast<std::uint32_t>(carry);
+}
+
+///
+/// @brief adds a magnitude into a longer one in place.
+/// @param[in,out] uint32_t pointer to the limbs receiving the sum. the sum must fit in its length.
+/// @param[in] size_t is the number of limbs of the destination.
+/// @param[in] uint32_t pointer to the limbs to add.
+/// @param[in] size_t is the number of limbs to add, not more than the destination.
+/// @return
+/// @todo
+///
+void BigInt::AddInto(std::uint32_t* dst, std::size_t dst_len, const std::uint32_t* src, std::size_t src_len) {
+
+	std::uint32_t carry = 0;
+	std::size_t i = 0;
+
+	for(; i < src_len; i++) {
+		std::uint32_t sum = dst[i] + src[i] + carry;
+		carry = sum >= BASE;
+		dst[i] = carry ? sum - BASE : sum;
+	}
+	for(; carry && i < dst_len; i++) {
+		std::uint32_t sum = dst[i] + carry;
+		carry = sum >= BASE;
+		dst[i] = carry ? sum - BASE : sum;
+	}
+}
+
+///
+/// @brief subtracts a magnitude from a larger one in place.
+/// @param[in,out] uint32_t pointer to the limbs receiving the difference.
+/// @param[in] size_t is the number of limbs of the destination.
+/// @param[in] uint32_t pointer to the limbs to subtract. their value is not more than the destination's.
+/// @param[in] size_t is the number of limbs to subtract, not more than the destination.
+/// @return
+/// @todo
+///
+void BigInt::SubtractInto(std::uint32_t* dst, std::size_t dst_len, const std::uint32_t* src, std::size_t src_len) {
+
+	std::uint32_t borrow = 0;
+	std::size_t i = 0;
+
+	for(; i < src_len; i++) {
+		std::uint32_t subtrahend = src[i] + borrow;
+		borrow = dst[i] < subtrahend;
+		dst[i] = borrow ? dst[i] + BASE - subtrahend : dst[i] - subtrahend;
+	}
+	for(; borrow && i < dst_len; i++) {
+		borrow = dst[i] == 0;
+		dst[i] = borrow ? BASE - 1 : dst[i] - 1;
+	}
+}
+
+///
+/// @brief finds the length of a magnitude without its leading zero limbs.
+/// @param[in] uint32_t pointer to the limbs.
+/// @param[in] size_t is the number of limbs.
+/// @return the number of limbs up to and including the most significant non zero limb.
+/// @todo
+///
+std::size_t BigInt::Length(const std::uint32_t* digits, std::size_t len) {
+	while(len && digits[len - 1] == 0) { len--; }
+	return len;
+}
+
+///
+/// @brief removes leading zero limbs.
+/// @param[in,out] vector pointer to the limbs.
+/// @return
+/// @todo
+///
+void BigInt::Trim(limbs* digits) {
+	digits->resize(Length(digits->data(), digits->size()));
+}
+
+///
+/// @brief copies limbs from scratch storage into a vector. its storage is reused when it is large enough.
+/// @param[in] uint32_t pointer to the first limb.
+/// @param[in] size_t is the number of limbs, without leading zeros.
+/// @param[out] vector pointer receiving the limbs.
+/// @return
+/// @todo
+///
+void BigInt::Assign(const std::uint32_t* digits, std::size_t len, limbs* result) {
+	result->assign(digits, digits + len);
+}
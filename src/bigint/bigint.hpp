@@ -0,0 +1,89 @@
+//
+// BIGINT.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef BIGINT_HPP
+#define BIGINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bocan {
+
+// an integer of any size, stored as a sign and base 10^9 limbs from least to most significant.
+// a decimal base makes reading digits and printing them linear, so Output() never waits on a base conversion.
+// zero has no limbs and is never negative. the arithmetic works on copies, so a result may alias an operand.
+// copies and partial products are taken from the calling thread's arena, and a result is copied into the
+// limbs its destination already has, so a solver that has warmed up makes no heap allocations.
+class BigInt {
+
+public:
+	BigInt() {}
+	explicit BigInt(long);
+
+	bool		Parse(const char*, std::size_t);
+	std::string	ToString() const;
+	void		ToString(std::string*) const;
+	bool		ToLong(long*) const;
+
+	bool		IsZero() const { return m_limbs.empty(); }
+	bool		IsNegative() const { return m_negative; }
+	bool		IsOdd() const { return !m_limbs.empty() && (m_limbs[0] & 1); }
+	std::size_t	GetDigitCount() const;
+	double		GetLog10() const;
+	void		Negate() { m_negative = !m_negative && !m_limbs.empty(); }
+
+	static void	Add(const BigInt&, const BigInt&, BigInt*);
+	static void	Subtract(const BigInt&, const BigInt&, BigInt*);
+	static void	Multiply(const BigInt&, const BigInt&, BigInt*);
+	static bool	Divide(const BigInt&, const BigInt&, BigInt*, bool*);
+	static void	Power(const BigInt&, unsigned long, BigInt*);
+
+	static const std::uint32_t BASE = 1000000000;
+	static const int BASE_DIGITS = 9;
+
+	// operands with fewer limbs than this are multiplied with the schoolbook method
+	static const std::size_t KARATSUBA_THRESHOLD = 64;
+
+private:
+	typedef std::vector<std::uint32_t> limbs;
+
+	static int	CompareMagnitude(const limbs&, const limbs&);
+	static void	AddMagnitude(const limbs&, const limbs&, limbs*);
+	static void	SubtractMagnitude(const limbs&, const limbs&, limbs*);
+	static void	AddSigned(const BigInt&, const BigInt&, bool, BigInt*);
+	static bool	DivideMagnitude(const limbs&, const limbs&, std::uint32_t*);
+
+	static void	MultiplyMagnitude(const std::uint32_t*, std::size_t, const std::uint32_t*, std::size_t, std::uint32_t*);
+	static void	Schoolbook(const std::uint32_t*, std::size_t, const std::uint32_t*, std::size_t, std::uint32_t*);
+	static void	AddInto(std::uint32_t*, std::size_t, const std::uint32_t*, std::size_t);
+	static void	SubtractInto(std::uint32_t*, std::size_t, const std::uint32_t*, std::size_t);
+	static std::size_t	Length(const std::uint32_t*, std::size_t);
+	static void	Trim(limbs*);
+	static void	Assign(const std::uint32_t*, std::size_t, limbs*);
+
+	limbs	m_limbs;
+	bool	m_negative = false;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// BIGINT_HPP
@@ -0,0 +1,440 @@
+//
+// BYTECODE.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "bytecode.hpp"
+#include "../grammar/grammar.hpp"
+
+using bocan::Bytecode;
+using bocan::BytecodeView;
+using bocan::Vm;
+
+// labels as values are a GNU extension. other compilers dispatch with a switch.
+#if defined(__GNUC__)
+#define VM_COMPUTED_GOTO 1
+#endif
+
+namespace {
+
+const char* const k_opcode_names[bocan::OP_COUNT] = {
+	"CONSTANT", "VARIABLE", "ADD", "SUBTRACT", "MULTIPLY", "DIVIDE", "POWER", "NEGATE", "RETURN"
+};
+
+// the arithmetic of each type, matching Evaluator::PerformMathOperation().
+// long addition, subtraction, multiplication and negation wrap around on overflow.
+
+inline void Decode(std::uint64_t bits, long* value) { *value = static_cast<long>(bits); }
+inline void Decode(std::uint64_t bits, double* value) { std::memcpy(value, &bits, sizeof(double)); }
+
+inline long Add(long a, long b) { return bocan::WrapAdd(a, b); }
+inline long Subtract(long a, long b) { return bocan::WrapSubtract(a, b); }
+inline long Multiply(long a, long b) { return bocan::WrapMultiply(a, b); }
+inline long Negate(long a) { return bocan::WrapNegate(a); }
+inline long Power(long a, long b) { return std::pow(a, b); }
+inline bool Remainder(long a, long b) { return (a % b) > 0; }
+
+inline double Add(double a, double b) { return a + b; }
+inline double Subtract(double a, double b) { return a - b; }
+inline double Multiply(double a, double b) { return a * b; }
+inline double Negate(double a) { return -a; }
+inline double Power(double a, double b) { return std::pow(a, b); }
+inline bool Remainder(double, double) { return false; }
+
+} // NAMESPACE
+
+///
+/// @brief compiles a syntax tree to bytecode. the nodes are already in postorder, so each node becomes one instruction.
+/// @param[in] Ast reference to the parsed expression.
+/// @return 0 if the program was compiled, 1 if it has more constants or variables than an operand can address.
+/// @todo
+///
+bool Bytecode::Compile(const Ast& ast) {
+
+	m_code.clear();
+	m_positions.clear();
+	m_constants.clear();
+	m_depth = 0;
+
+	m_header = bytecode_header();
+	m_header.magic = MAGIC;
+	m_header.version = VERSION;
+	m_header.floating = ast.floating;
+
+	if(ast.nodes.empty() || ast.integers.size() > MAX_OPERAND || ast.floats.size() > MAX_OPERAND || ast.variables.size() > MAX_OPERAND) {
+		return 1;
+	}
+
+	if(ast.floating) {
+		for(double constant : ast.floats) {
+			std::uint64_t bits = 0;
+			std::memcpy(&bits, &constant, sizeof(double));
+			m_constants.push_back(bits);
+		}
+	} else {
+		for(long constant : ast.integers) {
+			m_constants.push_back(static_cast<std::uint64_t>(constant));
+		}
+	}
+
+	if(ast.shared == 0) {
+		for(const Node& node : ast.nodes) { EmitNode(node); }
+	} else {
+		EmitTree(ast.nodes);
+	}
+	Emit(OP_RETURN, 0, ast.nodes.back().pos);
+
+	m_header.code_size = static_cast<std::uint32_t>(m_code.size());
+	m_header.constant_count = static_cast<std::uint32_t>(m_constants.size());
+	m_header.variable_count = static_cast<std::uint32_t>(ast.variables.size());
+	return 0;
+}
+
+///
+/// @brief writes the instruction for one node.
+/// @param[in] Node reference to the node.
+/// @return
+/// @todo
+///
+void Bytecode::EmitNode(const Node& node) {
+	switch(node.type) {
+		case NODE_NUMBER:	Emit(OP_CONSTANT, node.lhs, node.pos); break;
+		case NODE_VARIABLE:	Emit(OP_VARIABLE, node.lhs, node.pos); break;
+		case NODE_NEGATE:	Emit(OP_NEGATE, 0, node.pos); break;
+		case NODE_ADD:		Emit(OP_ADD, 0, node.pos); break;
+		case NODE_SUBTRACT:	Emit(OP_SUBTRACT, 0, node.pos); break;
+		case NODE_MULTIPLY:	Emit(OP_MULTIPLY, 0, node.pos); break;
+		case NODE_DIVIDE:	Emit(OP_DIVIDE, 0, node.pos); break;
+		case NODE_POWER:	Emit(OP_POWER, 0, node.pos); break;
+	}
+}
+
+///
+/// @brief writes the instructions for a tree with shared nodes, walking it from the root. a program runs on a
+/// @brief stack and cannot refer back to a value, so a shared node is written again at each of its uses.
+/// @param[in] vector reference to the nodes, the root last.
+/// @return
+/// @todo
+///
+void Bytecode::EmitTree(const std::vector<Node>& nodes) {
+
+	// a node, and whether its operands have been written already
+	std::vector<std::pair<unsigned int, bool>> stack;
+	stack.emplace_back(static_cast<unsigned int>(nodes.size() - 1), false);
+
+	while(!stack.empty()) {
+
+		std::pair<unsigned int, bool> top = stack.back();
+		stack.pop_back();
+
+		const Node& node = nodes[top.first];
+		if(top.second || node.type == NODE_NUMBER || node.type == NODE_VARIABLE) {
+			EmitNode(node);
+			continue;
+		}
+
+		stack.emplace_back(top.first, true);
+		if(node.type != NODE_NEGATE) { stack.emplace_back(node.rhs, false); }
+		stack.emplace_back(node.lhs, false);
+	}
+}
+
+///
+/// @brief returns a view of the compiled program. it stays valid until the next call of Compile().
+/// @return BytecodeView pointing into this object.
+/// @todo
+///
+BytecodeView Bytecode::View() const {
+	return BytecodeView{ &m_header, m_code.data(), m_positions.data(), m_constants.data() };
+}
+
+///
+/// @brief checks that a program is well formed before it is run: the header, every opcode and operand,
+/// @brief and that the operand stack never underflows or exceeds max_stack and holds one value at OP_RETURN.
+/// @param[in] BytecodeView of the program, possibly read from outside this process.
+/// @return 0 if the program can be run safely, 1 if it is malformed.
+/// @todo
+///
+bool Bytecode::Verify(const BytecodeView& program) {
+
+	const bytecode_header* header = program.header;
+
+	if(!header || header->magic != MAGIC || header->version != VERSION || header->code_size == 0) { return 1; }
+	if(!program.code || !program.positions || (header->constant_count && !program.constants)) { return 1; }
+
+	std::uint32_t depth = 0;
+
+	for(std::uint32_t i = 0; i < header->code_size; i++) {
+
+		std::uint32_t operand = GetOperand(program.code[i]);
+
+		switch(GetOpcode(program.code[i])) {
+			case OP_CONSTANT:
+				if(operand >= header->constant_count) { return 1; }
+				depth++;
+				break;
+			case OP_VARIABLE:
+				if(operand >= header->variable_count) { return 1; }
+				depth++;
+				break;
+			case OP_NEGATE:
+				if(operand || depth < 1) { return 1; }
+				break;
+			case OP_ADD:
+			case OP_SUBTRACT:
+			case OP_MULTIPLY:
+			case OP_DIVIDE:
+			case OP_POWER:
+				if(operand || depth < 2) { return 1; }
+				depth--;
+				break;
+			case OP_RETURN:
+
+				// the only return is the last instruction
+				return operand || depth != 1 || i != header->code_size - 1;
+			default:
+				return 1;
+		}
+
+		if(depth > header->max_stack) { return 1; }
+	}
+
+	// no return
+	return 1;
+}
+
+///
+/// @brief appends one instruction and its source position, and tracks the deepest the operand stack can get.
+/// @param[in] opcode of the instruction.
+/// @param[in] unsigned integer is the operand.
+/// @param[in] unsigned integer is the position of the operator or number within the expression.
+/// @return
+/// @todo
+///
+void Bytecode::Emit(opcode op, std::uint32_t operand, std::uint32_t pos) {
+
+	switch(op) {
+		case OP_CONSTANT:
+		case OP_VARIABLE:
+			m_depth++;
+			break;
+		case OP_NEGATE:
+		case OP_RETURN:
+			break;
+		default:
+			m_depth--;
+			break;
+	}
+	if(m_depth > m_header.max_stack) { m_header.max_stack = m_depth; }
+
+	m_code.push_back(Encode(op, operand));
+	m_positions.push_back(pos);
+}
+
+///
+/// @brief runs a program that has been compiled, or has passed Bytecode::Verify().
+/// @param[in] BytecodeView of the program.
+/// @param[in] double pointer to one value per variable. may be null if the program has none.
+/// @param[out] Solution pointer receiving the solution or the error.
+/// @return 0 if the program ran to OP_RETURN, 1 on error.
+/// @todo
+///
+bool Vm::Run(const BytecodeView& program, const double* variables, Solution* solution) {
+
+	*solution = Solution();
+	solution->floating = program.header->floating;
+
+	if(!variables && program.header->variable_count) {
+		solution->error_code = SOLVE_ERROR;
+		return 1;
+	}
+
+	if(solution->floating) { return Execute(program, variables, &m_floats, solution); }
+	return Execute(program, variables, &m_integers, solution);
+}
+
+///
+/// @brief the interpreter loop. each handler pops its operands, pushes its result and jumps straight to the next handler.
+/// @param[in] BytecodeView of the program.
+/// @param[in] double pointer to the variables.
+/// @param[in,out] vector pointer to the operand stack, grown to max_stack if it is smaller.
+/// @param[out] Solution pointer receiving the solution or the error.
+/// @return 0 on success, 1 on error.
+/// @todo
+///
+template<typename T>
+bool Vm::Execute(const BytecodeView& program, const double* variables, std::vector<T>* stack, Solution* solution) {
+
+	if(stack->size() < program.header->max_stack) { stack->resize(program.header->max_stack); }
+
+	const std::uint32_t* const code = program.code;
+	const std::uint32_t* ip = code;
+	const std::uint64_t* const constants = program.constants;
+
+	// sp points one past the top of the stack
+	T* sp = stack->data();
+
+#ifdef VM_COMPUTED_GOTO
+	static void* const k_labels[OP_COUNT] = {
+		&&op_constant, &&op_variable, &&op_add, &&op_subtract, &&op_multiply,
+		&&op_divide, &&op_power, &&op_negate, &&op_return
+	};
+#define VM_DISPATCH()		goto *k_labels[Bytecode::GetOpcode(*ip)]
+#define VM_CASE(op, label)	label:
+	VM_DISPATCH();
+	{
+#else
+#define VM_DISPATCH()		goto dispatch
+#define VM_CASE(op, label)	case op:
+dispatch:
+	switch(Bytecode::GetOpcode(*ip)) {
+#endif
+
+	VM_CASE(OP_CONSTANT, op_constant)
+		Decode(constants[Bytecode::GetOperand(*ip)], sp++);
+		ip++;
+		VM_DISPATCH();
+
+	VM_CASE(OP_VARIABLE, op_variable)
+		*sp++ = static_cast<T>(variables[Bytecode::GetOperand(*ip)]);
+		ip++;
+		VM_DISPATCH();
+
+	VM_CASE(OP_ADD, op_add)
+		sp--;
+		sp[-1] = Add(sp[-1], sp[0]);
+		ip++;
+		VM_DISPATCH();
+
+	VM_CASE(OP_SUBTRACT, op_subtract)
+		sp--;
+		sp[-1] = Subtract(sp[-1], sp[0]);
+		ip++;
+		VM_DISPATCH();
+
+	VM_CASE(OP_MULTIPLY, op_multiply)
+		sp--;
+		sp[-1] = Multiply(sp[-1], sp[0]);
+		ip++;
+		VM_DISPATCH();
+
+	VM_CASE(OP_DIVIDE, op_divide)
+		sp--;
+
+		// check for a divide by zero error
+		if(sp[0] == 0) {
+			solution->error_code = DIVIDE_BY_ZERO;
+			solution->error_pos = program.positions[ip - code];
+			return 1;
+		}
+
+		// check for a division remainder
+		if(Remainder(sp[-1], sp[0])) { solution->modulus = true; }
+
+		sp[-1] = sp[-1] / sp[0];
+		ip++;
+		VM_DISPATCH();
+
+	VM_CASE(OP_POWER, op_power)
+		sp--;
+		sp[-1] = Power(sp[-1], sp[0]);
+		ip++;
+		VM_DISPATCH();
+
+	VM_CASE(OP_NEGATE, op_negate)
+		sp[-1] = Negate(sp[-1]);
+		ip++;
+		VM_DISPATCH();
+
+	VM_CASE(OP_RETURN, op_return)
+		if(solution->floating) {
+			solution->real = static_cast<double>(sp[-1]);
+		} else {
+			solution->integer = static_cast<long>(sp[-1]);
+		}
+		return 0;
+
+#ifndef VM_COMPUTED_GOTO
+	default:
+		solution->error_code = SOLVE_ERROR;
+		solution->error_pos = program.positions[ip - code];
+		return 1;
+#endif
+	}
+
+#undef VM_DISPATCH
+#undef VM_CASE
+}
+
+///
+/// @brief writes a readable listing of a program: the header, then one line per instruction
+/// @brief with its index, opcode, operand, the constant it loads and its position in the expression.
+/// @param[in] BytecodeView of the program. it is verified first.
+/// @param[in] FILE pointer to the stream receiving the listing.
+/// @return 0 on success, 1 if the program is malformed or the listing could not be written.
+/// @todo
+///
+bool bocan::Disassemble(const BytecodeView& program, std::FILE* out) {
+
+	if(Bytecode::Verify(program)) {
+		std::fprintf(out, "; MALFORMED PROGRAM\n");
+		return 1;
+	}
+
+	const bytecode_header& header = *program.header;
+
+	std::fprintf(out, "; BYTECODE VERSION %u %s CODE %u CONSTANTS %u VARIABLES %u STACK %u\n",
+		header.version, header.floating ? "DOUBLE" : "LONG", header.code_size,
+		header.constant_count, header.variable_count, header.max_stack);
+
+	for(std::uint32_t i = 0; i < header.code_size; i++) {
+
+		opcode op = Bytecode::GetOpcode(program.code[i]);
+		std::uint32_t operand = Bytecode::GetOperand(program.code[i]);
+
+		std::fprintf(out, "%04u  %-9s", i, k_opcode_names[op]);
+
+		if(op == OP_CONSTANT) {
+			if(header.floating) {
+				double value = 0;
+				Decode(program.constants[operand], &value);
+				std::fprintf(out, " %-6u ; %-20.17g", operand, value);
+			} else {
+				long value = 0;
+				Decode(program.constants[operand], &value);
+				std::fprintf(out, " %-6u ; %-20ld", operand, value);
+			}
+		} else if(op == OP_VARIABLE) {
+			std::fprintf(out, " %-6u ; %-20s", operand, "");
+		} else {
+			std::fprintf(out, " %-6s   %-20s", "", "");
+		}
+
+		std::fprintf(out, " @%u\n", program.positions[i]);
+	}
+
+	return std::ferror(out) != 0;
+}
@@ -0,0 +1,121 @@
+//
+// BYTECODE.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef BYTECODE_HPP
+#define BYTECODE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "../calculator/errors.hpp"
+#include "../parser/parser.hpp"
+#include "../solver/solver.hpp"
+
+namespace bocan {
+
+// every instruction is 32 bits wide: the opcode in the low 8 bits and an operand in the high 24 bits.
+// the operand is a constant or variable index for OP_CONSTANT and OP_VARIABLE and zero otherwise.
+// opcode values are part of the format, so new opcodes are only ever appended.
+enum opcode : unsigned char {
+	OP_CONSTANT,
+	OP_VARIABLE,
+	OP_ADD,
+	OP_SUBTRACT,
+	OP_MULTIPLY,
+	OP_DIVIDE,
+	OP_POWER,
+	OP_NEGATE,
+	OP_RETURN,
+	OP_COUNT
+};
+
+// the first bytes of a compiled program. the sections follow in this order:
+// code_size instructions, code_size source positions (one per instruction, for error reporting),
+// and constant_count 64-bit constants, holding longs or the bits of doubles depending on floating.
+struct bytecode_header {
+	std::uint32_t	magic;
+	std::uint16_t	version;
+	std::uint8_t	floating;
+	std::uint8_t	reserved;
+	std::uint32_t	code_size;
+	std::uint32_t	constant_count;
+	std::uint32_t	variable_count;
+	std::uint32_t	max_stack;
+};
+
+// a program that does not own its storage, so it can point into a buffer or a mapped file as well as into a Bytecode.
+struct BytecodeView {
+	const bytecode_header*	header;
+	const std::uint32_t*	code;
+	const std::uint32_t*	positions;
+	const std::uint64_t*	constants;
+};
+
+// an expression compiled to a flat stack machine program.
+class Bytecode {
+
+public:
+	bool			Compile(const Ast&);
+	BytecodeView	View() const;
+
+	static bool		Verify(const BytecodeView&);
+
+	static const std::uint32_t	MAGIC = 0x4E414342;	// "BCAN"
+	static const std::uint16_t	VERSION = 1;
+	static const std::uint32_t	MAX_OPERAND = 0xFFFFFF;
+
+	static std::uint32_t	Encode(opcode op, std::uint32_t operand) { return (operand << 8) | op; }
+	static opcode			GetOpcode(std::uint32_t instruction) { return static_cast<opcode>(instruction & 0xFF); }
+	static std::uint32_t	GetOperand(std::uint32_t instruction) { return instruction >> 8; }
+
+private:
+	void	Emit(opcode, std::uint32_t, std::uint32_t);
+	void	EmitNode(const Node&);
+	void	EmitTree(const std::vector<Node>&);
+
+	bytecode_header				m_header = {};
+	std::vector<std::uint32_t>	m_code;
+	std::vector<std::uint32_t>	m_positions;
+	std::vector<std::uint64_t>	m_constants;
+	std::uint32_t				m_depth = 0;
+};
+
+// runs compiled programs. it keeps only its operand stacks between calls,
+// so each thread can own one and run any number of programs without allocating.
+class Vm {
+
+public:
+	bool	Run(const BytecodeView&, const double*, Solution*);
+
+private:
+	template<typename T>
+	bool	Execute(const BytecodeView&, const double*, std::vector<T>*, Solution*);
+
+	std::vector<long>	m_integers;
+	std::vector<double>	m_floats;
+};
+
+bool	Disassemble(const BytecodeView&, std::FILE*);
+
+} // NAMESPACE BOCAN
+
+#endif	// BYTECODE_HPP
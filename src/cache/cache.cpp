@@ -0,0 +1,123 @@
+//
+// CACHE.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+#include "cache.hpp"
+
+using bocan::SolutionCache;
+
+///
+/// @brief creates an empty cache.
+/// @param[in] size_t is the most entries the cache holds. zero is treated as one.
+/// @return
+/// @todo
+///
+SolutionCache::SolutionCache(std::size_t capacity) : m_capacity(capacity ? capacity : 1) {
+	m_index.reserve(m_capacity);
+}
+
+///
+/// @brief finds the solution stored for a whole expression and counts the lookup as a hit or a miss.
+/// @param[in] string_view is the normalized key.
+/// @param[out] Solution pointer receiving the stored solution. it is left untouched on a miss.
+/// @return boolean true on a hit, false on a miss.
+/// @todo
+///
+bool SolutionCache::Lookup(std::string_view key, Solution* solution) {
+	bool hit = Find(key, solution);
+	if(hit) { m_hits++; } else { m_misses++; }
+	return hit;
+}
+
+///
+/// @brief finds the value stored for a parenthesized group. group lookups have counters of their own.
+/// @param[in] string_view is the normalized key.
+/// @param[out] Solution pointer receiving the stored value. it is left untouched on a miss.
+/// @return boolean true on a hit, false on a miss.
+/// @todo
+///
+bool SolutionCache::LookupGroup(std::string_view key, Solution* solution) {
+	bool hit = Find(key, solution);
+	if(hit) { m_group_hits++; } else { m_group_misses++; }
+	return hit;
+}
+
+///
+/// @brief finds the solution stored for a key and marks it as the most recently used.
+/// @param[in] string_view is the normalized key.
+/// @param[out] Solution pointer receiving the stored solution. it is left untouched on a miss.
+/// @return boolean true if the key is stored, false otherwise.
+/// @todo
+///
+bool SolutionCache::Find(std::string_view key, Solution* solution) {
+
+	auto found = m_index.find(key);
+	if(found == m_index.end()) { return false; }
+
+	m_entries.splice(m_entries.begin(), m_entries, found->second);
+	*solution = found->second->solution;
+	return true;
+}
+
+///
+/// @brief stores the solution for a key as the most recently used entry, evicting the least recently used one if the cache is full.
+/// @param[in] string_view is the normalized key.
+/// @param[in] Solution reference to the solution to store.
+/// @return
+/// @todo
+///
+void SolutionCache::Insert(std::string_view key, const Solution& solution) {
+
+	auto found = m_index.find(key);
+
+	if(found != m_index.end()) {
+		found->second->solution = solution;
+		m_entries.splice(m_entries.begin(), m_entries, found->second);
+		return;
+	}
+
+	if(m_index.size() < m_capacity) {
+		m_entries.emplace_front();
+	} else {
+		// the oldest entry is reused for the new key
+		auto oldest = std::prev(m_entries.end());
+		m_index.erase(oldest->key);
+		m_entries.splice(m_entries.begin(), m_entries, oldest);
+		m_evictions++;
+	}
+
+	entry& front = m_entries.front();
+	front.key.assign(key.data(), key.size());
+	front.solution = solution;
+	m_index.emplace(front.key, m_entries.begin());
+}
+
+///
+/// @brief removes every entry. the counters are kept.
+/// @return
+/// @todo
+///
+void SolutionCache::Clear() {
+	m_index.clear();
+	m_entries.clear();
+}
@@ -0,0 +1,79 @@
+//
+// CACHE.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef CACHE_HPP
+#define CACHE_HPP
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "../solver/solver.hpp"
+
+namespace bocan {
+
+// a bounded least recently used map from the normalized text of an expression, or of a parenthesized
+// group within one, to its solution. keys are built by the solver, see Solver::SetCache().
+// it is not thread safe, each solver owns its own cache. once the cache is full an insert reuses
+// the list entry and key storage of the entry it evicts. lookups of whole expressions and of groups
+// are counted apart, so the hit rate is the share of expressions that were not solved again.
+class SolutionCache {
+
+public:
+	explicit SolutionCache(std::size_t capacity);
+
+	bool	Lookup(std::string_view, Solution*);
+	bool	LookupGroup(std::string_view, Solution*);
+	void	Insert(std::string_view, const Solution&);
+	void	Clear();
+
+	std::size_t		GetCapacity() const { return m_capacity; }
+	std::size_t		GetSize() const { return m_index.size(); }
+	unsigned long	GetHitCount() const { return m_hits; }
+	unsigned long	GetMissCount() const { return m_misses; }
+	unsigned long	GetEvictionCount() const { return m_evictions; }
+	unsigned long	GetGroupHitCount() const { return m_group_hits; }
+	unsigned long	GetGroupMissCount() const { return m_group_misses; }
+
+private:
+	struct entry {
+		std::string	key;
+		Solution	solution;
+	};
+
+	bool	Find(std::string_view, Solution*);
+
+	// most recently used first. the index refers to the keys held by the list nodes, which never move.
+	std::list<entry>	m_entries;
+	std::unordered_map<std::string_view, std::list<entry>::iterator>	m_index;
+
+	std::size_t		m_capacity;
+	unsigned long	m_hits = 0;
+	unsigned long	m_misses = 0;
+	unsigned long	m_evictions = 0;
+	unsigned long	m_group_hits = 0;
+	unsigned long	m_group_misses = 0;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// CACHE_HPP
@@ -21,76 +21,60 @@
 #ifndef CALCULATOR_HPP
 #define CALCULATOR_HPP
 
+#include <cstddef>
 #include <string>
+#include <string_view>
+
+#include "errors.hpp"
+#include "../solver/solver.hpp"
+#include "../worksheet/worksheet.hpp"
 
 namespace bocan {
 
 class Calculator {
 
 public: 
-	static Calculator& Get() { return s_instance; }
+	Calculator() {}
+	Calculator(const Calculator&) = delete;
+	~Calculator() {}
 
-	void	Initialize();
+	void	Initialize(bool bigint = false, const DecimalFormat* decimal = nullptr);
 	bool 	Input(int, char**);
 	void 	Solve();
 	void 	Output();
 	bool 	CheckExitFlag();
 
-private: 
-	static Calculator s_instance;
+	void	SetStats(SolveStats* stats) { m_solver.SetStats(stats); }
+	void	SetPool(ThreadPool* pool) { m_solver.SetPool(pool); }
 
+private: 
 	std::string	m_expression;
 
+	// user interface state only. everything about the expression being solved is in the solution.
 	struct flags {
 		bool 	exit;
 		bool 	cli_arg;
-		bool 	solve_err;
-		bool 	left_neg;
-		bool 	right_neg;
-		bool 	modulus;
-		bool	floating;
+		bool	bigint;
+		bool	decimal;
+		bool	assignment;		// the line defines a name, as in 'rate = 0.07'
+		bool	worksheet;		// the line uses names, so it is solved with the worksheet's values
 	} m_flag;
 
-	enum errors {
-		DIVIDE_BY_ZERO,
-		SOLVE_ERROR,
-		INTEGER_DIVIDE_REMAINDER,
-		INVALID_INPUT_INVALID_OPERATOR,
-		INVALID_INPUT_THREE_MINUS,
-		INVALID_INPUT_MINUS_LAST,
-		INVALID_INPUT_OPERATOR_FIRST,
-		INVALID_INPUT_OPERATOR_LAST,
-		INVALID_INPUT_DUAL_OPERATORS,
-		INVALID_INPUT_INVALID_INTEGER,
-		INVALID_INPUT_LEFT_PAREN,
-		INVALID_INPUT_RIGHT_PAREN,
-		INVALID_INPUT_PARENTHESES_MISMATCH,
-		INVALID_INPUT_RADIX_POINT
-	} m_error_code;
+	Solver			m_solver;
+	Solution		m_solution;
+	BigInt			m_big;
+	Decimal			m_decimal;
+	DecimalFormat	m_format;
 
-private:
+	// definitions made so far, and 'ans', the last solution of a line that was not an assignment
+	Worksheet			m_sheet;
+	std::string_view	m_name;
+	std::size_t			m_definition = 0;
 
-	Calculator() {}
-	Calculator(const Calculator&) = delete;
-	~Calculator() {}
+private:
 
 	bool	ValidateInputString();
-
-	void 	ResolveExpSqrLoop(std::string*);
-	void	ResolveMulDivLoop(std::string*);
-	void	ResolveAddSubLoop(std::string*);
-
-	long	GetLeftOperand(std::string*, int, int*, long);
-	double	GetLeftOperand(std::string*, int, int*, double);
-
-	long	GetRightOperand(std::string*, int, int*, long);
-	double  GetRightOperand(std::string*, int, int*, double);
-
-	long 	PerformMathOperation(long, long, char);
-	double  PerformMathOperation(double, double, char);
-
-	bool 	IsOperator(char);
-	bool	IsInteger(char);
+	void	SolveWorksheet();
 
 	void	PrintError(int);
 
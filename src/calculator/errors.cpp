@@ -0,0 +1,76 @@
+//
+// ERRORS.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include "errors.hpp"
+
+///
+/// @brief returns the description of an error code, as printed after ">ERROR <code>. ".
+/// @param[in] integer corresponding to the errors enum.
+/// @return pointer to a static string. never null.
+/// @todo
+///
+const char* bocan::GetErrorMessage(int error_code) {
+	switch(error_code) {
+		case(NO_ERROR):
+			return "NO ERROR.";
+		case(DIVIDE_BY_ZERO):
+			return "DIVIDE BY ZERO.";
+		case(SOLVE_ERROR):
+			return "UNABLE TO COMPUTE SOLUTION.";
+		case(INTEGER_DIVIDE_REMAINDER):
+			return "DIVISION OPERATION RESULTED IN A NONINTEGER SOLUTION. SOLUTION MAY NOT BE CORRECT.";
+		case(INVALID_INPUT_INVALID_OPERATOR):
+			return "INVALID OPERATOR.";
+		case(INVALID_INPUT_THREE_MINUS):
+			return "INVALID INPUT. NO MORE THAN TWO '-' MAY BE PASSED IN A ROW.";
+		case(INVALID_INPUT_MINUS_LAST):
+			return "INVALID INPUT. THE EXPRESSION MUST NOT END WITH '-'.";
+		case(INVALID_INPUT_OPERATOR_FIRST):
+			return "INVALID INPUT. BEGIN THE EXPRESSION WITH A VALID INTEGER (0-9) OR NEGATIVE OPERATOR (-) IF NEGATIVE NUMBER.";
+		case(INVALID_INPUT_OPERATOR_LAST):
+			return "INVALID INPUT. THE EXPRESSION MUST END WITH A VALID INTEGER (0-9).";
+		case(INVALID_INPUT_DUAL_OPERATORS):
+			return "INVALID INPUT. INPUT ONLY ONE VALID OPERATOR BETWEEN TWO INTEGERS.";
+		case(INVALID_INPUT_INVALID_INTEGER):
+			return "INVALID INPUT. INPUT ONLY VALID INTEGERS (0-9) AND OPERATORS (+, -, x, *, /).";
+		case(INVALID_INPUT_LEFT_PAREN):
+			return "INVALID INPUT. LEFT PAREN '(' MUST BE FOLLOWED BY AN INTEGER OR '-'.";
+		case(INVALID_INPUT_RIGHT_PAREN):
+			return "INVALID INPUT. RIGHT PAREN ')' MUST BE PRECEDED BY AN INTEGER.";
+		case(INVALID_INPUT_PARENTHESES_MISMATCH):
+			return "INVALID INPUT. PARENTHESIS SYMBOLS '(' AND ')' MUST MATCH.";
+		case(INVALID_INPUT_RADIX_POINT):
+			return "INVALID INPUT. RADIX POINT '.' MUST PRECEDE OR FOLLOW A NUMBER.";
+		case(INTEGER_TOO_LARGE):
+			return "INTEGER SOLUTION HAS TOO MANY DIGITS TO COMPUTE.";
+		case(DECIMAL_OUT_OF_RANGE):
+			return "DECIMAL VALUE IS OUT OF RANGE.";
+		case(DECIMAL_FRACTIONAL_POWER):
+			return "DECIMAL VALUES MAY ONLY BE RAISED TO WHOLE NUMBER POWERS.";
+		case(NUMBER_TOO_LONG):
+			return "NUMBER HAS TOO MANY CHARACTERS TO READ FROM A STREAM.";
+		case(UNDEFINED_VARIABLE):
+			return "VARIABLE HAS NOT BEEN DEFINED.";
+		case(CIRCULAR_DEFINITION):
+			return "DEFINITION WOULD DEPEND ON ITSELF.";
+		default:
+			return "UNKNOWN ERROR.";
+	}
+}
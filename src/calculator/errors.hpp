@@ -0,0 +1,56 @@
+//
+// ERRORS.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef ERRORS_HPP
+#define ERRORS_HPP
+
+namespace bocan {
+
+// error codes shared by the lexer, parser, evaluator and calculator.
+// the numeric values are printed to the user, so new codes are only ever appended.
+enum errors {
+	NO_ERROR = -1,
+	DIVIDE_BY_ZERO,
+	SOLVE_ERROR,
+	INTEGER_DIVIDE_REMAINDER,
+	INVALID_INPUT_INVALID_OPERATOR,
+	INVALID_INPUT_THREE_MINUS,
+	INVALID_INPUT_MINUS_LAST,
+	INVALID_INPUT_OPERATOR_FIRST,
+	INVALID_INPUT_OPERATOR_LAST,
+	INVALID_INPUT_DUAL_OPERATORS,
+	INVALID_INPUT_INVALID_INTEGER,
+	INVALID_INPUT_LEFT_PAREN,
+	INVALID_INPUT_RIGHT_PAREN,
+	INVALID_INPUT_PARENTHESES_MISMATCH,
+	INVALID_INPUT_RADIX_POINT,
+	INTEGER_TOO_LARGE,
+	DECIMAL_OUT_OF_RANGE,
+	DECIMAL_FRACTIONAL_POWER,
+	NUMBER_TOO_LONG,
+	UNDEFINED_VARIABLE,
+	CIRCULAR_DEFINITION
+};
+
+const char*	GetErrorMessage(int);
+
+} // NAMESPACE BOCAN
+
+#endif	// ERRORS_HPP
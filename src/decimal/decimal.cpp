@@ -0,0 +1,404 @@
+//
+// DECIMAL.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "decimal.hpp"
+
+using bocan::Decimal;
+
+namespace {
+
+// 10^0 through 10^38, every power of ten below 2^127
+const int MAX_POWER = 38;
+
+const __int128 INT128_MAX_VALUE = static_cast<__int128>(~static_cast<unsigned __int128>(0) >> 1);
+const __int128 INT128_MIN_VALUE = -INT128_MAX_VALUE - 1;
+
+const __int128* GetPowers() {
+	static __int128 powers[MAX_POWER + 1];
+	static bool filled = false;
+	if(!filled) {
+		powers[0] = 1;
+		for(int i = 1; i <= MAX_POWER; i++) { powers[i] = powers[i - 1] * 10; }
+		filled = true;
+	}
+	return powers;
+}
+
+///
+/// @brief divides two integers and rounds the quotient to a whole number with the given mode.
+/// @param[in] T is the dividend.
+/// @param[in] T is the divisor. it is not zero.
+/// @param[in] rounding_mode decides the direction of a quotient that is not whole.
+/// @return the rounded quotient.
+/// @todo
+///
+template<typename T>
+T RoundDivide(T dividend, T divisor, bocan::rounding_mode rounding) {
+
+	T quotient = dividend / divisor;
+	T remainder = dividend % divisor;
+
+	if(remainder == 0) { return quotient; }
+
+	T sign = (dividend < 0) != (divisor < 0) ? -1 : 1;
+	T rest = remainder < 0 ? -remainder : remainder;
+	T other = (divisor < 0 ? -divisor : divisor) - rest;
+
+	switch(rounding) {
+		case bocan::ROUND_DOWN:		return quotient;
+		case bocan::ROUND_UP:		return quotient + sign;
+		case bocan::ROUND_FLOOR:	return sign < 0 ? quotient - 1 : quotient;
+		case bocan::ROUND_CEILING:	return sign > 0 ? quotient + 1 : quotient;
+		case bocan::ROUND_HALF_UP:	return rest >= other ? quotient + sign : quotient;
+		default:
+			if(rest > other || (rest == other && (quotient & 1))) { return quotient + sign; }
+			return quotient;
+	}
+}
+
+} // NAMESPACE
+
+///
+/// @brief finds the rounding mode with the given name: half-even, half-up, down, up, floor or ceiling.
+/// @param[in] char pointer to the null terminated name.
+/// @param[out] rounding_mode pointer receiving the mode.
+/// @return 0 if the name is known, 1 if it is not.
+/// @todo
+///
+bool bocan::ParseRoundingMode(const char* name, rounding_mode* rounding) {
+
+	struct mode {
+		const char*		name;
+		rounding_mode	rounding;
+	};
+	const mode modes[] = {
+		{ "half-even", ROUND_HALF_EVEN },
+		{ "half-up", ROUND_HALF_UP },
+		{ "down", ROUND_DOWN },
+		{ "up", ROUND_UP },
+		{ "floor", ROUND_FLOOR },
+		{ "ceiling", ROUND_CEILING },
+	};
+
+	for(const mode& m : modes) {
+		if(std::strcmp(name, m.name) == 0) {
+			*rounding = m.rounding;
+			return 0;
+		}
+	}
+	return 1;
+}
+
+///
+/// @brief reads a numeric literal, such as 12, 12.345, .5 or 1.5e-3, and rounds it to the format's scale.
+/// @brief the sign is applied before rounding, so -2.1 rounds toward negative infinity with ROUND_FLOOR.
+/// @param[in] char pointer to the literal. it need not be null terminated.
+/// @param[in] size_t is the length of the literal.
+/// @param[in] boolean true if the literal is negated.
+/// @param[in] DecimalFormat reference to the scale and rounding mode.
+/// @param[out] Decimal pointer receiving the value.
+/// @return 0 if the literal was read, 1 if it is malformed or out of range.
+/// @todo
+///
+bool Decimal::Parse(const char* text, std::size_t len, bool negative, const DecimalFormat& format, Decimal* result) {
+
+	const __int128* powers = GetPowers();
+
+	// digits past 37 significant ones are dropped, remembering only whether any of them was nonzero
+	const __int128 limit = powers[MAX_POWER - 2];
+
+	__int128 mantissa = 0;
+	long places = 0;
+	long dropped = 0;
+	long exponent = 0;
+	bool sticky = false;
+	bool radix = false;
+	bool digits = false;
+	std::size_t i = 0;
+
+	for(; i < len; i++) {
+		char c = text[i];
+		if(c == '.' && !radix) {
+			radix = true;
+		} else if(c >= '0' && c <= '9') {
+			if(mantissa < limit) {
+				mantissa = mantissa * 10 + (c - '0');
+				if(radix) { places++; }
+			} else {
+				if(c != '0') { sticky = true; }
+				if(!radix) { dropped++; }
+			}
+			digits = true;
+		} else {
+			break;
+		}
+	}
+
+	if(!digits) { return 1; }
+
+	if(i < len && (text[i] == 'e' || text[i] == 'E')) {
+		bool negative_exponent = false;
+		i++;
+		if(i < len && (text[i] == '+' || text[i] == '-')) { negative_exponent = text[i++] == '-'; }
+		if(i == len) { return 1; }
+		for(; i < len && text[i] >= '0' && text[i] <= '9'; i++) {
+			if(exponent < 100000) { exponent = exponent * 10 + (text[i] - '0'); }
+		}
+		if(negative_exponent) { exponent = -exponent; }
+	}
+
+	if(i != len) { return 1; }
+
+	// a dropped nonzero digit becomes a 1 below every kept digit, which rounds the same way
+	if(sticky) {
+		mantissa = mantissa * 10 + 1;
+		places++;
+	}
+
+	if(negative) { mantissa = -mantissa; }
+
+	// the value is mantissa * 10^(exponent - places), counted in units of 10^-scale
+	long shift = format.scale + exponent - places + dropped;
+
+	if(shift >= 0) {
+		if(sticky) { return 1; }
+		if(mantissa != 0 && (shift > MAX_POWER || (negative ? -mantissa : mantissa) > INT128_MAX_VALUE / powers[shift])) { return 1; }
+		result->SetValue(mantissa * powers[shift]);
+	} else if(-shift > MAX_POWER) {
+		// far below the last place, any nonzero digit only decides which way to round
+		result->SetValue(RoundDivide<__int128>(mantissa != 0 ? (negative ? -1 : 1) : 0, powers[MAX_POWER], format.rounding));
+	} else {
+		result->SetValue(RoundDivide<__int128>(mantissa, powers[-shift], format.rounding));
+	}
+	return 0;
+}
+
+///
+/// @brief writes the value with exactly the given number of decimal places, as in -12.50.
+/// @param[in] integer is the scale the value was made with.
+/// @param[out] char pointer to a buffer of FORMAT_SIZE characters. no null terminator is written.
+/// @return the number of characters written.
+/// @todo
+///
+std::size_t Decimal::Format(int scale, char* buffer) const {
+
+	__int128 value = GetValue();
+	bool negative = value < 0;
+
+	// digits are written backwards from the end of a local buffer
+	char digits[FORMAT_SIZE];
+	std::size_t count = 0;
+	unsigned __int128 magnitude = negative ? static_cast<unsigned __int128>(0) - static_cast<unsigned __int128>(value)
+	                                       : static_cast<unsigned __int128>(value);
+
+	for(int place = 0; magnitude || place <= scale; place++) {
+		if(place == scale && scale > 0) { digits[count++] = '.'; }
+		digits[count++] = static_cast<char>('0' + static_cast<int>(magnitude % 10));
+		magnitude /= 10;
+	}
+
+	std::size_t len = 0;
+	if(negative) { buffer[len++] = '-'; }
+	while(count) { buffer[len++] = digits[--count]; }
+	return len;
+}
+
+///
+/// @brief changes the sign of the value.
+/// @return 0 on success, 1 if the result does not fit.
+/// @todo
+///
+bool Decimal::Negate() {
+	__int128 value = GetValue();
+	if(value == INT128_MIN_VALUE) { return 1; }
+	SetValue(-value);
+	return 0;
+}
+
+///
+/// @brief converts the value to a whole number, for use as a power.
+/// @param[in] DecimalFormat reference to the scale of the value.
+/// @param[out] long pointer receiving the whole number.
+/// @return 0 on success, 1 if the value has a fractional part or does not fit in a long.
+/// @todo
+///
+bool Decimal::ToWhole(const DecimalFormat& format, long* whole) const {
+
+	__int128 unit = GetPowers()[format.scale];
+	__int128 value = GetValue();
+
+	if(value % unit != 0) { return 1; }
+	value /= unit;
+
+	if(value > static_cast<__int128>(INT64_MAX) || value < static_cast<__int128>(INT64_MIN)) { return 1; }
+	*whole = static_cast<long>(value);
+	return 0;
+}
+
+///
+/// @brief adds two values exactly. 64 bit operands are added in 64 bits unless the sum overflows.
+/// @param[in] Decimal reference to the left operand.
+/// @param[in] Decimal reference to the right operand.
+/// @param[out] Decimal pointer receiving the sum.
+/// @return 0 on success, 1 if the sum does not fit.
+/// @todo
+///
+bool Decimal::Add(const Decimal& lhs, const Decimal& rhs, Decimal* result) {
+
+	std::int64_t small = 0;
+	if(!lhs.m_wide && !rhs.m_wide && !__builtin_add_overflow(lhs.m_small, rhs.m_small, &small)) {
+		result->m_small = small;
+		result->m_wide = false;
+		return 0;
+	}
+
+	__int128 sum = 0;
+	if(__builtin_add_overflow(lhs.GetValue(), rhs.GetValue(), &sum)) { return 1; }
+	result->SetValue(sum);
+	return 0;
+}
+
+///
+/// @brief subtracts one value from another exactly.
+/// @param[in] Decimal reference to the left operand.
+/// @param[in] Decimal reference to the right operand.
+/// @param[out] Decimal pointer receiving the difference.
+/// @return 0 on success, 1 if the difference does not fit.
+/// @todo
+///
+bool Decimal::Subtract(const Decimal& lhs, const Decimal& rhs, Decimal* result) {
+
+	std::int64_t small = 0;
+	if(!lhs.m_wide && !rhs.m_wide && !__builtin_sub_overflow(lhs.m_small, rhs.m_small, &small)) {
+		result->m_small = small;
+		result->m_wide = false;
+		return 0;
+	}
+
+	__int128 difference = 0;
+	if(__builtin_sub_overflow(lhs.GetValue(), rhs.GetValue(), &difference)) { return 1; }
+	result->SetValue(difference);
+	return 0;
+}
+
+///
+/// @brief multiplies two values. the product has twice the scale, so it is divided by 10^scale and rounded once.
+/// @param[in] Decimal reference to the left operand.
+/// @param[in] Decimal reference to the right operand.
+/// @param[in] DecimalFormat reference to the scale and rounding mode.
+/// @param[out] Decimal pointer receiving the product.
+/// @return 0 on success, 1 if the product does not fit.
+/// @todo
+///
+bool Decimal::Multiply(const Decimal& lhs, const Decimal& rhs, const DecimalFormat& format, Decimal* result) {
+
+	const __int128* powers = GetPowers();
+
+	std::int64_t small = 0;
+	if(!lhs.m_wide && !rhs.m_wide && !__builtin_mul_overflow(lhs.m_small, rhs.m_small, &small)) {
+		result->SetValue(RoundDivide<std::int64_t>(small, static_cast<std::int64_t>(powers[format.scale]), format.rounding));
+		return 0;
+	}
+
+	__int128 product = 0;
+	if(__builtin_mul_overflow(lhs.GetValue(), rhs.GetValue(), &product)) { return 1; }
+	result->SetValue(RoundDivide<__int128>(product, powers[format.scale], format.rounding));
+	return 0;
+}
+
+///
+/// @brief divides one value by another. the dividend is scaled up by 10^scale first and the quotient is rounded once.
+/// @param[in] Decimal reference to the dividend.
+/// @param[in] Decimal reference to the divisor. it is not zero.
+/// @param[in] DecimalFormat reference to the scale and rounding mode.
+/// @param[out] Decimal pointer receiving the quotient.
+/// @return 0 on success, 1 if the quotient does not fit.
+/// @todo
+///
+bool Decimal::Divide(const Decimal& lhs, const Decimal& rhs, const DecimalFormat& format, Decimal* result) {
+
+	const __int128* powers = GetPowers();
+
+	std::int64_t small = 0;
+	if(!lhs.m_wide && !rhs.m_wide && !__builtin_mul_overflow(lhs.m_small, static_cast<std::int64_t>(powers[format.scale]), &small)
+	   && !(small == INT64_MIN && rhs.m_small == -1)) {
+		result->SetValue(RoundDivide<std::int64_t>(small, rhs.m_small, format.rounding));
+		return 0;
+	}
+
+	__int128 dividend = 0;
+	if(__builtin_mul_overflow(lhs.GetValue(), powers[format.scale], &dividend)) { return 1; }
+	if(dividend == INT128_MIN_VALUE && rhs.GetValue() == -1) { return 1; }
+	result->SetValue(RoundDivide<__int128>(dividend, rhs.GetValue(), format.rounding));
+	return 0;
+}
+
+///
+/// @brief raises a value to a whole power by repeated squaring. every product is rounded, and a negative power
+/// @brief is the rounded reciprocal of the positive one.
+/// @param[in] Decimal reference to the base.
+/// @param[in] long is the power.
+/// @param[in] DecimalFormat reference to the scale and rounding mode.
+/// @param[out] Decimal pointer receiving the result.
+/// @return 0 on success, 1 if the result, or a step toward it, does not fit.
+/// @todo
+///
+bool Decimal::Power(const Decimal& base, long exponent, const DecimalFormat& format, Decimal* result) {
+
+	unsigned long remaining = exponent < 0 ? 0UL - static_cast<unsigned long>(exponent) : static_cast<unsigned long>(exponent);
+
+	Decimal power;
+	power.SetValue(GetPowers()[format.scale]);
+	Decimal square = base;
+
+	while(remaining) {
+		if(remaining & 1) {
+			if(Multiply(power, square, format, &power)) { return 1; }
+		}
+		remaining >>= 1;
+		if(remaining && Multiply(square, square, format, &square)) { return 1; }
+	}
+
+	if(exponent < 0) {
+		if(power.IsZero()) { return 1; }
+		Decimal one;
+		one.SetValue(GetPowers()[format.scale]);
+		return Divide(one, power, format, result);
+	}
+
+	*result = power;
+	return 0;
+}
+
+///
+/// @brief stores a value, in 64 bits if it fits.
+/// @param[in] __int128 is the count of 10^-scale units.
+/// @return
+/// @todo
+///
+void Decimal::SetValue(__int128 value) {
+	m_wide = value > static_cast<__int128>(INT64_MAX) || value < static_cast<__int128>(INT64_MIN);
+	m_small = m_wide ? 0 : static_cast<std::int64_t>(value);
+	m_large = m_wide ? value : 0;
+}
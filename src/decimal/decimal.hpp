@@ -0,0 +1,86 @@
+//
+// DECIMAL.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef DECIMAL_HPP
+#define DECIMAL_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bocan {
+
+// how a result that falls between two values of the last decimal place is rounded
+enum rounding_mode {
+	ROUND_HALF_EVEN,	// to the nearest, ties to an even last digit
+	ROUND_HALF_UP,		// to the nearest, ties away from zero
+	ROUND_DOWN,			// toward zero
+	ROUND_UP,			// away from zero
+	ROUND_FLOOR,		// toward negative infinity
+	ROUND_CEILING		// toward positive infinity
+};
+
+// every value of an expression solved in decimal mode has the same number of decimal places
+struct DecimalFormat {
+	int				scale = 2;
+	rounding_mode	rounding = ROUND_HALF_EVEN;
+};
+
+bool	ParseRoundingMode(const char*, rounding_mode*);
+
+// an exact decimal number held as an integer count of 10^-scale units, so 12.34 at scale 2 is 1234.
+// the count is a 64 bit integer and widens to 128 bits only when a result overflows 64 bits.
+// sums and differences are exact. products, quotients and literals with more decimal places than
+// the scale are rounded once, with the format's rounding mode. a function returns 1 if its result
+// does not fit in 128 bits.
+class Decimal {
+
+public:
+	static bool	Parse(const char*, std::size_t, bool, const DecimalFormat&, Decimal*);
+	std::size_t	Format(int, char*) const;
+
+	bool	IsZero() const { return m_wide ? m_large == 0 : m_small == 0; }
+	bool	IsWide() const { return m_wide; }
+	bool	Negate();
+	bool	ToWhole(const DecimalFormat&, long*) const;
+
+	static bool	Add(const Decimal&, const Decimal&, Decimal*);
+	static bool	Subtract(const Decimal&, const Decimal&, Decimal*);
+	static bool	Multiply(const Decimal&, const Decimal&, const DecimalFormat&, Decimal*);
+	static bool	Divide(const Decimal&, const Decimal&, const DecimalFormat&, Decimal*);
+	static bool	Power(const Decimal&, long, const DecimalFormat&, Decimal*);
+
+	// the most decimal places a format may have
+	static const int MAX_SCALE = 18;
+
+	// a formatted value, with its sign and radix point, always fits in this many characters
+	static const std::size_t FORMAT_SIZE = 48;
+
+private:
+	__int128	GetValue() const { return m_wide ? m_large : m_small; }
+	void		SetValue(__int128);
+
+	std::int64_t	m_small = 0;
+	__int128		m_large = 0;
+	bool			m_wide = false;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// DECIMAL_HPP
@@ -0,0 +1,589 @@
+//
+// EVALUATOR.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <cmath>
+
+#include "evaluator.hpp"
+#include "../grammar/grammar.hpp"
+
+using bocan::Evaluator;
+
+///
+/// @brief solves a parsed expression with longs.
+/// @param[in] Ast reference to the parsed expression.
+/// @param[out] long pointer receiving the solution.
+/// @return 0 if the expression was solved, 1 and sets the error code and position if it failed.
+/// @todo
+///
+bool Evaluator::Evaluate(const Ast& ast, long* result) {
+	return EvaluateNodes(ast, ast.integers, &m_integers, result);
+}
+
+///
+/// @brief solves a parsed expression with doubles.
+/// @param[in] Ast reference to the parsed expression.
+/// @param[out] double pointer receiving the solution.
+/// @return 0 if the expression was solved, 1 and sets the error code and position if it failed.
+/// @todo
+///
+bool Evaluator::Evaluate(const Ast& ast, double* result) {
+	return EvaluateNodes(ast, ast.floats, &m_floats, result);
+}
+
+///
+/// @brief solves a parsed expression with integers of any size. each number is read again from its literal,
+/// @brief so values too large for a long are exact.
+/// @param[in] Ast reference to the parsed expression.
+/// @param[in] char pointer to the expression the tree was parsed from.
+/// @param[out] BigInt pointer receiving the solution.
+/// @return 0 if the expression was solved, 1 and sets the error code and position if it failed.
+/// @todo
+///
+bool Evaluator::Evaluate(const Ast& ast, const char* expr, BigInt* result) {
+
+	m_error_code = NO_ERROR;
+	m_error_pos = 0;
+	m_modulus = false;
+
+	const std::size_t count = ast.nodes.size();
+	if(count == 0 || !ast.variables.empty()) {
+		m_error_code = SOLVE_ERROR;
+		return 1;
+	}
+
+	m_bigs.resize(count);
+	const Node* node = ast.nodes.data();
+
+	for(std::size_t i = 0; i < count; i++) {
+		switch(node[i].type) {
+			case NODE_NUMBER:
+				if(m_bigs[i].Parse(expr + node[i].pos, node[i].rhs)) {
+					m_error_code = INVALID_INPUT_INVALID_INTEGER;
+					m_error_pos = node[i].pos;
+					return 1;
+				}
+				break;
+			case NODE_NEGATE:
+				m_bigs[i] = m_bigs[node[i].lhs];
+				m_bigs[i].Negate();
+				break;
+			default:
+				if(PerformMathOperation(m_bigs[node[i].lhs], m_bigs[node[i].rhs], node[i].type, &m_bigs[i])) {
+					m_error_pos = node[i].pos;
+					return 1;
+				}
+				break;
+		}
+	}
+
+	std::swap(*result, m_bigs[count - 1]);
+	return 0;
+}
+
+///
+/// @brief solves a parsed expression with exact decimals of a fixed scale. each number is read again from
+/// @brief its literal and rounded to the scale.
+/// @param[in] Ast reference to the parsed expression.
+/// @param[in] char pointer to the expression the tree was parsed from.
+/// @param[in] DecimalFormat reference to the scale and rounding mode.
+/// @param[out] Decimal pointer receiving the solution.
+/// @return 0 if the expression was solved, 1 and sets the error code and position if it failed.
+/// @todo
+///
+bool Evaluator::Evaluate(const Ast& ast, const char* expr, const DecimalFormat& format, Decimal* result) {
+
+	m_error_code = NO_ERROR;
+	m_error_pos = 0;
+	m_modulus = false;
+
+	const std::size_t count = ast.nodes.size();
+	if(count == 0 || !ast.variables.empty() || format.scale < 0 || format.scale > Decimal::MAX_SCALE) {
+		m_error_code = SOLVE_ERROR;
+		return 1;
+	}
+
+	m_decimals.resize(count);
+	Decimal* value = m_decimals.data();
+	const Node* node = ast.nodes.data();
+
+	for(std::size_t i = 0; i < count; i++) {
+		switch(node[i].type) {
+			case NODE_NUMBER:
+				if(Decimal::Parse(expr + node[i].pos, node[i].rhs, false, format, &value[i])) {
+					m_error_code = DECIMAL_OUT_OF_RANGE;
+					m_error_pos = node[i].pos;
+					return 1;
+				}
+				break;
+			case NODE_NEGATE: {
+
+				// a negated literal is rounded as a negative value, not rounded and then negated
+				unsigned int operand = node[i].lhs;
+				bool negative = true;
+				while(node[operand].type == NODE_NEGATE) {
+					operand = node[operand].lhs;
+					negative = !negative;
+				}
+
+				bool err = node[operand].type == NODE_NUMBER
+					? Decimal::Parse(expr + node[operand].pos, node[operand].rhs, negative, format, &value[i])
+					: (value[i] = value[node[i].lhs]).Negate();
+				if(err) {
+					m_error_code = DECIMAL_OUT_OF_RANGE;
+					m_error_pos = node[i].pos;
+					return 1;
+				}
+				break;
+			}
+			default:
+				if(PerformMathOperation(value[node[i].lhs], value[node[i].rhs], node[i].type, format, &value[i])) {
+					m_error_pos = node[i].pos;
+					return 1;
+				}
+				break;
+		}
+	}
+
+	*result = value[count - 1];
+	return 0;
+}
+
+///
+/// @brief evaluates every node once, in order. children come before parents, so each operand is ready when it is needed.
+/// @param[in] Ast reference to the parsed expression.
+/// @param[in] vector reference to the constants of the expression.
+/// @param[out] vector pointer used to store the value of each node.
+/// @param[out] pointer receiving the value of the root node.
+/// @return 0 if the expression was solved, 1 on error.
+/// @todo
+///
+template<typename T>
+bool Evaluator::EvaluateNodes(const Ast& ast, const std::vector<T>& constants, std::vector<T>* values, T* result) {
+
+	m_error_code = NO_ERROR;
+	m_error_pos = 0;
+	m_modulus = false;
+
+	// variables have no value here, they are bound by a compiled Expression
+	const std::size_t count = ast.nodes.size();
+	if(count == 0 || !ast.variables.empty()) {
+		m_error_code = SOLVE_ERROR;
+		return 1;
+	}
+
+	values->resize(count);
+	T* value = values->data();
+	const Node* node = ast.nodes.data();
+
+	bool err = m_pool && m_pool->GetThreadCount() > 1 && count >= PARALLEL_THRESHOLD
+		? EvaluateParallel(node, count, constants.data(), value)
+		: EvaluateRange(node, constants.data(), value, 0, count);
+	if(err) { return 1; }
+
+	*result = value[count - 1];
+	return 0;
+}
+
+///
+/// @brief evaluates a run of nodes in order, stopping at the first error.
+/// @param[in] Node pointer to the nodes of the expression.
+/// @param[in] pointer to the constants of the expression.
+/// @param[out] pointer to the value of each node.
+/// @param[in] size_t index of the first node of the run.
+/// @param[in] size_t index one past the last node of the run.
+/// @return 0 if every node was solved, 1 on error.
+/// @todo
+///
+template<typename T>
+bool Evaluator::EvaluateRange(const Node* node, const T* constants, T* value, std::size_t first, std::size_t end) {
+	for(std::size_t i = first; i < end; i++) {
+		if(EvaluateNode(node, constants, value, i)) { return 1; }
+	}
+	return 0;
+}
+
+///
+/// @brief splits the nodes into runs, solves the runs as tasks on the pool, then solves the nodes they left in order.
+/// @brief the error reported is the one of the lowest node index, which is where solving in order would have stopped.
+/// @param[in] Node pointer to the nodes of the expression.
+/// @param[in] size_t is the number of nodes.
+/// @param[in] pointer to the constants of the expression.
+/// @param[out] pointer to the value of each node.
+/// @return 0 if every node was solved, 1 on error.
+/// @todo
+///
+template<typename T>
+bool Evaluator::EvaluateParallel(const Node* node, std::size_t count, const T* constants, T* value) {
+
+	const std::size_t slots = m_pool->GetThreadCount() * TASKS_PER_THREAD;
+	std::size_t size = (count + slots - 1) / slots;
+	if(size < MIN_TASK_SIZE) { size = MIN_TASK_SIZE; }
+	const std::size_t tasks = (count + size - 1) / size;
+
+	if(m_helpers.size() < tasks) { m_helpers.resize(tasks); }
+	m_waiting.resize(count);
+	unsigned char* waiting = m_waiting.data();
+
+	// fork. a task that fails lowers the first failed node, and runs after it are not solved at all
+	std::atomic<std::size_t> remaining(tasks);
+	std::atomic<std::size_t> first_failed(count);
+	for(std::size_t t = 0; t < tasks; t++) {
+		Evaluator* helper = &m_helpers[t];
+		std::size_t first = t * size;
+		std::size_t end = first + size < count ? first + size : count;
+		m_pool->Submit([helper, node, constants, value, waiting, first, end, &remaining, &first_failed] {
+			helper->EvaluateTask(node, constants, value, waiting, &first_failed, first, end);
+			remaining.fetch_sub(1, std::memory_order_release);
+		});
+	}
+
+	// join
+	m_pool->WaitUntil([&remaining] { return remaining.load(std::memory_order_acquire) == 0; });
+
+	std::size_t failed = count;
+	for(std::size_t t = 0; t < tasks; t++) {
+		const Evaluator& helper = m_helpers[t];
+		if(helper.m_modulus) { m_modulus = true; }
+		if(helper.m_error_code != NO_ERROR && helper.m_error_node < failed) {
+			failed = helper.m_error_node;
+			m_error_code = helper.m_error_code;
+			m_error_pos = helper.m_error_pos;
+		}
+	}
+
+	// the nodes left by the tasks, in order. none of them comes after a failed node
+	errors task_error = m_error_code;
+	m_error_code = NO_ERROR;
+
+	for(std::size_t t = 0; t < tasks; t++) {
+		for(unsigned int i : m_helpers[t].m_deferred) {
+			if(i > failed) { break; }
+			if(EvaluateNode(node, constants, value, i)) { return 1; }
+		}
+	}
+
+	m_error_code = task_error;
+	if(failed < count) { return 1; }
+	return 0;
+}
+
+///
+/// @brief solves the nodes of one run whose operands are known. a node that uses a value from before the run,
+/// @brief or a node of the run that is still waiting, is marked as waiting and left for the serial pass.
+/// @param[in] Node pointer to the nodes of the expression.
+/// @param[in] pointer to the constants of the expression.
+/// @param[out] pointer to the value of each node. only the nodes of the run are written.
+/// @param[out] unsigned char pointer to the waiting mark of each node. only the nodes of the run are written.
+/// @param[in,out] atomic pointer to the lowest failed node of every run so far. a run after it stops.
+/// @param[in] size_t index of the first node of the run.
+/// @param[in] size_t index one past the last node of the run.
+/// @return
+/// @todo
+///
+template<typename T>
+void Evaluator::EvaluateTask(const Node* node, const T* constants, T* value, unsigned char* waiting, std::atomic<std::size_t>* first_failed, std::size_t first, std::size_t end) {
+
+	m_error_code = NO_ERROR;
+	m_error_pos = 0;
+	m_error_node = 0;
+	m_modulus = false;
+	m_deferred.clear();
+
+	for(std::size_t i = first; i < end; i++) {
+
+		// no node after a failed node is ever used
+		if((i & (CHECK_INTERVAL - 1)) == 0 && first_failed->load(std::memory_order_relaxed) < first) { return; }
+
+		bool wait = false;
+		if(node[i].type != NODE_NUMBER) {
+			wait = node[i].lhs < first || waiting[node[i].lhs];
+			if(node[i].type != NODE_NEGATE) { wait = wait || node[i].rhs < first || waiting[node[i].rhs]; }
+		}
+
+		waiting[i] = wait;
+		if(wait) {
+			m_deferred.push_back(static_cast<unsigned int>(i));
+			continue;
+		}
+		if(EvaluateNode(node, constants, value, i)) {
+			std::size_t failed = first_failed->load(std::memory_order_relaxed);
+			while(i < failed && !first_failed->compare_exchange_weak(failed, i, std::memory_order_relaxed)) {}
+			return;
+		}
+	}
+}
+
+///
+/// @brief solves one node from the values of its operands.
+/// @param[in] Node pointer to the nodes of the expression.
+/// @param[in] pointer to the constants of the expression.
+/// @param[out] pointer to the value of each node.
+/// @param[in] size_t index of the node.
+/// @return 0 on success, 1 and sets the error code, position and node on error.
+/// @todo
+///
+template<typename T>
+bool Evaluator::EvaluateNode(const Node* node, const T* constants, T* value, std::size_t i) {
+	switch(node[i].type) {
+		case NODE_NUMBER:
+			value[i] = constants[node[i].lhs];
+			return 0;
+		case NODE_NEGATE:
+			value[i] = Negate(value[node[i].lhs]);
+			return 0;
+		default:
+			value[i] = PerformMathOperation(value[node[i].lhs], value[node[i].rhs], node[i].type);
+			if(m_error_code != NO_ERROR) {
+				m_error_pos = node[i].pos;
+				m_error_node = i;
+				return 1;
+			}
+			return 0;
+	}
+}
+
+///
+/// @brief changes the sign of an operand. the most negative long wraps around to itself.
+/// @param[in] long is the operand.
+/// @return the negated operand.
+/// @todo
+///
+long Evaluator::Negate(long operand) {
+	return bocan::WrapNegate(operand);
+}
+
+///
+/// @brief changes the sign of an operand.
+/// @param[in] double is the operand.
+/// @return the negated operand.
+/// @todo
+///
+double Evaluator::Negate(double operand) {
+	return -operand;
+}
+
+///
+/// @brief performs the specified math operation.
+/// @brief addition, subtraction and multiplication wrap around on overflow instead of being undefined.
+/// @param[in] long is the first (left) operand.
+/// @param[in] long is the next (right) operand.
+/// @param[in] char is the operator specifying which operation to execute.
+/// @return solution of the operation as a long (8 bytes).
+/// @todo
+///
+long Evaluator::PerformMathOperation(long operand1, long operand2, char oper) {
+	switch (oper) {
+		case '^': return std::pow(operand1, operand2);
+		case 'x':
+		case '*': return bocan::WrapMultiply(operand1, operand2);
+		case '/':
+
+			// check for a divide by zero error
+			if(operand2 == 0) {
+				m_error_code = DIVIDE_BY_ZERO;
+				return 0xFF;
+			}
+
+			// check for a division remainder
+			if((operand1 % operand2) > 0) {
+				m_modulus = true;
+			}
+
+			return operand1 / operand2;
+
+		case '+': return bocan::WrapAdd(operand1, operand2);
+		case '-': return bocan::WrapSubtract(operand1, operand2);
+		default:
+			m_error_code = INVALID_INPUT_INVALID_OPERATOR;
+			return 0xFF;
+	}
+}
+
+///
+/// @brief performs the specified math operation.
+/// @param[in] double is the first (left) operand.
+/// @param[in] double is the next (right) operand.
+/// @param[in] char is the operator specifying which operation to execute.
+/// @return solution of the operation as a double (8 bytes).
+/// @todo
+///
+double Evaluator::PerformMathOperation(double operand1, double operand2, char oper) {
+	switch (oper) {
+		case '^': return std::pow(operand1, operand2);
+		case 'x':
+		case '*': return operand1 * operand2;
+		case '/':
+
+			// check for a divide by zero error
+			if(operand2 == 0) {
+				m_error_code = DIVIDE_BY_ZERO;
+				return 0xFF;
+			}
+
+			return operand1 / operand2;
+
+		case '+': return operand1 + operand2;
+		case '-': return operand1 - operand2;
+		default:
+			m_error_code = INVALID_INPUT_INVALID_OPERATOR;
+			return 0xFF;
+	}
+}
+
+///
+/// @brief performs the specified math operation on integers of any size. division truncates toward zero,
+/// @brief and a remainder is flagged under the same rule as for longs.
+/// @param[in] BigInt reference to the first (left) operand.
+/// @param[in] BigInt reference to the next (right) operand.
+/// @param[in] char is the operator specifying which operation to execute.
+/// @param[out] BigInt pointer receiving the solution of the operation.
+/// @return 0 on success, 1 and sets the error code on error.
+/// @todo
+///
+bool Evaluator::PerformMathOperation(const BigInt& operand1, const BigInt& operand2, char oper, BigInt* result) {
+
+	bool remainder = false;
+
+	switch (oper) {
+		case '^': return Power(operand1, operand2, result);
+		case 'x':
+		case '*': BigInt::Multiply(operand1, operand2, result); return 0;
+		case '/':
+
+			if(BigInt::Divide(operand1, operand2, result, &remainder)) {
+				m_error_code = DIVIDE_BY_ZERO;
+				return 1;
+			}
+
+			// the long path only sees a remainder greater than zero, which needs a positive dividend
+			if(remainder && !operand1.IsNegative()) {
+				m_modulus = true;
+			}
+			return 0;
+
+		case '+': BigInt::Add(operand1, operand2, result); return 0;
+		case '-': BigInt::Subtract(operand1, operand2, result); return 0;
+		default:
+			m_error_code = INVALID_INPUT_INVALID_OPERATOR;
+			return 1;
+	}
+}
+
+///
+/// @brief raises an integer of any size to an integer power by repeated squaring.
+/// @brief a negative power is the truncated reciprocal, which is zero unless the base is 1 or -1.
+/// @param[in] BigInt reference to the base.
+/// @param[in] BigInt reference to the exponent.
+/// @param[out] BigInt pointer receiving the power.
+/// @return 0 on success, 1 and sets the error code if the power is undefined or has more than MAX_DIGITS digits.
+/// @todo
+///
+bool Evaluator::Power(const BigInt& base, const BigInt& exponent, BigInt* result) {
+
+	long small = 0;
+	bool unit = !base.ToLong(&small) && (small == 1 || small == -1);
+
+	// 0, 1 and -1 need no multiplication, whatever the size of the exponent
+	if(base.IsZero()) {
+		if(exponent.IsNegative()) {
+			m_error_code = DIVIDE_BY_ZERO;
+			return 1;
+		}
+		*result = BigInt(exponent.IsZero() ? 1 : 0);
+		return 0;
+	}
+	if(unit) {
+		*result = BigInt(small == -1 && exponent.IsOdd() ? -1 : 1);
+		return 0;
+	}
+	if(exponent.IsNegative()) {
+		*result = BigInt(0);
+		return 0;
+	}
+
+	long power = 0;
+	if(exponent.ToLong(&power) || static_cast<double>(power) * base.GetLog10() > static_cast<double>(MAX_DIGITS)) {
+		m_error_code = INTEGER_TOO_LARGE;
+		return 1;
+	}
+
+	BigInt::Power(base, static_cast<unsigned long>(power), result);
+	return 0;
+}
+
+///
+/// @brief performs the specified math operation on decimals. sums and differences are exact,
+/// @brief products and quotients are rounded once to the scale.
+/// @param[in] Decimal reference to the first (left) operand.
+/// @param[in] Decimal reference to the next (right) operand.
+/// @param[in] char is the operator specifying which operation to execute.
+/// @param[in] DecimalFormat reference to the scale and rounding mode.
+/// @param[out] Decimal pointer receiving the solution of the operation.
+/// @return 0 on success, 1 and sets the error code on error.
+/// @todo
+///
+bool Evaluator::PerformMathOperation(const Decimal& operand1, const Decimal& operand2, char oper, const DecimalFormat& format, Decimal* result) {
+
+	bool overflow = false;
+	long power = 0;
+
+	switch (oper) {
+		case '^':
+
+			if(operand2.ToWhole(format, &power)) {
+				m_error_code = DECIMAL_FRACTIONAL_POWER;
+				return 1;
+			}
+			if(operand1.IsZero() && power < 0) {
+				m_error_code = DIVIDE_BY_ZERO;
+				return 1;
+			}
+			overflow = Decimal::Power(operand1, power, format, result);
+			break;
+
+		case 'x':
+		case '*': overflow = Decimal::Multiply(operand1, operand2, format, result); break;
+		case '/':
+
+			// check for a divide by zero error
+			if(operand2.IsZero()) {
+				m_error_code = DIVIDE_BY_ZERO;
+				return 1;
+			}
+			overflow = Decimal::Divide(operand1, operand2, format, result);
+			break;
+
+		case '+': overflow = Decimal::Add(operand1, operand2, result); break;
+		case '-': overflow = Decimal::Subtract(operand1, operand2, result); break;
+		default:
+			m_error_code = INVALID_INPUT_INVALID_OPERATOR;
+			return 1;
+	}
+
+	if(overflow) {
+		m_error_code = DECIMAL_OUT_OF_RANGE;
+		return 1;
+	}
+	return 0;
+}
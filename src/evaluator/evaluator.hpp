@@ -0,0 +1,113 @@
+//
+// EVALUATOR.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef EVALUATOR_HPP
+#define EVALUATOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "../bigint/bigint.hpp"
+#include "../calculator/errors.hpp"
+#include "../decimal/decimal.hpp"
+#include "../parser/parser.hpp"
+#include "../thread_pool/thread_pool.hpp"
+
+namespace bocan {
+
+// solves a parsed expression one node at a time. with a thread pool, a large expression is split into runs of
+// nodes that are solved as fork-join tasks. a node that needs a value from an earlier run waits for a serial
+// pass over those nodes, in order, once every task has joined. each node is still solved once from the same
+// operands, so the solution, and the error reported, are exactly those of solving on one thread.
+class Evaluator {
+
+public:
+	bool	Evaluate(const Ast&, long*);
+	bool	Evaluate(const Ast&, double*);
+	bool	Evaluate(const Ast&, const char*, BigInt*);
+	bool	Evaluate(const Ast&, const char*, const DecimalFormat&, Decimal*);
+
+	errors		GetErrorCode() const { return m_error_code; }
+	std::size_t	GetErrorPosition() const { return m_error_pos; }
+	bool		GetModulusFlag() const { return m_modulus; }
+
+	void	SetPool(ThreadPool* pool) { m_pool = pool; }
+
+	// the value of any node after a successful Evaluate() of the matching type
+	long		GetIntegerValue(unsigned int node) const { return m_integers[node]; }
+	double		GetFloatValue(unsigned int node) const { return m_floats[node]; }
+
+	// powers of big integers with more digits than this are refused rather than computed
+	static const std::size_t MAX_DIGITS = 10000000;
+
+	// expressions with fewer nodes are always solved on the calling thread
+	static const std::size_t PARALLEL_THRESHOLD = 1 << 15;
+
+	// the fewest nodes solved by one task, and the tasks queued for each thread of the pool
+	static const std::size_t MIN_TASK_SIZE = 1 << 12;
+	static const std::size_t TASKS_PER_THREAD = 4;
+
+	// nodes a task solves between looks at whether an earlier task has failed. a power of two
+	static const std::size_t CHECK_INTERVAL = 1 << 10;
+
+private:
+	template<typename T>
+	bool	EvaluateNodes(const Ast&, const std::vector<T>&, std::vector<T>*, T*);
+	template<typename T>
+	bool	EvaluateRange(const Node*, const T*, T*, std::size_t, std::size_t);
+	template<typename T>
+	bool	EvaluateParallel(const Node*, std::size_t, const T*, T*);
+	template<typename T>
+	void	EvaluateTask(const Node*, const T*, T*, unsigned char*, std::atomic<std::size_t>*, std::size_t, std::size_t);
+	template<typename T>
+	bool	EvaluateNode(const Node*, const T*, T*, std::size_t);
+
+	static long		Negate(long);
+	static double	Negate(double);
+
+	long 	PerformMathOperation(long, long, char);
+	double  PerformMathOperation(double, double, char);
+	bool	PerformMathOperation(const BigInt&, const BigInt&, char, BigInt*);
+	bool	Power(const BigInt&, const BigInt&, BigInt*);
+	bool	PerformMathOperation(const Decimal&, const Decimal&, char, const DecimalFormat&, Decimal*);
+
+	// one value per node, kept between calls so the storage is reused
+	std::vector<long>	m_integers;
+	std::vector<double>	m_floats;
+	std::vector<BigInt>	m_bigs;
+	std::vector<Decimal>	m_decimals;
+
+	errors		m_error_code = NO_ERROR;
+	std::size_t	m_error_pos = 0;
+	std::size_t	m_error_node = 0;
+	bool		m_modulus = false;
+
+	// optional fork-join. each task solves its run of nodes with its own helper, which keeps the task's
+	// error and the nodes it left for the serial pass
+	ThreadPool*					m_pool = nullptr;
+	std::vector<Evaluator>		m_helpers;
+	std::vector<unsigned int>	m_deferred;
+	std::vector<unsigned char>	m_waiting;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// EVALUATOR_HPP
@@ -0,0 +1,466 @@
+//
+// EXPRESSION.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "expression.hpp"
+#include "../lexer/lexer.hpp"
+#include "../evaluator/evaluator.hpp"
+
+using bocan::Expression;
+
+///
+/// @brief checks and parses an expression that may contain variables, then lowers it to a program over value slots.
+/// @brief the text is copied, so it need not outlive the call.
+/// @param[in] char pointer to the expression.
+/// @param[in] size_t is the length of the expression.
+/// @param[out] Solution pointer receiving the number type, or the error code and position.
+/// @return 0 if the expression was compiled, 1 if it failed.
+/// @todo
+///
+bool Expression::Compile(const char* expr, std::size_t size, Solution* solution) {
+
+	*solution = Solution();
+	m_compiled = false;
+	m_text.assign(expr, size);
+	m_names.clear();
+	m_program.clear();
+	m_slots.clear();
+	m_integers.clear();
+	m_integral = false;
+	m_calls = 0;
+	m_native.Release();
+	m_native_integer.Release();
+
+	Lexer lexer;
+	Parser parser;
+	std::vector<Token> tokens;
+
+	if(lexer.Tokenize(m_text.data(), m_text.size(), &tokens, true)) {
+		solution->error_code = lexer.GetErrorCode();
+		solution->error_pos = lexer.GetErrorPosition();
+		return 1;
+	}
+
+	solution->floating = lexer.IsFloating();
+
+	if(parser.Parse(m_text.data(), tokens, solution->floating, &m_ast)) {
+		solution->error_code = parser.GetErrorCode();
+		solution->error_pos = parser.GetErrorPosition();
+		return 1;
+	}
+
+	for(const Token& name : m_ast.variables) {
+		m_names.emplace_back(m_text, name.pos, name.len);
+	}
+
+	if(m_names.empty()) {
+
+		// nothing can change between calls, so keep the solution (or its error)
+		Evaluator evaluator;
+		m_constant = *solution;
+
+		bool err = m_constant.floating ? evaluator.Evaluate(m_ast, &m_constant.real)
+		                               : evaluator.Evaluate(m_ast, &m_constant.integer);
+		if(err) {
+			m_constant.error_code = evaluator.GetErrorCode();
+			m_constant.error_pos = evaluator.GetErrorPosition();
+		}
+		m_constant.modulus = evaluator.GetModulusFlag();
+	} else {
+		Lower();
+	}
+
+	m_compiled = true;
+	return 0;
+}
+
+///
+/// @brief solves the compiled expression with the given values bound to its variables.
+/// @param[in] double pointer to one value per variable, in the order of GetVariableName(). may be null if there are none.
+/// @param[out] Solution pointer receiving the solution or the error. error positions refer to the compiled text.
+/// @return 0 if the expression was solved, 1 if it failed.
+/// @todo
+///
+bool Expression::Evaluate(const double* values, Solution* solution) {
+
+	if(!m_compiled || (!values && !m_names.empty())) {
+		*solution = Solution();
+		solution->error_code = SOLVE_ERROR;
+		return 1;
+	}
+
+	if(m_names.empty()) {
+		*solution = m_constant;
+		return m_constant.error_code != NO_ERROR;
+	}
+
+	*solution = Solution();
+	solution->floating = true;
+
+	double* slot = m_slots.data();
+	for(std::size_t i = 0; i < m_names.size(); i++) {
+		slot[m_first_variable + i] = values[i];
+	}
+
+	if(m_jit && !m_native.IsCompiled() && ++m_calls >= JIT_THRESHOLD) { CompileNative(); }
+
+	if(m_native.IsCompiled()) {
+		unsigned int failed = m_native.Run(slot);
+		if(failed) {
+			solution->error_code = DIVIDE_BY_ZERO;
+			solution->error_pos = m_program[failed - 1].pos;
+			return 1;
+		}
+		solution->real = slot[m_result];
+		return 0;
+	}
+
+	for(const instruction& step : m_program) {
+
+		double lhs = slot[step.lhs];
+		double rhs = slot[step.rhs];
+
+		switch(step.type) {
+			case NODE_ADD:		slot[step.dst] = lhs + rhs; break;
+			case NODE_SUBTRACT:	slot[step.dst] = lhs - rhs; break;
+			case NODE_MULTIPLY:	slot[step.dst] = lhs * rhs; break;
+			case NODE_NEGATE:	slot[step.dst] = -lhs; break;
+			case NODE_POWER:	slot[step.dst] = std::pow(lhs, rhs); break;
+			default:
+
+				// check for a divide by zero error
+				if(rhs == 0) {
+					solution->error_code = DIVIDE_BY_ZERO;
+					solution->error_pos = step.pos;
+					return 1;
+				}
+				slot[step.dst] = lhs / rhs;
+				break;
+		}
+	}
+
+	solution->real = slot[m_result];
+	return 0;
+}
+
+///
+/// @brief solves an integral expression exactly, with the given longs bound to its variables.
+/// @brief addition, subtraction and multiplication wrap around on overflow, as they do for integer expressions.
+/// @param[in] long pointer to one value per variable, in the order of GetVariableName(). may be null if there are none.
+/// @param[out] Solution pointer receiving the solution or the error.
+/// @return 0 if the expression was solved, 1 if it failed or is not integral.
+/// @todo
+///
+bool Expression::Evaluate(const long* values, Solution* solution) {
+
+	if(m_names.empty() && m_compiled) {
+		*solution = m_constant;
+		return m_constant.error_code != NO_ERROR;
+	}
+
+	*solution = Solution();
+
+	if(!m_compiled || !m_integral || !values) {
+		solution->error_code = SOLVE_ERROR;
+		return 1;
+	}
+
+	long* slot = m_integers.data();
+	for(std::size_t i = 0; i < m_names.size(); i++) {
+		slot[m_first_variable + i] = values[i];
+	}
+
+	if(m_jit && !m_native_integer.IsCompiled() && ++m_calls >= JIT_THRESHOLD) { CompileNative(); }
+
+	if(m_native_integer.IsCompiled()) {
+		m_native_integer.Run(slot);
+		solution->integer = slot[m_result];
+		return 0;
+	}
+
+	for(const instruction& step : m_program) {
+
+		unsigned long lhs = static_cast<unsigned long>(slot[step.lhs]);
+		unsigned long rhs = static_cast<unsigned long>(slot[step.rhs]);
+
+		switch(step.type) {
+			case NODE_ADD:		slot[step.dst] = static_cast<long>(lhs + rhs); break;
+			case NODE_SUBTRACT:	slot[step.dst] = static_cast<long>(lhs - rhs); break;
+			case NODE_MULTIPLY:	slot[step.dst] = static_cast<long>(lhs * rhs); break;
+			default:			slot[step.dst] = static_cast<long>(0 - lhs); break;
+		}
+	}
+
+	solution->integer = slot[m_result];
+	return 0;
+}
+
+///
+/// @brief solves the compiled expression for every row of a struct-of-arrays input.
+/// @param[in] double pointer pointer to one column per variable, in the order of GetVariableName(). may be null if there are none.
+/// @param[in] size_t is the number of rows in every column.
+/// @param[out] double pointer receiving one solution per row. it must not overlap the columns.
+/// @param[out] Solution pointer receiving the error. on error, error_row is the first failing row and the rows before it are solved.
+/// @return 0 if every row was solved, 1 if a row failed.
+/// @todo
+///
+bool Expression::Evaluate(const double* const* columns, std::size_t rows, double* results, Solution* solution) {
+	return EvaluateColumns(columns, rows, results, solution);
+}
+
+///
+/// @brief solves the compiled expression for every row of a struct-of-arrays input of longs.
+/// @brief variables are always solved with doubles, so each block of a column is converted first.
+/// @param[in] long pointer pointer to one column per variable, in the order of GetVariableName(). may be null if there are none.
+/// @param[in] size_t is the number of rows in every column.
+/// @param[out] double pointer receiving one solution per row.
+/// @param[out] Solution pointer receiving the error. on error, error_row is the first failing row and the rows before it are solved.
+/// @return 0 if every row was solved, 1 if a row failed.
+/// @todo
+///
+bool Expression::Evaluate(const long* const* columns, std::size_t rows, double* results, Solution* solution) {
+	return EvaluateColumns(columns, rows, results, solution);
+}
+
+///
+/// @brief runs the program one step at a time over blocks of rows, with each step applied to a whole block by a kernel.
+/// @param[in] pointer pointer to one column per variable.
+/// @param[in] size_t is the number of rows in every column.
+/// @param[out] double pointer receiving one solution per row.
+/// @param[out] Solution pointer receiving the error.
+/// @return 0 if every row was solved, 1 if a row failed.
+/// @todo
+///
+template<typename T>
+bool Expression::EvaluateColumns(const T* const* columns, std::size_t rows, double* results, Solution* solution) {
+
+	*solution = Solution();
+
+	if(!m_compiled || (!columns && !m_names.empty())) {
+		solution->error_code = SOLVE_ERROR;
+		return 1;
+	}
+
+	// every row has the same solution
+	if(m_names.empty()) {
+		*solution = m_constant;
+		if(m_constant.error_code != NO_ERROR) { return 1; }
+		std::fill(results, results + rows, m_constant.floating ? m_constant.real : static_cast<double>(m_constant.integer));
+		return 0;
+	}
+
+	solution->floating = true;
+
+	const Kernels& kernels = m_kernels ? *m_kernels : GetKernels();
+	double* block = m_block.data();
+	const double** operand = m_operands.data();
+
+	for(std::size_t row = 0; row < rows; row += BLOCK_SIZE) {
+
+		const std::size_t n = rows - row < BLOCK_SIZE ? rows - row : BLOCK_SIZE;
+
+		for(std::size_t i = 0; i < m_names.size(); i++) {
+			std::size_t slot = m_first_variable + i;
+			operand[slot] = BindColumn(columns[i] + row, n, block + slot * BLOCK_SIZE, kernels);
+		}
+
+		for(const instruction& step : m_program) {
+
+			// the last step writes straight to the results
+			double* dst = step.dst == m_result ? results + row : block + step.dst * BLOCK_SIZE;
+			const double* lhs = operand[step.lhs];
+			const double* rhs = operand[step.rhs];
+
+			switch(step.type) {
+				case NODE_ADD:		kernels.add(lhs, rhs, dst, n); break;
+				case NODE_SUBTRACT:	kernels.subtract(lhs, rhs, dst, n); break;
+				case NODE_MULTIPLY:	kernels.multiply(lhs, rhs, dst, n); break;
+				case NODE_NEGATE:	kernels.negate(lhs, dst, n); break;
+				case NODE_POWER:	kernels.power(lhs, rhs, dst, n); break;
+				default: {
+					std::size_t solved = kernels.divide(lhs, rhs, dst, n);
+					if(solved != n) {
+						solution->error_code = DIVIDE_BY_ZERO;
+						solution->error_pos = step.pos;
+						solution->error_row = row + solved;
+						return 1;
+					}
+					break;
+				}
+			}
+			operand[step.dst] = dst;
+		}
+
+		// an expression of a single variable has no steps
+		if(operand[m_result] != results + row) {
+			std::memcpy(results + row, operand[m_result], n * sizeof(double));
+		}
+	}
+
+	return 0;
+}
+
+///
+/// @brief points a variable at its block of a double column. the values are used in place.
+/// @param[in] double pointer to the first row of the block.
+/// @param[in] size_t is the number of rows in the block.
+/// @param[in] double pointer to the variable's scratch block, unused.
+/// @param[in] Kernels reference, unused.
+/// @return the column itself.
+/// @todo
+///
+const double* Expression::BindColumn(const double* column, std::size_t, double*, const Kernels&) {
+	return column;
+}
+
+///
+/// @brief converts a block of a long column to doubles in the variable's scratch block.
+/// @param[in] long pointer to the first row of the block.
+/// @param[in] size_t is the number of rows in the block.
+/// @param[out] double pointer to the variable's scratch block.
+/// @param[in] Kernels reference supplying the conversion.
+/// @return the scratch block.
+/// @todo
+///
+const double* Expression::BindColumn(const long* column, std::size_t n, double* scratch, const Kernels& kernels) {
+	kernels.convert(column, scratch, n);
+	return scratch;
+}
+
+///
+/// @brief finds the position of a variable in the values passed to Evaluate().
+/// @param[in] string_view is the name of the variable.
+/// @return the index of the variable, or -1 if the expression does not use it.
+/// @todo
+///
+int Expression::GetVariableIndex(std::string_view name) const {
+	for(std::size_t i = 0; i < m_names.size(); i++) {
+		if(m_names[i] == name) { return static_cast<int>(i); }
+	}
+	return -1;
+}
+
+///
+/// @brief turns the syntax tree into a flat program. numbers and variables become slots instead of steps,
+/// @brief and raising to a constant power of 2 becomes a multiplication.
+/// @return
+/// @todo
+///
+void Expression::Lower() {
+
+	const std::vector<Node>& nodes = m_ast.nodes;
+	const unsigned int constants = static_cast<unsigned int>(m_ast.floats.size());
+
+	m_first_variable = constants;
+	m_slots.assign(m_ast.floats.begin(), m_ast.floats.end());
+	m_slots.resize(constants + m_names.size());
+
+	// the slot holding the value of each node
+	std::vector<unsigned int> slot(nodes.size());
+
+	for(std::size_t i = 0; i < nodes.size(); i++) {
+
+		const Node& node = nodes[i];
+
+		switch(node.type) {
+			case NODE_NUMBER:
+				slot[i] = node.lhs;
+				continue;
+			case NODE_VARIABLE:
+				slot[i] = m_first_variable + node.lhs;
+				continue;
+			default:
+				break;
+		}
+
+		instruction step = { node.type, static_cast<unsigned int>(m_slots.size()), slot[node.lhs], 0, node.pos };
+		if(node.type != NODE_NEGATE) { step.rhs = slot[node.rhs]; }
+
+		// x^2 is exactly x*x, without the call to pow
+		if(step.type == NODE_POWER && step.rhs < constants && m_slots[step.rhs] == 2) {
+			step.type = NODE_MULTIPLY;
+			step.rhs = step.lhs;
+		}
+
+		slot[i] = step.dst;
+		m_slots.push_back(0);
+		m_program.push_back(step);
+	}
+
+	m_result = slot[nodes.size() - 1];
+
+	// whole number literals and no division or power can also be solved with longs
+	m_integral = true;
+	for(const Node& node : nodes) {
+		if(node.type == NODE_DIVIDE || node.type == NODE_POWER) { m_integral = false; }
+		if(node.type != NODE_NUMBER) { continue; }
+		if(node.rhs == 0 || node.pos + node.rhs > m_text.size()) { m_integral = false; continue; }
+		for(unsigned int i = 0; i < node.rhs; i++) {
+			if(m_text[node.pos + i] < '0' || m_text[node.pos + i] > '9') { m_integral = false; }
+		}
+	}
+
+	if(m_integral) {
+		m_integers.assign(m_slots.size(), 0);
+		for(const Node& node : nodes) {
+			if(node.type == NODE_NUMBER) { m_integers[node.lhs] = bocan::ParseInteger(m_text.data() + node.pos, node.rhs); }
+		}
+	}
+
+	// the constants are spread over a whole block once, so kernels can read them like any other column
+	m_block.assign(m_slots.size() * BLOCK_SIZE, 0);
+	m_operands.assign(m_slots.size(), nullptr);
+
+	for(unsigned int i = 0; i < constants; i++) {
+		std::fill(&m_block[i * BLOCK_SIZE], &m_block[(i + 1) * BLOCK_SIZE], m_slots[i]);
+		m_operands[i] = &m_block[i * BLOCK_SIZE];
+	}
+}
+
+///
+/// @brief compiles the program to native code, for doubles and, if it is integral, for longs.
+/// @brief if it cannot be compiled the expression stops trying and is interpreted.
+/// @return
+/// @todo
+///
+void Expression::CompileNative() {
+
+	std::vector<JitStep> steps;
+	steps.reserve(m_program.size());
+	for(const instruction& step : m_program) {
+		steps.push_back(JitStep{ step.type, step.dst, step.lhs, step.rhs });
+	}
+
+	bool err = m_native.Compile(steps.data(), steps.size(), false);
+	if(!err && m_integral) { err = m_native_integer.Compile(steps.data(), steps.size(), true); }
+
+	if(err) {
+		m_native.Release();
+		m_native_integer.Release();
+		m_jit = false;
+	}
+}
@@ -0,0 +1,121 @@
+//
+// EXPRESSION.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef EXPRESSION_HPP
+#define EXPRESSION_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../parser/parser.hpp"
+#include "../solver/solver.hpp"
+#include "../kernels/kernels.hpp"
+#include "../jit/jit.hpp"
+
+namespace bocan {
+
+// an expression that is checked and parsed once, then solved any number of times.
+// names made of letters are free variables, listed in order of first use. solving
+// binds one value per variable and does no parsing and no allocation.
+// whole columns of inputs can be solved at once with SIMD kernels, one operator at a time over blocks of rows.
+// one expression must not be solved by two threads at once, copy it instead.
+// with SetJit(), an expression solved one row at a time JIT_THRESHOLD times is compiled to native code, and
+// interpreted as before if that is not possible. a copy compiles its own code once it is solved again.
+class Expression {
+
+public:
+	bool	Compile(const char*, std::size_t, Solution*);
+	bool	Evaluate(const double*, Solution*);
+	bool	Evaluate(const long*, Solution*);
+	bool	Evaluate(const double* const*, std::size_t, double*, Solution*);
+	bool	Evaluate(const long* const*, std::size_t, double*, Solution*);
+
+	void	SetKernels(const Kernels& kernels) { m_kernels = &kernels; }
+	void	SetJit(bool jit) { m_jit = jit; }
+
+	bool	IsNative() const { return m_native.IsCompiled(); }
+
+	std::size_t			GetVariableCount() const { return m_names.size(); }
+	const std::string&	GetVariableName(std::size_t index) const { return m_names[index]; }
+	int					GetVariableIndex(std::string_view) const;
+
+	// true if the program only adds, subtracts, multiplies and negates whole numbers,
+	// so it can be solved exactly with longs when every variable is bound to a long
+	bool	IsIntegral() const { return m_integral; }
+
+	// solves of one row before an expression is compiled to native code
+	static const unsigned long JIT_THRESHOLD = 1000;
+
+private:
+
+	// one step of the compiled program: slot[dst] = slot[lhs] op slot[rhs].
+	// the slots hold the constants, then the variables, then one temporary per step.
+	struct instruction {
+		node_type		type;
+		unsigned int	dst;
+		unsigned int	lhs;
+		unsigned int	rhs;
+		unsigned int	pos;
+	};
+
+	void	Lower();
+	void	CompileNative();
+
+	template<typename T>
+	bool	EvaluateColumns(const T* const*, std::size_t, double*, Solution*);
+
+	static const double*	BindColumn(const double*, std::size_t, double*, const Kernels&);
+	static const double*	BindColumn(const long*, std::size_t, double*, const Kernels&);
+
+	// rows solved per pass over the program. a block of every slot stays in the L1 and L2 caches
+	static const std::size_t BLOCK_SIZE = 512;
+
+	std::string					m_text;
+	std::vector<std::string>	m_names;
+	Ast							m_ast;
+
+	std::vector<instruction>	m_program;
+	std::vector<double>			m_slots;
+	std::vector<long>			m_integers;
+	bool						m_integral = false;
+	unsigned int				m_first_variable = 0;
+	unsigned int				m_result = 0;
+
+	// column scratch: BLOCK_SIZE values per slot, and where each slot's block currently is
+	std::vector<double>			m_block;
+	std::vector<const double*>	m_operands;
+	const Kernels*				m_kernels = nullptr;
+
+	// optional native code, one function for doubles and one for an integral program of longs
+	bool			m_jit = false;
+	unsigned long	m_calls = 0;
+	Jit				m_native;
+	Jit				m_native_integer;
+
+	// an expression without variables is solved once, when it is compiled
+	Solution	m_constant;
+	bool		m_compiled = false;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// EXPRESSION_HPP
@@ -0,0 +1,358 @@
+//
+// GRAMMAR.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++20
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef GRAMMAR_HPP
+#define GRAMMAR_HPP
+
+#include <cstddef>
+
+#include "../calculator/errors.hpp"
+
+namespace bocan {
+
+// the tokens and rules of the expression language, and the integer arithmetic, shared by the lexer, the parser
+// and the evaluator at run time and by the constant solver in src/libcalc/constant.hpp. everything here is
+// constexpr, so a constant expression is checked, parsed and solved by the same code as any other.
+
+enum token_type : unsigned char {
+	TOKEN_NONE,
+	TOKEN_NUMBER,
+	TOKEN_VARIABLE,
+	TOKEN_PLUS,
+	TOKEN_MINUS,
+	TOKEN_MULTIPLY,
+	TOKEN_DIVIDE,
+	TOKEN_POWER,
+	TOKEN_LEFT_PAREN,
+	TOKEN_RIGHT_PAREN
+};
+
+// parentheses nested deeper than this are a SOLVE_ERROR, for the parser and the constant solver alike
+const int MAX_DEPTH = 10000;
+
+// a token refers back into the expression text by position, the text is never copied.
+// implicit multiplication tokens have a length of zero.
+struct Token {
+	token_type		type;
+	unsigned int	pos;
+	unsigned int	len;
+};
+
+///
+/// @brief checks if the token is an arithmetic operator.
+/// @param[in] token_type is the token being checked.
+/// @return boolean true if the token is '+', '-', 'x', '*', '/' or '^'.
+/// @todo
+///
+constexpr bool IsOperator(token_type type) {
+	switch(type) {
+		case TOKEN_PLUS:
+		case TOKEN_MINUS:
+		case TOKEN_MULTIPLY:
+		case TOKEN_DIVIDE:
+		case TOKEN_POWER:
+			return true;
+		default:
+			return false;
+	}
+}
+
+///
+/// @brief checks if the token is a number or a variable.
+/// @param[in] token_type is the token being checked.
+/// @return boolean true if the token is an operand.
+/// @todo
+///
+constexpr bool IsOperand(token_type type) {
+	return type == TOKEN_NUMBER || type == TOKEN_VARIABLE;
+}
+
+///
+/// @brief checks if the character may be part of a variable name.
+/// @param[in] char is the character being checked.
+/// @return boolean true for 'a'-'z', 'A'-'Z' and '_'.
+/// @todo
+///
+constexpr bool IsLetter(char c) {
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+///
+/// @brief finds the token of a single character operator or parenthesis. 'x' is left to the caller,
+/// @brief since it is the start of a variable name when variables are accepted.
+/// @param[in] char is the character.
+/// @return token_type of the character, or TOKEN_NONE if it is not an operator or parenthesis.
+/// @todo
+///
+constexpr token_type GetSymbol(char c) {
+	switch(c) {
+		case '+':	return TOKEN_PLUS;
+		case '-':	return TOKEN_MINUS;
+		case '*':	return TOKEN_MULTIPLY;
+		case '/':	return TOKEN_DIVIDE;
+		case '^':	return TOKEN_POWER;
+		case '(':	return TOKEN_LEFT_PAREN;
+		case ')':	return TOKEN_RIGHT_PAREN;
+		default:	return TOKEN_NONE;
+	}
+}
+
+///
+/// @brief checks if the operator makes the whole expression solve with doubles, to handle any possible float answers.
+/// @param[in] token_type is the operator.
+/// @return boolean true for '/' and '^'.
+/// @todo
+///
+constexpr bool IsFloatingOperator(token_type type) {
+	return type == TOKEN_DIVIDE || type == TOKEN_POWER;
+}
+
+///
+/// @brief checks if an implicit multiplication belongs between two tokens, as in 2a, 2(3) or (a)(b).
+/// @param[in] token_type of the previous token.
+/// @param[in] token_type of the next token.
+/// @return boolean true if a multiplication goes before the next token.
+/// @todo
+///
+constexpr bool IsImplicitMultiply(token_type prev, token_type next) {
+	switch(next) {
+		case TOKEN_NUMBER:		return prev == TOKEN_RIGHT_PAREN;
+		case TOKEN_VARIABLE:	return prev == TOKEN_NUMBER || prev == TOKEN_RIGHT_PAREN;
+		case TOKEN_LEFT_PAREN:	return IsOperand(prev) || prev == TOKEN_RIGHT_PAREN;
+		default:				return false;
+	}
+}
+
+///
+/// @brief returns the binding strength of a binary operator.
+/// @param[in] token_type is the operator.
+/// @return 3 for '^', 2 for multiplication and division, 1 for addition and subtraction, 0 if not a binary operator.
+/// @todo
+///
+constexpr int GetPrecedence(token_type type) {
+	switch(type) {
+		case TOKEN_POWER:		return 3;
+		case TOKEN_MULTIPLY:
+		case TOKEN_DIVIDE:		return 2;
+		case TOKEN_PLUS:
+		case TOKEN_MINUS:		return 1;
+		default:				return 0;
+	}
+}
+
+///
+/// @brief scans a number from its first digit or radix point, allowing a single radix point and an exponent, as in 1.5e-3.
+/// @brief an 'e' without digits after it is not part of the number.
+/// @param[in] char pointer to the first character of the expression.
+/// @param[in] size_t is the length of the expression in bytes.
+/// @param[in,out] size_t pointer to the position of the number, receiving the position after it, or of the error.
+/// @param[out] boolean pointer set true if the number has a radix point or an exponent, and left unchanged otherwise.
+/// @return NO_ERROR, or INVALID_INPUT_RADIX_POINT for a second radix point or a radix point without digits.
+/// @todo
+///
+constexpr errors ScanNumber(const char* expr, std::size_t size, std::size_t* next, bool* floating) {
+
+	std::size_t start = *next;
+	std::size_t i = start;
+	bool radix = false;
+	bool digits = false;
+
+	for(; i < size; i++) {
+		if(expr[i] >= '0' && expr[i] <= '9') {
+			digits = true;
+		} else if(expr[i] == '.') {
+			if(radix) {
+				*next = i;
+				return INVALID_INPUT_RADIX_POINT;
+			}
+			radix = true;
+		} else {
+			break;
+		}
+	}
+
+	// check if a '.' was passed without a number around it
+	if(!digits) { return INVALID_INPUT_RADIX_POINT; }
+
+	bool exponent = false;
+	if(i < size && (expr[i] == 'e' || expr[i] == 'E')) {
+		std::size_t j = i + 1;
+		if(j < size && (expr[j] == '+' || expr[j] == '-')) { j++; }
+		if(j < size && expr[j] >= '0' && expr[j] <= '9') {
+			for(i = j; i < size && expr[i] >= '0' && expr[i] <= '9'; i++) {}
+			exponent = true;
+		}
+	}
+
+	if(radix || exponent) { *floating = true; }
+	*next = i;
+	return NO_ERROR;
+}
+
+///
+/// @brief converts the digits of an integer number to a long. a number too large for a long wraps around.
+/// @param[in] char pointer to the first digit.
+/// @param[in] size_t is the number of digits.
+/// @return long (8 bytes) representing the number.
+/// @todo
+///
+constexpr long ParseInteger(const char* digits, std::size_t len) {
+
+	unsigned long op = 0;
+
+	for(std::size_t i = 0; i < len; i++) {
+		op = op * 10 + static_cast<unsigned long>(digits[i] - '0');
+	}
+	return static_cast<long>(op);
+}
+
+// long addition, subtraction, multiplication and negation wrap around on overflow instead of being undefined.
+constexpr long WrapAdd(long a, long b) { return static_cast<long>(static_cast<unsigned long>(a) + static_cast<unsigned long>(b)); }
+constexpr long WrapSubtract(long a, long b) { return static_cast<long>(static_cast<unsigned long>(a) - static_cast<unsigned long>(b)); }
+constexpr long WrapMultiply(long a, long b) { return static_cast<long>(static_cast<unsigned long>(a) * static_cast<unsigned long>(b)); }
+constexpr long WrapNegate(long a) { return static_cast<long>(0UL - static_cast<unsigned long>(a)); }
+
+// the checks between neighbouring tokens, and at the end of the expression, one token at a time.
+// the lexer runs them on every token it reads, and the constant solver on every token it scans.
+class TokenCheck {
+
+public:
+	constexpr bool	Push(token_type, std::size_t);
+	constexpr bool	Finish(std::size_t);
+
+	constexpr token_type	GetPrevious() const { return m_prev; }
+	constexpr std::size_t	GetPreviousPosition() const { return m_prev_pos; }
+	constexpr errors		GetErrorCode() const { return m_error_code; }
+	constexpr std::size_t	GetErrorPosition() const { return m_error_pos; }
+
+private:
+	constexpr bool	SetError(errors, std::size_t);
+
+	errors		m_error_code = NO_ERROR;
+	std::size_t	m_error_pos = 0;
+
+	token_type	m_prev = TOKEN_NONE;
+	std::size_t	m_prev_pos = 0;
+	int			m_minus_run = 0;
+	long		m_paren_depth = 0;
+};
+
+///
+/// @brief checks a token against the previous token.
+/// @param[in] token_type of the new token.
+/// @param[in] size_t is the position of the token within the expression.
+/// @return 0 if the token is allowed in this position, 1 if it is a syntax error.
+/// @todo
+///
+constexpr bool TokenCheck::Push(token_type type, std::size_t pos) {
+
+	switch(type) {
+
+		case TOKEN_NUMBER:
+
+			// two operands separated only by white space
+			if(IsOperand(m_prev)) { return SetError(INVALID_INPUT_INVALID_INTEGER, pos); }
+			break;
+
+		case TOKEN_VARIABLE:
+
+			// two names separated only by white space
+			if(m_prev == TOKEN_VARIABLE) { return SetError(INVALID_INPUT_INVALID_INTEGER, pos); }
+			break;
+
+		case TOKEN_LEFT_PAREN:
+			m_paren_depth++;
+			break;
+
+		case TOKEN_RIGHT_PAREN:
+
+			// check to ensure left paren is followed by a number, '-' or another '('
+			if(m_prev == TOKEN_LEFT_PAREN) { return SetError(INVALID_INPUT_LEFT_PAREN, m_prev_pos); }
+
+			// check to ensure right paren is preceded by an operand or another ')'
+			if(m_prev == TOKEN_NONE || IsOperator(m_prev)) { return SetError(INVALID_INPUT_RIGHT_PAREN, pos); }
+
+			if(--m_paren_depth < 0) { return SetError(INVALID_INPUT_PARENTHESES_MISMATCH, pos); }
+			break;
+
+		case TOKEN_MINUS:
+
+			// two '-' will be resolved as a subtraction of a negative number.
+			// more than two '-' is an error.
+			if(m_minus_run == 2) { return SetError(INVALID_INPUT_DUAL_OPERATORS, pos); }
+			break;
+
+		default:
+
+			// check if operator was passed as first character
+			if(m_prev == TOKEN_NONE) { return SetError(INVALID_INPUT_OPERATOR_FIRST, pos); }
+
+			// check to ensure left paren is followed by a number, '-' or another '('
+			if(m_prev == TOKEN_LEFT_PAREN) { return SetError(INVALID_INPUT_LEFT_PAREN, m_prev_pos); }
+
+			// check if two consecutive operators were passed
+			if(IsOperator(m_prev)) { return SetError(INVALID_INPUT_DUAL_OPERATORS, pos); }
+			break;
+	}
+
+	m_minus_run = (type == TOKEN_MINUS) ? m_minus_run + 1 : 0;
+	m_prev = type;
+	m_prev_pos = pos;
+	return 0;
+}
+
+///
+/// @brief checks the end of the expression once every token has been read.
+/// @param[in] size_t is the length of the expression, used as the error position for unmatched parentheses.
+/// @return 0 if the expression ends correctly, 1 if it is a syntax error.
+/// @todo
+///
+constexpr bool TokenCheck::Finish(std::size_t size) {
+
+	// an expression of only white space
+	if(m_prev == TOKEN_NONE) { return SetError(INVALID_INPUT_INVALID_INTEGER, 0); }
+
+	// check if operator was passed as last character
+	if(IsOperator(m_prev)) { return SetError(INVALID_INPUT_OPERATOR_LAST, m_prev_pos); }
+
+	if(m_prev == TOKEN_LEFT_PAREN) { return SetError(INVALID_INPUT_LEFT_PAREN, m_prev_pos); }
+
+	// check to ensure all parenthesis symbols are paired
+	if(m_paren_depth) { return SetError(INVALID_INPUT_PARENTHESES_MISMATCH, size); }
+
+	return 0;
+}
+
+///
+/// @brief records the first error found in the expression.
+/// @param[in] enumerator corresponding to the error_code enum.
+/// @param[in] size_t is the position of the offending character.
+/// @return always 1, so callers can return the result directly.
+/// @todo
+///
+constexpr bool TokenCheck::SetError(errors error_code, std::size_t pos) {
+	m_error_code = error_code;
+	m_error_pos = pos;
+	return 1;
+}
+
+} // NAMESPACE BOCAN
+
+#endif	// GRAMMAR_HPP
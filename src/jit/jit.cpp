@@ -0,0 +1,235 @@
+//
+// JIT.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__))
+#define BOCAN_JIT 1
+#include <sys/mman.h>
+#endif
+
+#include "jit.hpp"
+
+using bocan::Jit;
+
+namespace {
+
+// writes x86-64 instructions. every slot is addressed as [rbx + 8 * index], and rbx holds the slots
+// for the whole function, as it survives the call to pow.
+class Emitter {
+
+public:
+	void Bytes(std::initializer_list<unsigned char> bytes) { m_code.insert(m_code.end(), bytes); }
+
+	void Int32(std::uint32_t value) {
+		for(int i = 0; i < 4; i++) { m_code.push_back(static_cast<unsigned char>(value >> (8 * i))); }
+	}
+
+	void Int64(std::uint64_t value) {
+		for(int i = 0; i < 8; i++) { m_code.push_back(static_cast<unsigned char>(value >> (8 * i))); }
+	}
+
+	// an instruction whose last operand is [rbx + disp32]. reg is the register field of the ModRM byte
+	void Slot(std::initializer_list<unsigned char> opcode, unsigned char reg, unsigned int slot) {
+		Bytes(opcode);
+		m_code.push_back(static_cast<unsigned char>(0x83 | (reg << 3)));
+		Int32(slot * 8);
+	}
+
+	const std::vector<unsigned char>& Code() const { return m_code; }
+
+private:
+	std::vector<unsigned char> m_code;
+};
+
+// register numbers for the ModRM byte
+const unsigned char XMM0 = 0;
+const unsigned char XMM1 = 1;
+const unsigned char RAX = 0;
+
+double Power(double base, double exponent) {
+	return std::pow(base, exponent);
+}
+
+///
+/// @brief writes one step of a program of doubles.
+/// @param[in,out] Emitter pointer receiving the instructions.
+/// @param[in] JitStep reference to the step.
+/// @param[in] unsigned integer is the value returned if the step divides by zero.
+/// @return
+/// @todo
+///
+void EmitDouble(Emitter* out, const bocan::JitStep& step, unsigned int failure) {
+
+	switch(step.type) {
+
+		case bocan::NODE_NEGATE:
+
+			// flip the sign bit, so -0 and NaN come out exactly as the interpreter's -x
+			out->Slot({ 0x48, 0x8B }, RAX, step.lhs);				// mov rax, [lhs]
+			out->Bytes({ 0x48, 0x0F, 0xBA, 0xF8, 0x3F });			// btc rax, 63
+			out->Slot({ 0x48, 0x89 }, RAX, step.dst);				// mov [dst], rax
+			return;
+
+		case bocan::NODE_DIVIDE:
+			out->Slot({ 0xF2, 0x0F, 0x10 }, XMM0, step.lhs);		// movsd xmm0, [lhs]
+			out->Slot({ 0xF2, 0x0F, 0x10 }, XMM1, step.rhs);		// movsd xmm1, [rhs]
+			out->Bytes({ 0x66, 0x0F, 0x57, 0xD2 });					// xorpd xmm2, xmm2
+			out->Bytes({ 0x66, 0x0F, 0x2E, 0xCA });					// ucomisd xmm1, xmm2
+
+			// a NaN divisor is unordered and is divided by, as rhs == 0 is false for it
+			out->Bytes({ 0x7A, 0x09 });								// jp divide
+			out->Bytes({ 0x75, 0x07 });								// jne divide
+			out->Bytes({ 0xB8 });									// mov eax, failure
+			out->Int32(failure);
+			out->Bytes({ 0x5B, 0xC3 });								// pop rbx; ret
+			out->Bytes({ 0xF2, 0x0F, 0x5E, 0xC1 });					// divide: divsd xmm0, xmm1
+			break;
+
+		case bocan::NODE_POWER:
+			out->Slot({ 0xF2, 0x0F, 0x10 }, XMM0, step.lhs);		// movsd xmm0, [lhs]
+			out->Slot({ 0xF2, 0x0F, 0x10 }, XMM1, step.rhs);		// movsd xmm1, [rhs]
+			out->Bytes({ 0x48, 0xB8 });								// mov rax, Power
+			out->Int64(reinterpret_cast<std::uint64_t>(&Power));
+			out->Bytes({ 0xFF, 0xD0 });								// call rax
+			break;
+
+		default: {
+			unsigned char opcode = 0x58;							// addsd
+			if(step.type == bocan::NODE_SUBTRACT) { opcode = 0x5C; }	// subsd
+			if(step.type == bocan::NODE_MULTIPLY) { opcode = 0x59; }	// mulsd
+
+			out->Slot({ 0xF2, 0x0F, 0x10 }, XMM0, step.lhs);		// movsd xmm0, [lhs]
+			out->Slot({ 0xF2, 0x0F, opcode }, XMM0, step.rhs);		// op xmm0, [rhs]
+			break;
+		}
+	}
+
+	out->Slot({ 0xF2, 0x0F, 0x11 }, XMM0, step.dst);				// movsd [dst], xmm0
+}
+
+///
+/// @brief writes one step of an integral program of longs. overflow wraps around.
+/// @param[in,out] Emitter pointer receiving the instructions.
+/// @param[in] JitStep reference to the step.
+/// @return
+/// @todo
+///
+void EmitInteger(Emitter* out, const bocan::JitStep& step) {
+
+	out->Slot({ 0x48, 0x8B }, RAX, step.lhs);						// mov rax, [lhs]
+
+	switch(step.type) {
+		case bocan::NODE_ADD:		out->Slot({ 0x48, 0x03 }, RAX, step.rhs); break;		// add rax, [rhs]
+		case bocan::NODE_SUBTRACT:	out->Slot({ 0x48, 0x2B }, RAX, step.rhs); break;		// sub rax, [rhs]
+		case bocan::NODE_MULTIPLY:	out->Slot({ 0x48, 0x0F, 0xAF }, RAX, step.rhs); break;	// imul rax, [rhs]
+		default:					out->Bytes({ 0x48, 0xF7, 0xD8 }); break;				// neg rax
+	}
+
+	out->Slot({ 0x48, 0x89 }, RAX, step.dst);						// mov [dst], rax
+}
+
+} // NAMESPACE
+
+///
+/// @brief compiles a program over value slots to native code. any code compiled before is released.
+/// @param[in] JitStep pointer to the steps, in order.
+/// @param[in] size_t is the number of steps.
+/// @param[in] boolean true to solve with longs. only adding, subtracting, multiplying and negating are allowed.
+/// @return 0 if the program was compiled, 1 if it cannot be, such as on a machine that is not x86-64.
+/// @todo
+///
+bool Jit::Compile(const JitStep* steps, std::size_t count, bool integral) {
+
+	Release();
+
+	if(!IsSupported()) { return 1; }
+
+	Emitter out;
+	out.Bytes({ 0x53 });											// push rbx
+	out.Bytes({ 0x48, 0x89, 0xFB });								// mov rbx, rdi
+
+	for(std::size_t i = 0; i < count; i++) {
+
+		const JitStep& step = steps[i];
+		if(step.dst >= MAX_SLOTS || step.lhs >= MAX_SLOTS || step.rhs >= MAX_SLOTS) { return 1; }
+
+		if(integral) {
+			if(step.type == NODE_DIVIDE || step.type == NODE_POWER) { return 1; }
+			EmitInteger(&out, step);
+		} else {
+			EmitDouble(&out, step, static_cast<unsigned int>(i + 1));
+		}
+	}
+
+	out.Bytes({ 0x31, 0xC0 });										// xor eax, eax
+	out.Bytes({ 0x5B, 0xC3 });										// pop rbx; ret
+
+#ifdef BOCAN_JIT
+
+	// written while the memory is writable, then made executable and no longer writable
+	const std::size_t size = out.Code().size();
+	void* code = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(code == MAP_FAILED) { return 1; }
+
+	std::memcpy(code, out.Code().data(), size);
+	if(mprotect(code, size, PROT_READ | PROT_EXEC) != 0) {
+		munmap(code, size);
+		return 1;
+	}
+
+	m_code = code;
+	m_size = size;
+	return 0;
+#else
+	return 1;
+#endif
+}
+
+///
+/// @brief frees the native code, if any.
+/// @return
+/// @todo
+///
+void Jit::Release() {
+#ifdef BOCAN_JIT
+	if(m_code) { munmap(m_code, m_size); }
+#endif
+	m_code = nullptr;
+	m_size = 0;
+}
+
+///
+/// @brief tells whether native code can be compiled on this machine.
+/// @return boolean true on x86-64 Linux and macOS.
+/// @todo
+///
+bool Jit::IsSupported() {
+#ifdef BOCAN_JIT
+	return true;
+#else
+	return false;
+#endif
+}
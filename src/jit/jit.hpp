@@ -0,0 +1,77 @@
+//
+// JIT.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef JIT_HPP
+#define JIT_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "../parser/parser.hpp"
+
+namespace bocan {
+
+// one step of a program over value slots, as an Expression lowers it: slot[dst] = slot[lhs] op slot[rhs].
+// the rhs of a negation is unused.
+struct JitStep {
+	node_type		type;
+	unsigned int	dst;
+	unsigned int	lhs;
+	unsigned int	rhs;
+};
+
+// turns a program over value slots into native x86-64 code in executable memory. doubles are solved
+// with scalar SSE2 and '^' calls std::pow, so every result is bit-identical to the interpreted program.
+// integral programs are solved with longs that wrap around on overflow, as PerformMathOperation() does.
+// the code is a function of the slots. it returns 0, or 1 + the index of a step that divided by zero.
+// on other machines Compile() fails and the caller keeps interpreting. a copy holds no code.
+class Jit {
+
+public:
+	Jit() {}
+	Jit(const Jit&) {}
+	Jit& operator=(const Jit&) { Release(); return *this; }
+	~Jit() { Release(); }
+
+	bool	Compile(const JitStep*, std::size_t, bool);
+	void	Release();
+
+	bool	IsCompiled() const { return m_code != nullptr; }
+	std::size_t	GetCodeSize() const { return m_size; }
+
+	unsigned int	Run(double* slots) const { return reinterpret_cast<double_function>(m_code)(slots); }
+	unsigned int	Run(long* slots) const { return reinterpret_cast<integer_function>(m_code)(slots); }
+
+	static bool	IsSupported();
+
+	// slots are addressed with 32-bit displacements
+	static const unsigned int MAX_SLOTS = 1 << 28;
+
+private:
+	typedef unsigned int (*double_function)(double*);
+	typedef unsigned int (*integer_function)(long*);
+
+	void*		m_code = nullptr;
+	std::size_t	m_size = 0;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// JIT_HPP
@@ -0,0 +1,249 @@
+//
+// KERNELS.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define KERNELS_X86 1
+#endif
+
+#include "kernels.hpp"
+
+using bocan::Kernels;
+
+namespace {
+
+// scalar kernels. these are also the tails of the vector kernels and the only power kernel,
+// since there is no vector pow that rounds exactly like std::pow.
+
+void AddScalar(const double* lhs, const double* rhs, double* dst, std::size_t n) {
+	for(std::size_t i = 0; i < n; i++) { dst[i] = lhs[i] + rhs[i]; }
+}
+
+void SubtractScalar(const double* lhs, const double* rhs, double* dst, std::size_t n) {
+	for(std::size_t i = 0; i < n; i++) { dst[i] = lhs[i] - rhs[i]; }
+}
+
+void MultiplyScalar(const double* lhs, const double* rhs, double* dst, std::size_t n) {
+	for(std::size_t i = 0; i < n; i++) { dst[i] = lhs[i] * rhs[i]; }
+}
+
+std::size_t DivideScalar(const double* lhs, const double* rhs, double* dst, std::size_t n) {
+	for(std::size_t i = 0; i < n; i++) {
+
+		// check for a divide by zero error
+		if(rhs[i] == 0) { return i; }
+		dst[i] = lhs[i] / rhs[i];
+	}
+	return n;
+}
+
+void PowerScalar(const double* lhs, const double* rhs, double* dst, std::size_t n) {
+	for(std::size_t i = 0; i < n; i++) { dst[i] = std::pow(lhs[i], rhs[i]); }
+}
+
+void NegateScalar(const double* lhs, double* dst, std::size_t n) {
+	for(std::size_t i = 0; i < n; i++) { dst[i] = -lhs[i]; }
+}
+
+void ConvertScalar(const long* src, double* dst, std::size_t n) {
+	for(std::size_t i = 0; i < n; i++) { dst[i] = static_cast<double>(src[i]); }
+}
+
+const Kernels k_scalar = {
+	bocan::ISA_SCALAR, "scalar",
+	AddScalar, SubtractScalar, MultiplyScalar, DivideScalar, PowerScalar, NegateScalar, ConvertScalar
+};
+
+#ifdef KERNELS_X86
+
+// AVX2 kernels, four doubles per instruction. compiled for AVX2 only, so they are never run
+// unless the processor reports support for it.
+
+#define AVX2 __attribute__((target("avx2")))
+
+AVX2 void AddAvx2(const double* lhs, const double* rhs, double* dst, std::size_t n) {
+	std::size_t i = 0;
+	for(; i + 4 <= n; i += 4) {
+		_mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+	}
+	AddScalar(lhs + i, rhs + i, dst + i, n - i);
+}
+
+AVX2 void SubtractAvx2(const double* lhs, const double* rhs, double* dst, std::size_t n) {
+	std::size_t i = 0;
+	for(; i + 4 <= n; i += 4) {
+		_mm256_storeu_pd(dst + i, _mm256_sub_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+	}
+	SubtractScalar(lhs + i, rhs + i, dst + i, n - i);
+}
+
+AVX2 void MultiplyAvx2(const double* lhs, const double* rhs, double* dst, std::size_t n) {
+	std::size_t i = 0;
+	for(; i + 4 <= n; i += 4) {
+		_mm256_storeu_pd(dst + i, _mm256_mul_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+	}
+	MultiplyScalar(lhs + i, rhs + i, dst + i, n - i);
+}
+
+AVX2 std::size_t DivideAvx2(const double* lhs, const double* rhs, double* dst, std::size_t n) {
+	const __m256d zero = _mm256_setzero_pd();
+	std::size_t i = 0;
+	for(; i + 4 <= n; i += 4) {
+		__m256d divisor = _mm256_loadu_pd(rhs + i);
+
+		// a zero divisor in this group is located by the scalar loop
+		if(_mm256_movemask_pd(_mm256_cmp_pd(divisor, zero, _CMP_EQ_OQ))) { break; }
+		_mm256_storeu_pd(dst + i, _mm256_div_pd(_mm256_loadu_pd(lhs + i), divisor));
+	}
+	return i + DivideScalar(lhs + i, rhs + i, dst + i, n - i);
+}
+
+AVX2 void NegateAvx2(const double* lhs, double* dst, std::size_t n) {
+	const __m256d sign = _mm256_set1_pd(-0.0);
+	std::size_t i = 0;
+	for(; i + 4 <= n; i += 4) {
+		_mm256_storeu_pd(dst + i, _mm256_xor_pd(_mm256_loadu_pd(lhs + i), sign));
+	}
+	NegateScalar(lhs + i, dst + i, n - i);
+}
+
+const Kernels k_avx2 = {
+	bocan::ISA_AVX2, "avx2",
+	AddAvx2, SubtractAvx2, MultiplyAvx2, DivideAvx2, PowerScalar, NegateAvx2, ConvertScalar
+};
+
+// AVX-512 kernels, eight doubles per instruction. the remainder of a column is handled with a mask
+// instead of a scalar tail.
+
+#define AVX512 __attribute__((target("avx512f,avx512dq")))
+
+AVX512 inline __mmask8 TailMask(std::size_t n) {
+	return static_cast<__mmask8>((1u << n) - 1);
+}
+
+AVX512 void AddAvx512(const double* lhs, const double* rhs, double* dst, std::size_t n) {
+	std::size_t i = 0;
+	for(; i + 8 <= n; i += 8) {
+		_mm512_storeu_pd(dst + i, _mm512_add_pd(_mm512_loadu_pd(lhs + i), _mm512_loadu_pd(rhs + i)));
+	}
+	if(i < n) {
+		__mmask8 m = TailMask(n - i);
+		_mm512_mask_storeu_pd(dst + i, m, _mm512_add_pd(_mm512_maskz_loadu_pd(m, lhs + i), _mm512_maskz_loadu_pd(m, rhs + i)));
+	}
+}
+
+AVX512 void SubtractAvx512(const double* lhs, const double* rhs, double* dst, std::size_t n) {
+	std::size_t i = 0;
+	for(; i + 8 <= n; i += 8) {
+		_mm512_storeu_pd(dst + i, _mm512_sub_pd(_mm512_loadu_pd(lhs + i), _mm512_loadu_pd(rhs + i)));
+	}
+	if(i < n) {
+		__mmask8 m = TailMask(n - i);
+		_mm512_mask_storeu_pd(dst + i, m, _mm512_sub_pd(_mm512_maskz_loadu_pd(m, lhs + i), _mm512_maskz_loadu_pd(m, rhs + i)));
+	}
+}
+
+AVX512 void MultiplyAvx512(const double* lhs, const double* rhs, double* dst, std::size_t n) {
+	std::size_t i = 0;
+	for(; i + 8 <= n; i += 8) {
+		_mm512_storeu_pd(dst + i, _mm512_mul_pd(_mm512_loadu_pd(lhs + i), _mm512_loadu_pd(rhs + i)));
+	}
+	if(i < n) {
+		__mmask8 m = TailMask(n - i);
+		_mm512_mask_storeu_pd(dst + i, m, _mm512_mul_pd(_mm512_maskz_loadu_pd(m, lhs + i), _mm512_maskz_loadu_pd(m, rhs + i)));
+	}
+}
+
+AVX512 std::size_t DivideAvx512(const double* lhs, const double* rhs, double* dst, std::size_t n) {
+	const __m512d zero = _mm512_setzero_pd();
+	std::size_t i = 0;
+	for(; i + 8 <= n; i += 8) {
+		__m512d divisor = _mm512_loadu_pd(rhs + i);
+
+		// a zero divisor in this group is located by the scalar loop
+		if(_mm512_cmp_pd_mask(divisor, zero, _CMP_EQ_OQ)) { break; }
+		_mm512_storeu_pd(dst + i, _mm512_div_pd(_mm512_loadu_pd(lhs + i), divisor));
+	}
+	return i + DivideScalar(lhs + i, rhs + i, dst + i, n - i);
+}
+
+AVX512 void NegateAvx512(const double* lhs, double* dst, std::size_t n) {
+	const __m512d sign = _mm512_set1_pd(-0.0);
+	std::size_t i = 0;
+	for(; i + 8 <= n; i += 8) {
+		_mm512_storeu_pd(dst + i, _mm512_xor_pd(_mm512_loadu_pd(lhs + i), sign));
+	}
+	NegateScalar(lhs + i, dst + i, n - i);
+}
+
+AVX512 void ConvertAvx512(const long* src, double* dst, std::size_t n) {
+	std::size_t i = 0;
+	for(; i + 8 <= n; i += 8) {
+		_mm512_storeu_pd(dst + i, _mm512_cvtepi64_pd(_mm512_loadu_si512(src + i)));
+	}
+	ConvertScalar(src + i, dst + i, n - i);
+}
+
+const Kernels k_avx512 = {
+	bocan::ISA_AVX512, "avx512",
+	AddAvx512, SubtractAvx512, MultiplyAvx512, DivideAvx512, PowerScalar, NegateAvx512, ConvertAvx512
+};
+
+#endif	// KERNELS_X86
+
+} // NAMESPACE
+
+///
+/// @brief returns the widest kernel set the processor supports. the choice is made once and then reused.
+/// @return Kernels reference to the chosen set.
+/// @todo
+///
+const Kernels& bocan::GetKernels() {
+	static const Kernels* kernels = GetKernels(ISA_AVX512) ? GetKernels(ISA_AVX512)
+	                              : GetKernels(ISA_AVX2) ? GetKernels(ISA_AVX2)
+	                              : &k_scalar;
+	return *kernels;
+}
+
+///
+/// @brief returns a specific kernel set after checking that the processor supports it.
+/// @param[in] kernel_isa is the instruction set requested.
+/// @return Kernels pointer to the set, or nullptr if it cannot run here.
+/// @todo
+///
+const Kernels* bocan::GetKernels(kernel_isa isa) {
+	switch(isa) {
+#ifdef KERNELS_X86
+		case ISA_AVX512:
+			if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) { return &k_avx512; }
+			return nullptr;
+		case ISA_AVX2:
+			if(__builtin_cpu_supports("avx2")) { return &k_avx2; }
+			return nullptr;
+#endif
+		case ISA_SCALAR:
+			return &k_scalar;
+		default:
+			return nullptr;
+	}
+}
@@ -0,0 +1,58 @@
+//
+// KERNELS.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef KERNELS_HPP
+#define KERNELS_HPP
+
+#include <cstddef>
+
+namespace bocan {
+
+enum kernel_isa {
+	ISA_SCALAR,
+	ISA_AVX2,
+	ISA_AVX512
+};
+
+// column kernels for one operator each: dst[i] = lhs[i] op rhs[i] for i < n.
+// every set gives bit-identical results to PerformMathOperation(double, double, char).
+// divide returns the index of the first zero divisor, or n if there is none, and
+// leaves dst undefined from that index on.
+struct Kernels {
+	kernel_isa		isa;
+	const char*		name;
+	void			(*add)(const double*, const double*, double*, std::size_t);
+	void			(*subtract)(const double*, const double*, double*, std::size_t);
+	void			(*multiply)(const double*, const double*, double*, std::size_t);
+	std::size_t		(*divide)(const double*, const double*, double*, std::size_t);
+	void			(*power)(const double*, const double*, double*, std::size_t);
+	void			(*negate)(const double*, double*, std::size_t);
+	void			(*convert)(const long*, double*, std::size_t);
+};
+
+// the widest set the processor supports, chosen once on first use
+const Kernels&	GetKernels();
+
+// a specific set, or nullptr if the processor or compiler does not support it
+const Kernels*	GetKernels(kernel_isa);
+
+} // NAMESPACE BOCAN
+
+#endif	// KERNELS_HPP
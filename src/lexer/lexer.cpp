@@ -0,0 +1,170 @@
+//
+// LEXER.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstddef>
+#include <vector>
+
+#include "lexer.hpp"
+
+using bocan::Lexer;
+using bocan::Token;
+
+///
+/// @brief splits the expression into tokens in a single pass and checks the syntax between neighbouring tokens.
+/// @brief white space is skipped and implicit multiplication tokens are inserted, as ValidateInputString() used to do.
+/// @param[in] char pointer to the first character of the expression.
+/// @param[in] size_t is the length of the expression in bytes.
+/// @param[out] vector pointer receiving the tokens. the vector is cleared first but keeps its capacity.
+/// @param[in] boolean true if names made of letters are accepted as variables. a lone 'x' is always the multiplication operator.
+/// @return 0 if the expression passes all checks. returns 1 and sets the error code and position if it fails.
+/// @todo
+///
+bool Lexer::Tokenize(const char* expr, std::size_t size, std::vector<Token>* tokens, bool variables) {
+
+	tokens->clear();
+	Begin();
+
+	std::size_t i = 0;
+
+	while(i < size) {
+
+		switch(expr[i]) {
+
+			case ' ':
+			case '\t':
+			case '\r':
+				i++;
+				break;
+
+			case '0':
+			case '1':
+			case '2':
+			case '3':
+			case '4':
+			case '5':
+			case '6':
+			case '7':
+			case '8':
+			case '9':
+			case '.': {
+				std::size_t start = i;
+				errors error_code = ScanNumber(expr, size, &i, &m_floating);
+				if(error_code != NO_ERROR) { return SetError(error_code, i); }
+				if(Push(tokens, TOKEN_NUMBER, start, i - start)) { return 1; }
+				break;
+			}
+
+			default: {
+
+				token_type symbol = GetSymbol(expr[i]);
+				if(symbol != TOKEN_NONE) {
+					if(IsFloatingOperator(symbol)) { m_floating = true; }
+					if(Push(tokens, symbol, i, 1)) { return 1; }
+					i++;
+					break;
+				}
+
+				if(!variables || !IsLetter(expr[i])) {
+					if(expr[i] != 'x') { return SetError(INVALID_INPUT_INVALID_INTEGER, i); }
+					if(Push(tokens, TOKEN_MULTIPLY, i, 1)) { return 1; }
+					i++;
+					break;
+				}
+
+				// scan the whole name
+				std::size_t start = i;
+				for(i++; i < size && IsLetter(expr[i]); i++) {}
+
+				// a lone 'x' is still the multiplication operator
+				if(i - start == 1 && expr[start] == 'x') {
+					if(Push(tokens, TOKEN_MULTIPLY, start, 1)) { return 1; }
+					break;
+				}
+
+				// the values bound to a variable are not known yet, so solve with doubles
+				m_floating = true;
+				if(Push(tokens, TOKEN_VARIABLE, start, i - start)) { return 1; }
+				break;
+			}
+		}
+	}
+
+	return Finish(size);
+}
+
+///
+/// @brief clears the error and the state carried from one token to the next, ready for the first token of an expression.
+/// @param
+/// @return
+/// @todo
+///
+void Lexer::Begin() {
+	m_error_code = NO_ERROR;
+	m_error_pos = 0;
+	m_floating = false;
+	m_check = TokenCheck();
+}
+
+///
+/// @brief appends a token after checking it against the previous token.
+/// @brief inserts a multiplication token between a number, variable or ')' and a following '(' or operand, as in 2a or (a)(b).
+/// @param[out] vector pointer receiving the token.
+/// @param[in] token_type of the new token.
+/// @param[in] size_t is the position of the token within the expression.
+/// @param[in] size_t is the length of the token.
+/// @return 0 if the token is allowed in this position, 1 if it is a syntax error.
+/// @todo
+///
+bool Lexer::Push(std::vector<Token>* tokens, token_type type, std::size_t pos, std::size_t len) {
+
+	token_type prev = m_check.GetPrevious();
+	if(m_check.Push(type, pos)) { return SetError(m_check.GetErrorCode(), m_check.GetErrorPosition()); }
+
+	if(IsImplicitMultiply(prev, type)) {
+		tokens->push_back(Token{ TOKEN_MULTIPLY, static_cast<unsigned int>(pos), 0 });
+	}
+
+	tokens->push_back(Token{ type, static_cast<unsigned int>(pos), static_cast<unsigned int>(len) });
+	return 0;
+}
+
+///
+/// @brief checks the end of the expression once every token has been read.
+/// @param[in] size_t is the length of the expression, used as the error position for unmatched parentheses.
+/// @return 0 if the expression ends correctly, 1 if it is a syntax error.
+/// @todo
+///
+bool Lexer::Finish(std::size_t size) {
+	if(m_check.Finish(size)) { return SetError(m_check.GetErrorCode(), m_check.GetErrorPosition()); }
+	return 0;
+}
+
+///
+/// @brief records the first error found in the expression.
+/// @param[in] enumerator corresponding to the error_code enum.
+/// @param[in] size_t is the position of the offending character.
+/// @return always 1, so callers can return the result directly.
+/// @todo
+///
+bool Lexer::SetError(errors error_code, std::size_t pos) {
+	m_error_code = error_code;
+	m_error_pos = pos;
+	return 1;
+}
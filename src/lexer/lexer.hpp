@@ -0,0 +1,59 @@
+//
+// LEXER.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef LEXER_HPP
+#define LEXER_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "../calculator/errors.hpp"
+#include "../grammar/grammar.hpp"
+
+namespace bocan {
+
+class Lexer {
+
+public:
+	bool	Tokenize(const char*, std::size_t, std::vector<Token>*, bool variables = false);
+
+	// the same checks, one token at a time, for input that is never held in memory as a whole.
+	// Push() may append an implicit multiplication before the token.
+	void	Begin();
+	bool	Push(std::vector<Token>*, token_type, std::size_t, std::size_t);
+	bool	Finish(std::size_t);
+
+	bool		IsFloating() const { return m_floating; }
+	errors		GetErrorCode() const { return m_error_code; }
+	std::size_t	GetErrorPosition() const { return m_error_pos; }
+
+private:
+	bool	SetError(errors, std::size_t);
+
+	errors		m_error_code = NO_ERROR;
+	std::size_t	m_error_pos = 0;
+	bool		m_floating = false;
+
+	TokenCheck	m_check;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// LEXER_HPP
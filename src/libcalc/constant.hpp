@@ -0,0 +1,825 @@
+//
+// CONSTANT.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++20
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef CONSTANT_HPP
+#define CONSTANT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "libcalc.hpp"
+#include "../calculator/errors.hpp"
+#include "../grammar/grammar.hpp"
+
+namespace bocan {
+namespace calc {
+
+// solves an expression while the program is compiled, with the same grammar, checks, error codes and
+// positions as Solver::Solve(). an expression of integers is solved with longs that wrap around, and one with
+// '/', '^', a radix point or an exponent with doubles. the text is read twice, once to check it with the lexer's
+// TokenCheck and once to parse it with a stack of waiting operators and one of operands, solving each operator as
+// soon as both operands are known. the tokens, their checks, precedence and integer arithmetic are those of
+// src/grammar/grammar.hpp. the stacks are vectors that are freed before Solve() returns, so it runs in a constant
+// expression, and parentheses may be nested MAX_DEPTH deep without recursion. sums, differences, products,
+// quotients and literals that fit the exact fast path of ParseDouble() are bit-identical to the run time solution.
+// other literals and '^' are computed with long doubles and rounded, so they may differ in the last bit.
+class ConstantSolver {
+
+public:
+	constexpr bool	Solve(std::string_view, Result*);
+
+	static constexpr long double LN2 = 0.693147180559945309417232121458176568L;
+
+private:
+	struct number {
+		long	integer;
+		double	real;
+	};
+
+	// a binary operator waiting for its right operand, a negative sign waiting for its operand, or an open '('
+	struct pending {
+		token_type		type;
+		bool			negate;
+		unsigned int	pos;
+	};
+
+	constexpr bool	Check();
+	constexpr bool	Scan(std::size_t*, Token*);
+	constexpr void	Advance();
+
+	constexpr bool		Parse(number*);
+	constexpr void		Reduce(std::vector<number>*, std::vector<pending>*);
+	constexpr number	Operate(number, number, char, std::size_t);
+
+	constexpr bool	SetError(errors, std::size_t);
+
+	static constexpr bool	IsNegative(double);
+	static constexpr int	GetExponent(double);
+
+	static constexpr double			ParseDouble(std::string_view);
+	static constexpr double			Arithmetic(double, double, char);
+	static constexpr double			Power(double, double);
+	static constexpr double			Round(long double);
+	static constexpr long double	PowerOfTen(int);
+	static constexpr long double	Log(long double);
+	static constexpr long double	Exp(long double);
+
+	std::string_view	m_expr;
+	errors				m_error_code = NO_ERROR;
+	std::size_t			m_error_pos = 0;
+	bool				m_floating = false;
+
+	// the first divide by zero, in the order the runtime evaluator meets it. a syntax error found later still wins
+	errors		m_solve_code = NO_ERROR;
+	std::size_t	m_solve_pos = 0;
+
+	// lexer state while checking
+	TokenCheck	m_check;
+
+	// parser state. a number or '(' after ')' and a '(' after a number are separated by an implicit
+	// multiplication, which is returned before the held token
+	Token		m_token = Token{ TOKEN_NONE, 0, 0 };
+	Token		m_held = Token{ TOKEN_NONE, 0, 0 };
+	bool		m_holding = false;
+	token_type	m_last = TOKEN_NONE;
+	std::size_t	m_next = 0;
+	int			m_depth = 0;
+};
+
+///
+/// @brief solves an expression. in a constant expression the compiler folds the result into the program.
+/// @param[in] string_view of the expression.
+/// @param[out] Result pointer receiving the value and its type, or the error code and position.
+/// @return 0 if the expression was solved, 1 if it failed.
+/// @todo
+///
+constexpr bool ConstantSolver::Solve(std::string_view expr, Result* result) {
+
+	*this = ConstantSolver();
+	*result = Result{};
+	result->type = RESULT_INTEGER;
+	result->error_code = NO_ERROR;
+	result->error_position = 0;
+
+	m_expr = expr;
+
+	bool err = Check();
+
+	number value{ 0, 0 };
+	if(!err) {
+		m_next = 0;
+		m_last = TOKEN_NONE;
+		m_holding = false;
+		Advance();
+
+		err = Parse(&value);
+
+		// every token must belong to the tree
+		if(!err && m_token.type != TOKEN_NONE) { err = SetError(SOLVE_ERROR, m_token.pos); }
+		if(!err && m_solve_code != NO_ERROR) { err = SetError(m_solve_code, m_solve_pos); }
+	}
+
+	if(err) {
+		result->error_code = m_error_code;
+		result->error_position = m_error_pos;
+		return 1;
+	}
+
+	if(m_floating) {
+		result->type = RESULT_FLOATING;
+		result->value.floating = value.real;
+	} else {
+		result->value.integer = value.integer;
+	}
+	return 0;
+}
+
+///
+/// @brief reads every token once with the checks of Lexer::Tokenize(), and finds whether to solve with doubles.
+/// @param
+/// @return 0 if the expression passes all checks. returns 1 and sets the error code and position if it fails.
+/// @todo
+///
+constexpr bool ConstantSolver::Check() {
+
+	std::size_t i = 0;
+	Token token{ TOKEN_NONE, 0, 0 };
+
+	while(true) {
+		if(Scan(&i, &token)) { return 1; }
+		if(token.type == TOKEN_NONE) { break; }
+		if(m_check.Push(token.type, token.pos)) { return SetError(m_check.GetErrorCode(), m_check.GetErrorPosition()); }
+	}
+
+	if(m_check.Finish(m_expr.size())) { return SetError(m_check.GetErrorCode(), m_check.GetErrorPosition()); }
+	return 0;
+}
+
+///
+/// @brief reads the next token of the text, skipping white space. a lone 'x' is the multiplication operator.
+/// @param[in,out] size_t pointer to the position of the next character.
+/// @param[out] Token pointer receiving the token. its type is TOKEN_NONE at the end of the text.
+/// @return 0 if a token or the end was read, 1 if the text holds an invalid character or radix point.
+/// @todo
+///
+constexpr bool ConstantSolver::Scan(std::size_t* next, Token* token) {
+
+	const std::size_t size = m_expr.size();
+	std::size_t i = *next;
+
+	while(i < size && (m_expr[i] == ' ' || m_expr[i] == '\t' || m_expr[i] == '\r')) { i++; }
+
+	if(i == size) {
+		*next = i;
+		*token = Token{ TOKEN_NONE, static_cast<unsigned int>(i), 0 };
+		return 0;
+	}
+
+	const char c = m_expr[i];
+	const token_type type = c == 'x' ? TOKEN_MULTIPLY : GetSymbol(c);
+
+	if(type != TOKEN_NONE) {
+		if(IsFloatingOperator(type)) { m_floating = true; }
+		*next = i + 1;
+		*token = Token{ type, static_cast<unsigned int>(i), 1 };
+		return 0;
+	}
+
+	if(c != '.' && (c < '0' || c > '9')) { return SetError(INVALID_INPUT_INVALID_INTEGER, i); }
+
+	std::size_t start = i;
+	errors error_code = ScanNumber(m_expr.data(), size, &i, &m_floating);
+	if(error_code != NO_ERROR) { return SetError(error_code, i); }
+
+	*next = i;
+	*token = Token{ TOKEN_NUMBER, static_cast<unsigned int>(start), static_cast<unsigned int>(i - start) };
+	return 0;
+}
+
+///
+/// @brief moves to the next token of the checked text, returning an implicit multiplication first where one belongs.
+/// @param
+/// @return
+/// @todo
+///
+constexpr void ConstantSolver::Advance() {
+
+	if(m_holding) {
+		m_holding = false;
+		m_token = m_held;
+		m_last = m_token.type;
+		return;
+	}
+
+	Token token{ TOKEN_NONE, 0, 0 };
+	Scan(&m_next, &token);
+
+	if(IsImplicitMultiply(m_last, token.type)) {
+		m_holding = true;
+		m_held = token;
+		m_token = Token{ TOKEN_MULTIPLY, token.pos, 0 };
+		return;
+	}
+
+	m_token = token;
+	m_last = token.type;
+}
+
+///
+/// @brief parses and solves the checked expression, in the order Parser::Parse() emits the nodes of its tree.
+/// @brief each operand is any number of negative signs, then a number or a parenthesized group. after it come
+/// @brief binary operators, or the ')' of a group. a negative sign binds tighter than any binary operator, so -2^2 is 4.
+/// @param[out] number pointer receiving the value of the expression.
+/// @return 0 if the expression was parsed, 1 on error.
+/// @todo
+///
+constexpr bool ConstantSolver::Parse(number* value) {
+
+	std::vector<number> values;
+	std::vector<pending> operators;
+
+	while(true) {
+
+		const Token token = m_token;
+
+		if(token.type == TOKEN_MINUS) {
+			operators.push_back(pending{ TOKEN_MINUS, true, token.pos });
+			Advance();
+			continue;
+		}
+
+		if(token.type == TOKEN_LEFT_PAREN) {
+			if(++m_depth > MAX_DEPTH) { return SetError(SOLVE_ERROR, token.pos); }
+			operators.push_back(pending{ TOKEN_LEFT_PAREN, false, token.pos });
+			Advance();
+			continue;
+		}
+
+		if(token.type == TOKEN_NONE) { return SetError(INVALID_INPUT_OPERATOR_LAST, m_check.GetPreviousPosition()); }
+		if(token.type != TOKEN_NUMBER) { return SetError(SOLVE_ERROR, token.pos); }
+
+		std::string_view literal = m_expr.substr(token.pos, token.len);
+		Advance();
+		values.push_back(m_floating ? number{ 0, ParseDouble(literal) } : number{ ParseInteger(literal.data(), literal.size()), 0 });
+
+		// the operand is complete. apply its negative signs, then close any groups it ends
+		while(true) {
+
+			while(!operators.empty() && operators.back().negate) {
+				number& operand = values.back();
+
+				// the most negative long wraps around to itself
+				operand = number{ WrapNegate(operand.integer), -operand.real };
+				operators.pop_back();
+			}
+
+			if(m_token.type == TOKEN_RIGHT_PAREN && m_depth > 0) {
+
+				while(operators.back().type != TOKEN_LEFT_PAREN) { Reduce(&values, &operators); }
+
+				operators.pop_back();
+				m_depth--;
+				Advance();
+				continue;
+			}
+			break;
+		}
+
+		int precedence = GetPrecedence(m_token.type);
+
+		if(precedence == 0) {
+
+			// the end of the expression, or a token that cannot follow an operand
+			while(!operators.empty() && operators.back().type != TOKEN_LEFT_PAREN) { Reduce(&values, &operators); }
+			if(!operators.empty()) { return SetError(INVALID_INPUT_PARENTHESES_MISMATCH, operators.back().pos); }
+
+			*value = values.back();
+			return 0;
+		}
+
+		// operators of the same or a higher precedence are solved first, which makes equal precedence left associative
+		while(!operators.empty() && operators.back().type != TOKEN_LEFT_PAREN && GetPrecedence(operators.back().type) >= precedence) {
+			Reduce(&values, &operators);
+		}
+
+		operators.push_back(pending{ m_token.type, false, m_token.pos });
+		Advance();
+	}
+}
+
+///
+/// @brief solves the binary operator on top of the stack with the two operands on top of theirs.
+/// @param[in,out] vector pointer to the operands. the two on top are replaced by the solution.
+/// @param[in,out] vector pointer to the waiting operators. the one on top is removed.
+/// @return
+/// @todo
+///
+constexpr void ConstantSolver::Reduce(std::vector<number>* values, std::vector<pending>* operators) {
+
+	const pending oper = operators->back();
+	operators->pop_back();
+
+	const number rhs = values->back();
+	values->pop_back();
+
+	char symbol = '^';
+	switch(oper.type) {
+		case TOKEN_PLUS:		symbol = '+'; break;
+		case TOKEN_MINUS:		symbol = '-'; break;
+		case TOKEN_MULTIPLY:	symbol = '*'; break;
+		case TOKEN_DIVIDE:		symbol = '/'; break;
+		default:				break;
+	}
+	values->back() = Operate(values->back(), rhs, symbol, oper.pos);
+}
+
+///
+/// @brief performs the specified math operation, as Evaluator::PerformMathOperation() does for longs or doubles.
+/// @brief the first divide by zero is kept, and the expression is still parsed to the end to look for syntax errors.
+/// @param[in] number is the first (left) operand.
+/// @param[in] number is the next (right) operand.
+/// @param[in] char is the operator specifying which operation to execute.
+/// @param[in] size_t is the position of the operator within the expression.
+/// @return solution of the operation.
+/// @todo
+///
+constexpr ConstantSolver::number ConstantSolver::Operate(number lhs, number rhs, char oper, std::size_t pos) {
+
+	if(!m_floating) {
+
+		// '/' and '^' always solve with doubles, and the rest wrap around on overflow
+		switch(oper) {
+			case '*':	return number{ WrapMultiply(lhs.integer, rhs.integer), 0 };
+			case '+':	return number{ WrapAdd(lhs.integer, rhs.integer), 0 };
+			default:	return number{ WrapSubtract(lhs.integer, rhs.integer), 0 };
+		}
+	}
+
+	// check for a divide by zero error
+	if(oper == '/' && rhs.real == 0) {
+		if(m_solve_code == NO_ERROR) {
+			m_solve_code = DIVIDE_BY_ZERO;
+			m_solve_pos = pos;
+		}
+		return number{ 0, 0xFF };
+	}
+
+	return number{ 0, oper == '^' ? Power(lhs.real, rhs.real) : Arithmetic(lhs.real, rhs.real, oper) };
+}
+
+///
+/// @brief records the first error found in the expression.
+/// @param[in] enumerator corresponding to the error_code enum.
+/// @param[in] size_t is the position of the offending character.
+/// @return always 1, so callers can return the result directly.
+/// @todo
+///
+constexpr bool ConstantSolver::SetError(errors error_code, std::size_t pos) {
+	m_error_code = error_code;
+	m_error_pos = pos;
+	return 1;
+}
+
+///
+/// @brief checks the sign bit of a double, which tells -0 from 0 where a comparison cannot.
+/// @param[in] double is the value.
+/// @return boolean true if the sign bit is set.
+/// @todo
+///
+constexpr bool ConstantSolver::IsNegative(double value) {
+	return (__builtin_bit_cast(std::uint64_t, value) >> 63) != 0;
+}
+
+///
+/// @brief finds the power of two of a finite, non-zero double, as std::ilogb() does.
+/// @param[in] double is the value.
+/// @return integer e such that 2^e <= |value| < 2^(e+1).
+/// @todo
+///
+constexpr int ConstantSolver::GetExponent(double value) {
+
+	if(value < 0) { value = -value; }
+
+	int exponent = 0;
+	while(value >= 0x1p32) { value *= 0x1p-32; exponent += 32; }
+	while(value >= 2) { value *= 0.5; exponent++; }
+	while(value < 0x1p-32) { value *= 0x1p32; exponent -= 32; }
+	while(value < 1) { value *= 2; exponent--; }
+	return exponent;
+}
+
+///
+/// @brief converts a numeric literal with the fast path of ParseDouble(). when the significant digits and the
+/// @brief power of ten are not both exact, the value is scaled with long doubles and rounded once.
+/// @param[in] string_view of the literal.
+/// @return double nearest to the literal, or within one unit in the last place of it.
+/// @todo
+///
+constexpr double ConstantSolver::ParseDouble(std::string_view digits) {
+
+	constexpr std::uint64_t MAX_EXACT_MANTISSA = std::uint64_t(1) << 53;
+	constexpr int MAX_EXACT_POWER = 22;
+
+	const std::size_t len = digits.size();
+
+	std::uint64_t mantissa = 0;
+	int significant = 0;
+	int exponent = 0;
+	int dropped = 0;
+	bool exact = true;
+	std::size_t i = 0;
+
+	// leading zeros are not significant
+	while(i < len && digits[i] == '0') { i++; }
+
+	for(; i < len && digits[i] >= '0' && digits[i] <= '9'; i++) {
+		if(significant < 19) {
+			mantissa = mantissa * 10 + static_cast<unsigned>(digits[i] - '0');
+			if(mantissa) { significant++; }
+		} else {
+			exact = false;
+			dropped++;
+		}
+	}
+
+	if(i < len && digits[i] == '.') {
+		for(i++; i < len && digits[i] >= '0' && digits[i] <= '9'; i++) {
+			if(significant < 19) {
+				mantissa = mantissa * 10 + static_cast<unsigned>(digits[i] - '0');
+				if(mantissa) { significant++; }
+				exponent--;
+			} else {
+				exact = false;
+			}
+		}
+	}
+
+	if(i < len && (digits[i] == 'e' || digits[i] == 'E')) {
+
+		bool negative = false;
+		int power = 0;
+
+		i++;
+		if(i < len && (digits[i] == '+' || digits[i] == '-')) {
+			negative = digits[i] == '-';
+			i++;
+		}
+
+		// the value of a huge exponent no longer matters once it is clamped
+		for(; i < len && digits[i] >= '0' && digits[i] <= '9'; i++) {
+			if(power < 100000) { power = power * 10 + (digits[i] - '0'); }
+		}
+		exponent += negative ? -power : power;
+	}
+
+	if(mantissa == 0) { return 0; }
+
+	if(exact && mantissa <= MAX_EXACT_MANTISSA) {
+
+		if(exponent >= 0 && exponent <= MAX_EXACT_POWER) {
+			return static_cast<double>(mantissa) * static_cast<double>(PowerOfTen(exponent));
+		}
+		if(exponent < 0 && exponent >= -MAX_EXACT_POWER) {
+			return static_cast<double>(mantissa) / static_cast<double>(PowerOfTen(-exponent));
+		}
+
+		// a small mantissa can absorb part of a large exponent and stay exact, as in 12e25
+		if(exponent > MAX_EXACT_POWER && exponent <= MAX_EXACT_POWER + 15) {
+			std::uint64_t scaled = mantissa;
+			int extra = exponent - MAX_EXACT_POWER;
+			for(; extra > 0 && scaled <= MAX_EXACT_MANTISSA / 10; extra--) { scaled *= 10; }
+			if(extra == 0) { return static_cast<double>(scaled) * static_cast<double>(PowerOfTen(MAX_EXACT_POWER)); }
+		}
+	}
+
+	// digits dropped before the radix point still scale the value
+	exponent += dropped;
+
+	// the value is mantissa * 10^exponent with 1 <= mantissa < 10^19
+	if(significant + exponent > 310) { return std::numeric_limits<double>::infinity(); }
+	if(significant + exponent < -330) { return 0; }
+
+	long double value = static_cast<long double>(mantissa);
+	if(exponent >= 0) { return Round(value * PowerOfTen(exponent)); }
+
+	// past 10^-300 the power of ten is divided out in two steps, so it stays a normal long double everywhere
+	if(exponent < -300) {
+		value /= PowerOfTen(300);
+		exponent += 300;
+	}
+	return Round(value / PowerOfTen(-exponent));
+}
+
+///
+/// @brief adds, subtracts, multiplies or divides doubles exactly as the processor does. a result that overflows
+/// @brief to an infinity or is not a number is returned as such without computing it, since a constant
+/// @brief expression may not overflow.
+/// @param[in] double is the first (left) operand.
+/// @param[in] double is the next (right) operand. never zero for '/'.
+/// @param[in] char is '+', '-', '*' or '/'.
+/// @return solution of the operation as a double (8 bytes).
+/// @todo
+///
+constexpr double ConstantSolver::Arithmetic(double lhs, double rhs, char oper) {
+
+	constexpr double INF = std::numeric_limits<double>::infinity();
+	constexpr double NOT_A_NUMBER = std::numeric_limits<double>::quiet_NaN();
+
+	if(lhs != lhs || rhs != rhs) { return NOT_A_NUMBER; }
+
+	if(oper == '-') {
+		rhs = -rhs;
+		oper = '+';
+	}
+
+	const bool infinite = lhs == INF || lhs == -INF || rhs == INF || rhs == -INF;
+	const bool negative = IsNegative(lhs) != IsNegative(rhs);
+
+	switch(oper) {
+
+		case '+':
+			if(infinite) {
+				if(lhs == -rhs) { return NOT_A_NUMBER; }
+				return (lhs == INF || lhs == -INF) ? lhs : rhs;
+			}
+			if(lhs == 0 || rhs == 0) { return lhs + rhs; }
+			{
+				int exponent = GetExponent(lhs) > GetExponent(rhs) ? GetExponent(lhs) : GetExponent(rhs);
+				if(exponent < 1023) { return lhs + rhs; }
+
+				// the halved sum rounds up to 2^1023 exactly when the sum rounds up to an infinity
+				double half = lhs * 0.5 + rhs * 0.5;
+				if(half >= 0x1p1023 || half <= -0x1p1023) { return half < 0 ? -INF : INF; }
+				return lhs + rhs;
+			}
+
+		case '*':
+			if(infinite) {
+				if(lhs == 0 || rhs == 0) { return NOT_A_NUMBER; }
+				return negative ? -INF : INF;
+			}
+			if(lhs == 0 || rhs == 0) { return lhs * rhs; }
+			{
+				int exponent = GetExponent(lhs) + GetExponent(rhs);
+				if(exponent < 1022) { return lhs * rhs; }
+				if(exponent > 1023) { return negative ? -INF : INF; }
+
+				// a quarter of the product rounds up to 2^1022 exactly when the product rounds up to an infinity
+				double quarter = (lhs * 0.5) * (rhs * 0.5);
+				if(quarter >= 0x1p1022 || quarter <= -0x1p1022) { return negative ? -INF : INF; }
+				return lhs * rhs;
+			}
+
+		default:
+			if(infinite) {
+				if((lhs == INF || lhs == -INF) && (rhs == INF || rhs == -INF)) { return NOT_A_NUMBER; }
+				if(lhs == INF || lhs == -INF) { return negative ? -INF : INF; }
+				return negative ? -0.0 : 0.0;
+			}
+			if(lhs == 0) { return lhs / rhs; }
+			{
+				int exponent = GetExponent(lhs) - GetExponent(rhs);
+				if(exponent < 1023) { return lhs / rhs; }
+				if(exponent > 1024) { return negative ? -INF : INF; }
+
+				// a quarter of the quotient rounds up to 2^1022 exactly when the quotient rounds up to an infinity
+				double quarter = (lhs * 0.25) / rhs;
+				if(quarter >= 0x1p1022 || quarter <= -0x1p1022) { return negative ? -INF : INF; }
+				return lhs / rhs;
+			}
+	}
+}
+
+///
+/// @brief raises a double to a power with the special cases of std::pow(). integer powers are multiplied out
+/// @brief by repeated squaring and others are taken as exp(power * log(base)), both with long doubles.
+/// @param[in] double is the base.
+/// @param[in] double is the power.
+/// @return solution of the operation as a double (8 bytes).
+/// @todo
+///
+constexpr double ConstantSolver::Power(double base, double power) {
+
+	constexpr double INF = std::numeric_limits<double>::infinity();
+	constexpr double NOT_A_NUMBER = std::numeric_limits<double>::quiet_NaN();
+
+	if(power == 0 || base == 1) { return 1; }
+	if(base != base || power != power) { return NOT_A_NUMBER; }
+
+	// every double of 2^53 or more is an even integer
+	const double magnitude = power < 0 ? -power : power;
+	const bool integral = magnitude >= 0x1p53 || static_cast<double>(static_cast<long>(power)) == power;
+	const bool odd = integral && magnitude < 0x1p53 && static_cast<long>(power) % 2 != 0;
+
+	if(power == INF || power == -INF) {
+		if(base == -1) { return 1; }
+		bool large = base > 1 || base < -1;
+		return (large == (power > 0)) ? INF : 0;
+	}
+
+	if(base == 0 || base == INF || base == -INF) {
+		bool negative = odd && IsNegative(base);
+		bool infinite = (base == 0) == (power < 0);
+		if(infinite) { return negative ? -INF : INF; }
+		return negative ? -0.0 : 0.0;
+	}
+
+	if(base < 0 && !integral) { return NOT_A_NUMBER; }
+
+	const bool negative = base < 0 && odd;
+	const long double x = base < 0 ? -static_cast<long double>(base) : static_cast<long double>(base);
+
+	// the power of two of the result decides overflow and underflow before anything is computed
+	const long double scale = power * Log(x) / LN2;
+	if(scale > 1025) { return negative ? -INF : INF; }
+	if(scale < -1077) { return negative ? -0.0 : 0.0; }
+
+	long double result = 1;
+
+	if(integral && magnitude < 0x1p63) {
+		unsigned long n = static_cast<unsigned long>(magnitude);
+		long double square = x;
+		for(; n; n >>= 1) {
+			if(n & 1) { result *= square; }
+			if(n > 1) { square *= square; }
+		}
+		if(power < 0) { result = 1 / result; }
+	} else {
+		result = Exp(power * Log(x));
+	}
+
+	double rounded = Round(result);
+	return negative ? -rounded : rounded;
+}
+
+///
+/// @brief rounds a non-negative long double to the nearest double. values past the largest double become an infinity.
+/// @param[in] long double is the value.
+/// @return double nearest to the value.
+/// @todo
+///
+constexpr double ConstantSolver::Round(long double value) {
+
+	// halfway between the largest double and 2^1024 rounds up. a long double no wider than a double never gets there
+	constexpr bool WIDER = std::numeric_limits<long double>::max_exponent > std::numeric_limits<double>::max_exponent;
+	constexpr long double HALFWAY = WIDER ? static_cast<long double>(std::numeric_limits<double>::max()) + 0x1p970L : 0;
+
+	if(WIDER && value >= HALFWAY) { return std::numeric_limits<double>::infinity(); }
+	return static_cast<double>(value);
+}
+
+///
+/// @brief raises ten to a power by repeated squaring. powers up to 10^27 are exact in a long double.
+/// @param[in] integer is the power, from 0 to 330.
+/// @return 10^power as a long double.
+/// @todo
+///
+constexpr long double ConstantSolver::PowerOfTen(int power) {
+
+	long double result = 1;
+	long double square = 10;
+
+	for(; power; power >>= 1) {
+		if(power & 1) { result *= square; }
+		if(power > 1) { square *= square; }
+	}
+	return result;
+}
+
+///
+/// @brief natural logarithm of a positive, finite long double. the value is split into a power of two
+/// @brief and a fraction near one, whose logarithm is 2 atanh((f - 1) / (f + 1)).
+/// @param[in] long double is the value.
+/// @return the natural logarithm.
+/// @todo
+///
+constexpr long double ConstantSolver::Log(long double value) {
+
+	constexpr long double SQRT2 = 1.41421356237309504880168872420969808L;
+
+	int exponent = 0;
+	while(value >= 0x1p32L) { value *= 0x1p-32L; exponent += 32; }
+	while(value < 0x1p-32L) { value *= 0x1p32L; exponent -= 32; }
+	while(value >= SQRT2) { value *= 0.5L; exponent++; }
+	while(value < SQRT2 / 2) { value *= 2; exponent--; }
+
+	const long double t = (value - 1) / (value + 1);
+	const long double t2 = t * t;
+
+	long double sum = 0;
+	long double term = t;
+	for(int k = 1; k < 60; k += 2) {
+		long double next = sum + term / k;
+		if(next == sum) { break; }
+		sum = next;
+		term *= t2;
+	}
+	return exponent * LN2 + 2 * sum;
+}
+
+///
+/// @brief e raised to a long double between about -830 and 760. ln 2 is split in two parts so the
+/// @brief reduction to a remainder below ln 2 / 2 is exact, then the remainder goes through its Taylor series.
+/// @param[in] long double is the power.
+/// @return e^power.
+/// @todo
+///
+constexpr long double ConstantSolver::Exp(long double power) {
+
+	constexpr long double LN2_HIGH = 0.693147180559945286226763982995180413L;	// ln 2 rounded to a double
+	constexpr long double LN2_LOW = LN2 - LN2_HIGH;
+
+	long double estimate = power / LN2;
+	int k = static_cast<int>(estimate < 0 ? estimate - 0.5L : estimate + 0.5L);
+	long double r = (power - k * LN2_HIGH) - k * LN2_LOW;
+
+	long double sum = 1;
+	long double term = 1;
+	for(int n = 1; n < 40; n++) {
+		term *= r / n;
+		long double next = sum + term;
+		if(next == sum) { break; }
+		sum = next;
+	}
+
+	while(k >= 32) { sum *= 0x1p32L; k -= 32; }
+	while(k <= -32) { sum *= 0x1p-32L; k += 32; }
+	while(k > 0) { sum *= 2; k--; }
+	while(k < 0) { sum *= 0.5L; k++; }
+	return sum;
+}
+
+///
+/// @brief deliberately not constexpr. a constant expression that reaches it fails to compile, and the
+/// @brief compiler names the error code in its message, as in 'ExpressionError() [with ... CODE = bocan::DIVIDE_BY_ZERO]'.
+/// @param
+/// @return
+/// @todo
+///
+template<errors CODE>
+void ExpressionError() {}
+
+///
+/// @brief calls ExpressionError() with the given error code as its template argument.
+/// @param[in] integer is the error code.
+/// @param[in] index_sequence of every code that fits in the range of the errors enum, below 32.
+/// @return
+/// @todo
+///
+template<std::size_t... CODES>
+constexpr void RaiseError(int error_code, std::index_sequence<CODES...>) {
+	((error_code == static_cast<int>(CODES) ? ExpressionError<static_cast<errors>(CODES)>() : void()), ...);
+}
+
+///
+/// @brief solves an expression. usable at run time or in a constant expression, and never fails to compile.
+/// @param[in] string_view of the expression.
+/// @return Result holding the value and its type, or the error code and position, as bocan::Evaluate() does.
+/// @todo
+///
+constexpr Result Solve(std::string_view expr) {
+	ConstantSolver solver;
+	Result result{};
+	solver.Solve(expr, &result);
+	return result;
+}
+
+///
+/// @brief solves an expression while the program is compiled. a malformed expression, or one that divides
+/// @brief by zero, fails to compile with its error code in the compiler's message.
+/// @brief constexpr auto v = bocan::calc::Evaluate("2*(12-5)^2"); gives a RESULT_FLOATING of 98.
+/// @param[in] string_view of the expression.
+/// @return Result holding the value and its type.
+/// @todo
+///
+consteval Result Evaluate(std::string_view expr) {
+	Result result = Solve(expr);
+	if(result.error_code != NO_ERROR) { RaiseError(result.error_code, std::make_index_sequence<32>()); }
+	return result;
+}
+
+} // NAMESPACE CALC
+} // NAMESPACE BOCAN
+
+#endif	// CONSTANT_HPP
@@ -0,0 +1,98 @@
+//
+// LIBCALC.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstddef>
+#include <string_view>
+
+#include "libcalc.hpp"
+#include "libcalc.h"
+#include "../solver/solver.hpp"
+
+namespace {
+
+// one solver per thread. its scratch vectors keep their capacity between calls,
+// so the steady state evaluates without touching the heap.
+thread_local bocan::Solver t_solver;
+
+} // NAMESPACE
+
+///
+/// @brief solves an expression with the calling thread's solver.
+/// @param[in] string_view of the expression. it does not need to be null terminated.
+/// @return Result holding the value and its type, or the error code and position.
+/// @todo
+///
+bocan::Result bocan::Evaluate(std::string_view expr) {
+
+	Solution solution;
+	Result result;
+
+	result.value.integer = 0;
+	result.type = RESULT_INTEGER;
+	result.error_code = NO_ERROR;
+	result.error_position = 0;
+
+	if(t_solver.Solve(expr.data(), expr.size(), &solution)) {
+		result.error_code = solution.error_code;
+		result.error_position = solution.error_pos;
+		return result;
+	}
+
+	if(solution.floating) {
+		result.type = RESULT_FLOATING;
+		result.value.floating = solution.real;
+	} else {
+		result.value.integer = solution.integer;
+	}
+	return result;
+}
+
+///
+/// @brief C entry point for Evaluate().
+/// @param[in] char pointer to the expression.
+/// @param[in] size_t is the length of the expression.
+/// @return calc_result holding the value and its type, or the error code and position.
+/// @todo
+///
+extern "C" calc_result calc_evaluate(const char* expr, std::size_t size) {
+
+	bocan::Result result = bocan::Evaluate(std::string_view(expr, expr ? size : 0));
+
+	calc_result out;
+	out.type = result.type == bocan::RESULT_FLOATING ? CALC_RESULT_FLOATING : CALC_RESULT_INTEGER;
+	if(out.type == CALC_RESULT_FLOATING) {
+		out.value.floating = result.value.floating;
+	} else {
+		out.value.integer = result.value.integer;
+	}
+	out.error_code = result.error_code;
+	out.error_position = result.error_position;
+	return out;
+}
+
+///
+/// @brief C entry point for GetErrorMessage().
+/// @param[in] integer corresponding to the errors enum.
+/// @return pointer to a static string. never null.
+/// @todo
+///
+extern "C" const char* calc_error_message(int error_code) {
+	return bocan::GetErrorMessage(error_code);
+}
@@ -0,0 +1,58 @@
+//
+// LIBCALC.H [PROJECT CALCULATOR]
+// C VERSION C99
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef LIBCALC_H
+#define LIBCALC_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CALC_NO_ERROR		(-1)
+
+#define CALC_RESULT_INTEGER		0
+#define CALC_RESULT_FLOATING	1
+
+/* the result of one evaluation. error_code is CALC_NO_ERROR on success, otherwise the same code
+   the calculator prints, and error_position is the offset of the offending character. */
+typedef struct calc_result {
+	union {
+		long	integer;
+		double	floating;
+	} value;
+	int		type;
+	int		error_code;
+	size_t	error_position;
+} calc_result;
+
+/* evaluates an expression of the given length. the text does not need to be null terminated.
+   safe to call from several threads at once. */
+calc_result	calc_evaluate(const char* expr, size_t size);
+
+/* returns a static description of an error code. never null. */
+const char*	calc_error_message(int error_code);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* LIBCALC_H */
@@ -0,0 +1,53 @@
+//
+// LIBCALC.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef LIBCALC_HPP
+#define LIBCALC_HPP
+
+#include <cstddef>
+#include <string_view>
+
+namespace bocan {
+
+enum result_type {
+	RESULT_INTEGER,
+	RESULT_FLOATING
+};
+
+// the result of one evaluation. error_code is NO_ERROR (-1) on success, otherwise one of the errors enum
+// and error_position is the offset of the offending character in the expression.
+struct Result {
+	union {
+		long	integer;
+		double	floating;
+	} value;
+	result_type	type;
+	int			error_code;
+	std::size_t	error_position;
+};
+
+// embeddable entry point. each thread keeps its own solver, so after the first few calls
+// on a thread no memory is allocated, and nothing is ever written to a stream.
+Result		Evaluate(std::string_view);
+const char*	GetErrorMessage(int);
+
+} // NAMESPACE BOCAN
+
+#endif	// LIBCALC_HPP
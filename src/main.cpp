@@ -20,23 +20,346 @@
 // SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
 // LIMITATIONS UNDER THE LICENSE.
 
+#include <chrono>
+#include <cstdio>
 #include <iostream>
+#include <memory>
+#include <cstring>
+#include <cstdlib>
+#include <csignal>
+#include <string>
+#include <thread>
+#include <vector>
 
-#include "./Calculator/Calculator.hpp"
+#include "./calculator/calculator.hpp"
+#include "./batch/batch.hpp"
+#include "./bytecode/bytecode.hpp"
+#include "./mapped_file/mapped_file.hpp"
+#include "./number/number.hpp"
+#include "./program_file/program_file.hpp"
+#include "./server/server.hpp"
+#include "./solver/solver.hpp"
+#include "./stats/allocations.hpp"
+#include "./stats/stats.hpp"
+#include "./stream/stream.hpp"
+#include "./thread_pool/thread_pool.hpp"
 
+namespace {
+
+///
+/// @brief prints the stats and the allocations counted since they were switched on.
+/// @param[in] SolveStats reference to the counters.
+/// @param[in] boolean true to print JSON instead of a table.
+/// @return
+/// @todo
+///
+void PrintStats(const bocan::SolveStats& stats, bool json) {
+	stats.Print(stderr, bocan::GetAllocationCount(), bocan::GetAllocatedBytes(), json);
+}
+
+///
+/// @brief tells whether a command line option is followed by a value.
+/// @param[in] char pointer to the argument.
+/// @return true if the next argument is the option's value.
+/// @todo
+///
+bool TakesValue(const char* option) {
+	static const char* const k_options[] = { "--serve", "--threads", "--cache", "--decimal", "--round", "--parallel", "--compile-to", "--load", "--disassemble" };
+	for(const char* name : k_options) {
+		if(std::strcmp(option, name) == 0) { return true; }
+	}
+	return false;
+}
+
+// the running server, stopped by SIGINT or SIGTERM so its socket is removed
+bocan::Server* g_server = nullptr;
+
+void StopServer(int) {
+	if(g_server) { g_server->Stop(); }
+}
+
+} // NAMESPACE
 
 int main(int argc, char** argv) {
 
-	auto& calculator = bocan::Calculator::Get();
+	// every option is read in one pass, wherever it is given. the value after an option that takes one is never
+	// read as an option itself, and the arguments left over are the expression, or the input file of a mode.
+	bool stats = false;
+	bool stats_json = false;
+	bool batch = false;
+	bool stream = false;
+	bool bigint = false;
+	bool decimal = false;
+	const char* socket_path = nullptr;
+	const char* compile_to = nullptr;
+	const char* load = nullptr;
+	const char* disassemble = nullptr;
+	const char* threads_value = nullptr;
+	const char* cache_value = nullptr;
+	unsigned long parallel = 0;
+	bocan::DecimalFormat format;
+	std::vector<char*> args(1, argv[0]);
+
+	for(int i = 1; i < argc; i++) {
+
+		const char* option = argv[i];
+		const char* value = nullptr;
+
+		if(TakesValue(option)) {
+			if(i + 1 == argc) {
+				std::cerr << ">ERROR. OPTION '" << option << "' NEEDS A VALUE." << std::endl;
+				return 1;
+			}
+			value = argv[++i];
+		}
+
+		if(std::strcmp(option, "--stats") == 0) {
+			stats = true;
+		} else if(std::strcmp(option, "--stats-json") == 0) {
+			stats = stats_json = true;
+		} else if(std::strcmp(option, "--batch") == 0) {
+			batch = true;
+		} else if(std::strcmp(option, "--stream") == 0) {
+			stream = true;
+		} else if(std::strcmp(option, "--bigint") == 0) {
+			bigint = true;
+		} else if(std::strcmp(option, "--serve") == 0) {
+			socket_path = value;
+		} else if(std::strcmp(option, "--threads") == 0) {
+			threads_value = value;
+		} else if(std::strcmp(option, "--cache") == 0) {
+			cache_value = value;
+		} else if(std::strcmp(option, "--compile-to") == 0) {
+			compile_to = value;
+		} else if(std::strcmp(option, "--load") == 0) {
+			load = value;
+		} else if(std::strcmp(option, "--disassemble") == 0) {
+			disassemble = value;
+		} else if(std::strcmp(option, "--decimal") == 0) {
+			decimal = true;
+			format.scale = static_cast<int>(std::strtol(value, nullptr, 10));
+			if(format.scale < 0 || format.scale > bocan::Decimal::MAX_SCALE) {
+				std::cerr << ">ERROR. DECIMAL SCALE MUST BE FROM 0 TO " << bocan::Decimal::MAX_SCALE << "." << std::endl;
+				return 1;
+			}
+		} else if(std::strcmp(option, "--round") == 0) {
+			if(bocan::ParseRoundingMode(value, &format.rounding)) {
+				std::cerr << ">ERROR. UNKNOWN ROUNDING MODE '" << value << "'." << std::endl;
+				return 1;
+			}
+		} else if(std::strcmp(option, "--parallel") == 0) {
+			parallel = std::strtoul(value, nullptr, 10);
+			if(parallel == 0) { parallel = std::thread::hardware_concurrency(); }
+		} else {
+			args.push_back(argv[i]);
+		}
+	}
+	bocan::CountAllocations(stats);
+
+	unsigned long cache = cache_value ? std::strtoul(cache_value, nullptr, 10) : 0;
+
+	// the first argument that is not an option, unless it is '-' for stdin
+	const char* input = (args.size() > 1 && std::strcmp(args[1], "-") != 0) ? args[1] : nullptr;
+
+	// serve mode: calc.out --serve PATH [--cache N] [--stats]. answers clients on a unix domain socket until interrupted.
+	if(socket_path) {
+
+		bocan::Server server(cache);
+		bocan::SolveStats totals;
+		if(stats) { server.SetStats(&totals); }
+		if(server.Listen(socket_path)) { return 1; }
+
+		g_server = &server;
+		std::signal(SIGINT, StopServer);
+		std::signal(SIGTERM, StopServer);
+
+		std::fprintf(stderr, ">SERVING ON '%s'\n", socket_path);
+		bool err = server.Run();
+		g_server = nullptr;
+
+		const bocan::LatencyHistogram& latency = server.GetHistogram();
+		std::fprintf(stderr, ">SERVE %lu CONNECTIONS %lu REQUESTS %lu ERRORS P50 %.3f P99 %.3f P999 %.3f US\n",
+			server.GetConnectionCount(), server.GetRequestCount(), server.GetErrorCount(),
+			latency.GetPercentile(0.5) / 1e3, latency.GetPercentile(0.99) / 1e3, latency.GetPercentile(0.999) / 1e3);
+
+		if(stats) { PrintStats(totals, stats_json); }
+		return err ? 1 : 0;
+	}
+
+	// batch mode: calc.out --batch [--threads N] [--cache N] [--bigint] [--decimal SCALE [--round MODE]] [--stats] [file].
+	// reads stdin if no file (or '-') is given. --threads or --cache on their own imply --batch.
+	if(batch || threads_value || cache_value) {
+
+		unsigned long threads = threads_value ? std::strtoul(threads_value, nullptr, 10) : 1;
+		if(threads == 0) { threads = std::thread::hardware_concurrency(); }
+
+		bocan::Batch batch(static_cast<unsigned int>(threads), cache);
+		batch.SetNumbers(bigint, decimal ? &format : nullptr);
+		if(stats) { batch.EnableStats(); }
+		int result = batch.Run(input);
+
+		if(stats) {
+			bocan::SolveStats totals;
+			batch.GetStats(&totals);
+			PrintStats(totals, stats_json);
+		}
+		return result;
+	}
+
+	// stream mode: calc.out --stream [file]. solves one expression of any length, read in chunks from the file or stdin.
+	if(stream) {
+
+		std::FILE* in = stdin;
+		if(input) {
+			in = std::fopen(input, "rb");
+			if(!in) {
+				std::cerr << ">ERROR. UNABLE TO OPEN FILE '" << input << "'." << std::endl;
+				return 1;
+			}
+		}
+
+		auto start = std::chrono::steady_clock::now();
+
+		bocan::StreamSolver stream;
+		bocan::Solution solution;
+		bool err = stream.Solve(in, &solution);
+		if(in != stdin) { std::fclose(in); }
+
+		if(err) {
+			std::cerr << ">ERROR " << solution.error_code << " AT BYTE " << solution.error_pos << ". " << bocan::GetErrorMessage(solution.error_code) << std::endl;
+		} else {
+			char buffer[bocan::FORMAT_SIZE];
+			std::size_t len = solution.floating ? bocan::FormatDouble(solution.real, buffer) : bocan::FormatInteger(solution.integer, buffer);
+			std::cout.write(buffer, len) << std::endl;
+		}
+
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		std::fprintf(stderr, ">STREAM %zu BYTES %zu DEEPEST STACK %.6f SECONDS\n", stream.GetByteCount(), stream.GetDeepestStack(), elapsed.count());
+		return err ? 1 : 0;
+	}
+
+	// calc.out --compile-to FILE [input]. compiles every line of the input, or of stdin, and saves the programs.
+	if(compile_to) {
+
+		auto start = std::chrono::steady_clock::now();
+
+		bocan::MappedFile file;
+		std::string text;
+		const char* data = nullptr;
+		std::size_t size = 0;
+
+		// regular files are mapped, pipes and stdin are read whole
+		if(input && !file.Open(input)) {
+			data = file.Data();
+			size = file.Size();
+		} else {
+			std::FILE* in = input ? std::fopen(input, "rb") : stdin;
+			if(!in) {
+				std::cerr << ">ERROR. UNABLE TO OPEN FILE '" << input << "'." << std::endl;
+				return 1;
+			}
+			char buffer[1 << 16];
+			std::size_t count = 0;
+			while((count = std::fread(buffer, 1, sizeof(buffer), in)) > 0) { text.append(buffer, count); }
+			if(input) { std::fclose(in); }
+			data = text.data();
+			size = text.size();
+		}
+
+		unsigned long errors = 0;
+		if(bocan::ProgramFile::Write(data, size, compile_to, &errors)) {
+			std::cerr << ">ERROR. UNABLE TO WRITE FILE '" << compile_to << "'." << std::endl;
+			return 1;
+		}
+
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		std::fprintf(stderr, ">COMPILED %lu ERRORS %.6f SECONDS\n", errors, elapsed.count());
+		return 0;
+	}
+
+	// calc.out --load FILE. runs every program of a file written by --compile-to and writes the results as batch mode does.
+	if(load) {
+
+		auto start = std::chrono::steady_clock::now();
+
+		bocan::ProgramFile programs;
+		if(programs.Open(load)) {
+			std::cerr << ">ERROR. UNABLE TO LOAD '" << load << "'. " << programs.GetFailure() << "." << std::endl;
+			return 1;
+		}
+
+		std::chrono::duration<double> loaded = std::chrono::steady_clock::now() - start;
+
+		bocan::Vm vm;
+		bocan::BytecodeView view;
+		bocan::Solution solution;
+		std::vector<char> output;
+		unsigned long errors = 0;
+
+		for(std::size_t i = 0; i < programs.GetCount(); i++) {
+
+			if(output.size() > (1 << 16)) {
+				std::fwrite(output.data(), 1, output.size(), stdout);
+				output.clear();
+			}
+
+			char buffer[bocan::FORMAT_SIZE + 16];
+			std::size_t len = 0;
+
+			bool err = programs.Get(i, &view, &solution) || vm.Run(view, nullptr, &solution);
+			if(err && solution.error_code != bocan::NO_ERROR) {
+				errors++;
+				len = static_cast<std::size_t>(std::snprintf(buffer, sizeof(buffer), "ERROR %d", static_cast<int>(solution.error_code)));
+			} else if(!err) {
+				len = solution.floating ? bocan::FormatDouble(solution.real, buffer) : bocan::FormatInteger(solution.integer, buffer);
+			}
+			output.insert(output.end(), buffer, buffer + len);
+			output.push_back('\n');
+		}
+		std::fwrite(output.data(), 1, output.size(), stdout);
+		std::fflush(stdout);
+
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		std::fprintf(stderr, ">LOAD %zu PROGRAMS %lu ERRORS %.6f SECONDS TO LOAD %.6f SECONDS IN TOTAL\n", programs.GetCount(), errors, loaded.count(), elapsed.count());
+		return 0;
+	}
+
+	// calc.out --disassemble 'expression'. prints the bytecode the expression compiles to.
+	if(disassemble) {
+
+		bocan::Solver solver;
+		bocan::Bytecode program;
+		bocan::Solution solution;
+
+		if(solver.Compile(disassemble, std::strlen(disassemble), &program, &solution, true)) {
+			std::cerr << ">ERROR " << solution.error_code << ". " << bocan::GetErrorMessage(solution.error_code) << std::endl;
+			return 1;
+		}
+		return bocan::Disassemble(program.View(), stdout);
+	}
+
+	// calc.out [--bigint] [--decimal SCALE [--round MODE]] [--parallel N] ['expression'].
+	// --bigint solves integer expressions exactly, however large. --decimal solves every expression
+	// with exact decimals of SCALE places, rounded with MODE (half-even unless given). --parallel solves
+	// the nodes of a very large expression with N threads.
+	bocan::Calculator calculator;
+	bocan::SolveStats totals;
+	std::unique_ptr<bocan::ThreadPool> pool;
  
-	calculator.Initialize();
+	calculator.Initialize(bigint, decimal ? &format : nullptr);
+	if(stats) { calculator.SetStats(&totals); }
+	if(parallel > 1) {
+		pool.reset(new bocan::ThreadPool(static_cast<unsigned int>(parallel)));
+		calculator.SetPool(pool.get());
+	}
 
 	do {
-		if(!calculator.Input(argc, argv)) {
+		if(!calculator.Input(static_cast<int>(args.size()), args.data())) {
 			calculator.Solve();
 			calculator.Output();
 		}
 	} while (!calculator.CheckExitFlag());
 
+	if(stats) { PrintStats(totals, stats_json); }
 	return 0;
 }
@@ -0,0 +1,99 @@
+//
+// MAPPED_FILE.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstddef>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mapped_file.hpp"
+
+using bocan::MappedFile;
+
+///
+/// @brief maps a regular file into memory for reading.
+/// @param[in] char pointer to the path of the file.
+/// @return 0 if the file is mapped. 1 if the file cannot be opened, is not a regular file, is empty or cannot be mapped.
+/// @todo
+///
+bool MappedFile::Open(const char* path) {
+
+	Close();
+
+	int fd = ::open(path, O_RDONLY);
+	if(fd < 0) { return 1; }
+
+	struct stat info;
+	if(::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0) {
+		::close(fd);
+		return 1;
+	}
+
+	void* data = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// the mapping keeps its own reference to the file
+	::close(fd);
+	if(data == MAP_FAILED) { return 1; }
+
+	// the file is read front to back, so ask the kernel to read ahead aggressively
+	::madvise(data, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+
+	long page_size = ::sysconf(_SC_PAGESIZE);
+	if(page_size > 0) { m_page_size = static_cast<std::size_t>(page_size); }
+
+	m_data = static_cast<const char*>(data);
+	m_size = static_cast<std::size_t>(info.st_size);
+	m_released = 0;
+	return 0;
+}
+
+///
+/// @brief unmaps the file if one is mapped.
+/// @param
+/// @return
+/// @todo
+///
+void MappedFile::Close() {
+	if(m_data) {
+		::munmap(const_cast<char*>(m_data), m_size);
+		m_data = nullptr;
+		m_size = 0;
+		m_released = 0;
+	}
+}
+
+///
+/// @brief drops the pages before the given offset from this process. the file data stays in the page cache.
+/// @param[in] size_t is the offset up to which the file has been read. rounded down to a page boundary.
+/// @return
+/// @todo
+///
+void MappedFile::Release(std::size_t end) {
+
+	if(!m_data || end > m_size) { return; }
+
+	end -= end % m_page_size;
+	if(end <= m_released) { return; }
+
+	::madvise(const_cast<char*>(m_data) + m_released, end - m_released, MADV_DONTNEED);
+	m_released = end;
+}
@@ -0,0 +1,55 @@
+//
+// MAPPED_FILE.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+
+namespace bocan {
+
+// read-only view of a whole file mapped into memory.
+// pages that have been read can be handed back with Release() so resident memory stays flat
+// while a large file is scanned front to back.
+class MappedFile {
+
+public:
+	MappedFile() {}
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile() { Close(); }
+
+	bool	Open(const char*);
+	void	Close();
+	void	Release(std::size_t);
+
+	const char*	Data() const { return m_data; }
+	std::size_t	Size() const { return m_size; }
+
+private:
+	const char*	m_data = nullptr;
+	std::size_t	m_size = 0;
+	std::size_t	m_released = 0;
+	std::size_t	m_page_size = 4096;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// MAPPED_FILE_HPP
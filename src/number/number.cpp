@@ -0,0 +1,222 @@
+//
+// NUMBER.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+
+#include "number.hpp"
+
+namespace {
+
+// every power of ten up to 10^22 is exactly representable as a double
+const double k_powers[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+const int MAX_EXACT_POWER = 22;
+const std::uint64_t MAX_EXACT_MANTISSA = std::uint64_t(1) << 53;
+
+// literals longer than this are copied to the heap for std::strtod
+const std::size_t BUFFER_SIZE = 128;
+
+// "00" to "99", so integers are written two digits per step
+const char k_digit_pairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+///
+/// @brief converts a literal with the C library, after copying it so it is null terminated.
+/// @param[in] char pointer to the literal.
+/// @param[in] size_t is the length of the literal.
+/// @return double nearest to the literal.
+/// @todo
+///
+double ParseSlow(const char* digits, std::size_t len) {
+
+	if(len < BUFFER_SIZE) {
+		char buffer[BUFFER_SIZE];
+		std::memcpy(buffer, digits, len);
+		buffer[len] = '\0';
+		return std::strtod(buffer, nullptr);
+	}
+
+	std::string copy(digits, len);
+	return std::strtod(copy.c_str(), nullptr);
+}
+
+} // NAMESPACE
+
+///
+/// @brief converts a numeric literal in a single pass. the significant digits are gathered into an integer
+/// @brief and the position of the radix point and the exponent into a power of ten. when both the integer and
+/// @brief the power of ten are exact doubles, one multiplication or division gives the correctly rounded result.
+/// @param[in] char pointer to the first character of the literal.
+/// @param[in] size_t is the number of characters.
+/// @return double nearest to the literal.
+/// @todo
+///
+double bocan::ParseDouble(const char* digits, std::size_t len) {
+
+	std::uint64_t mantissa = 0;
+	int significant = 0;
+	int exponent = 0;
+	bool exact = true;
+	std::size_t i = 0;
+
+	// leading zeros are not significant
+	while(i < len && digits[i] == '0') { i++; }
+
+	for(; i < len && digits[i] >= '0' && digits[i] <= '9'; i++) {
+		if(significant < 19) {
+			mantissa = mantissa * 10 + static_cast<unsigned>(digits[i] - '0');
+			if(mantissa) { significant++; }
+		} else {
+			exact = false;
+		}
+	}
+
+	if(i < len && digits[i] == '.') {
+		for(i++; i < len && digits[i] >= '0' && digits[i] <= '9'; i++) {
+			if(significant < 19) {
+				mantissa = mantissa * 10 + static_cast<unsigned>(digits[i] - '0');
+				if(mantissa) { significant++; }
+				exponent--;
+			} else {
+				exact = false;
+			}
+		}
+	}
+
+	if(i < len && (digits[i] == 'e' || digits[i] == 'E')) {
+
+		bool negative = false;
+		int power = 0;
+
+		i++;
+		if(i < len && (digits[i] == '+' || digits[i] == '-')) {
+			negative = digits[i] == '-';
+			i++;
+		}
+
+		// the value of a huge exponent no longer matters once it is clamped
+		for(; i < len && digits[i] >= '0' && digits[i] <= '9'; i++) {
+			if(power < 100000) { power = power * 10 + (digits[i] - '0'); }
+		}
+		exponent += negative ? -power : power;
+	}
+
+	if(mantissa == 0) { return 0; }
+
+	if(exact && mantissa <= MAX_EXACT_MANTISSA) {
+
+		if(exponent >= 0 && exponent <= MAX_EXACT_POWER) {
+			return static_cast<double>(mantissa) * k_powers[exponent];
+		}
+		if(exponent < 0 && exponent >= -MAX_EXACT_POWER) {
+			return static_cast<double>(mantissa) / k_powers[-exponent];
+		}
+
+		// a small mantissa can absorb part of a large exponent and stay exact, as in 12e25
+		if(exponent > MAX_EXACT_POWER && exponent <= MAX_EXACT_POWER + 15) {
+			std::uint64_t scaled = mantissa;
+			int extra = exponent - MAX_EXACT_POWER;
+			for(; extra > 0 && scaled <= MAX_EXACT_MANTISSA / 10; extra--) { scaled *= 10; }
+			if(extra == 0) { return static_cast<double>(scaled) * k_powers[MAX_EXACT_POWER]; }
+		}
+	}
+
+	return ParseSlow(digits, len);
+}
+
+///
+/// @brief formats a double as the shortest text that converts back to the same value.
+/// @brief the standard library's shortest to_chars is used where it exists. elsewhere the precision is raised
+/// @brief from 15 to 17 significant digits until the text round trips, which 17 digits always does.
+/// @param[in] double is the value.
+/// @param[out] char pointer to a buffer of at least FORMAT_SIZE characters.
+/// @return the number of characters written.
+/// @todo
+///
+std::size_t bocan::FormatDouble(double value, char* buffer) {
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+	return static_cast<std::size_t>(std::to_chars(buffer, buffer + FORMAT_SIZE, value).ptr - buffer);
+#else
+	int len = 0;
+	for(int precision = 15; precision <= 17; precision++) {
+		len = std::snprintf(buffer, FORMAT_SIZE, "%.*g", precision, value);
+		if(std::strtod(buffer, nullptr) == value) { break; }
+	}
+	return static_cast<std::size_t>(len);
+#endif
+}
+
+///
+/// @brief formats a long in decimal. the digits are produced from the right, two at a time, then moved to the front.
+/// @param[in] long is the value.
+/// @param[out] char pointer to a buffer of at least FORMAT_SIZE characters.
+/// @return the number of characters written.
+/// @todo
+///
+std::size_t bocan::FormatInteger(long value, char* buffer) {
+
+	char digits[FORMAT_SIZE];
+	char* end = digits + FORMAT_SIZE;
+	char* p = end;
+
+	// the magnitude of the most negative long does not fit in a long
+	std::uint64_t magnitude = value < 0 ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+
+	while(magnitude >= 100) {
+		unsigned pair = static_cast<unsigned>(magnitude % 100) * 2;
+		magnitude /= 100;
+		*--p = k_digit_pairs[pair + 1];
+		*--p = k_digit_pairs[pair];
+	}
+	if(magnitude >= 10) {
+		unsigned pair = static_cast<unsigned>(magnitude) * 2;
+		*--p = k_digit_pairs[pair + 1];
+		*--p = k_digit_pairs[pair];
+	} else {
+		*--p = static_cast<char>('0' + magnitude);
+	}
+	if(value < 0) { *--p = '-'; }
+
+	std::size_t len = static_cast<std::size_t>(end - p);
+	std::memcpy(buffer, p, len);
+	return len;
+}
@@ -0,0 +1,45 @@
+//
+// NUMBER.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef NUMBER_HPP
+#define NUMBER_HPP
+
+#include <cstddef>
+
+namespace bocan {
+
+// converts a numeric literal to the nearest double, bit-identical to std::strtod.
+// the literal is digits with an optional radix point and an optional exponent, as in 12, 0.5, .5, 5. or 1.5e-3.
+// it need not be null terminated. most literals are converted exactly with one multiplication or division,
+// the rest fall back to std::strtod.
+double	ParseDouble(const char*, std::size_t);
+
+// writes the shortest text that ParseDouble() converts back to exactly the same double, as in 0.1, 1e-07 or 1.5e+20.
+// the buffer must hold FORMAT_SIZE characters. no null terminator is written and nothing is allocated.
+std::size_t	FormatDouble(double, char*);
+
+// writes a long in decimal into a buffer of FORMAT_SIZE characters, two digits at a time.
+std::size_t	FormatInteger(long, char*);
+
+const std::size_t FORMAT_SIZE = 32;
+
+} // NAMESPACE BOCAN
+
+#endif	// NUMBER_HPP
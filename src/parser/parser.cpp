@@ -0,0 +1,428 @@
+//
+// PARSER.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "parser.hpp"
+#include "../number/number.hpp"
+
+using bocan::Parser;
+
+namespace {
+
+// literals are short, so comparing them in place is faster than calling memcmp
+inline bool SameText(const char* a, const char* b, unsigned int len) {
+	for(unsigned int i = 0; i < len; i++) {
+		if(a[i] != b[i]) { return false; }
+	}
+	return true;
+}
+
+} // NAMESPACE
+using bocan::Token;
+
+///
+/// @brief builds the syntax tree for a tokenized expression using precedence climbing.
+/// @brief the order of operations, PEMDAS, is encoded in the operator precedence. operators of equal precedence are left associative.
+/// @param[in] char pointer to the expression the tokens refer to.
+/// @param[in] vector reference to the tokens produced by the lexer.
+/// @param[in] boolean true if the expression is solved with doubles, false if it is solved with longs.
+/// @param[out] Ast pointer receiving the nodes and constants. the vectors keep their capacity between calls.
+/// @return 0 if the tree was built, 1 if the tokens do not form a valid expression.
+/// @todo
+///
+bool Parser::Parse(const char* expr, const std::vector<Token>& tokens, bool floating, Ast* ast) {
+
+	m_expr = expr;
+	m_tokens = tokens.data();
+	m_count = tokens.size();
+	m_current = 0;
+	m_depth = 0;
+	m_ast = ast;
+	m_error_code = NO_ERROR;
+	m_error_pos = 0;
+
+	ast->nodes.clear();
+	ast->integers.clear();
+	ast->floats.clear();
+	ast->variables.clear();
+	ast->floating = floating;
+	ast->shared = 0;
+
+	// short expressions repeat little, and are parsed faster without looking
+	m_sharing = m_share && m_count >= MIN_SHARED_TOKENS;
+
+	if(m_sharing) {
+		if(m_table.empty()) {
+			m_table.assign(MIN_TABLE_SIZE, entry{ 0, 0 });
+			m_mask = MIN_TABLE_SIZE - 1;
+		}
+
+		// the entries of every earlier expression become empty
+		if(++m_generation == 0) {
+			std::fill(m_table.begin(), m_table.end(), entry{ 0, 0 });
+			m_generation = 1;
+		}
+	}
+
+	unsigned int root = 0;
+
+	if(ParseExpression(1, &root)) { return 1; }
+
+	// every token must belong to the tree
+	if(m_current != m_count) { return SetError(SOLVE_ERROR, m_tokens[m_current].pos); }
+
+	return 0;
+}
+
+///
+/// @brief parses a chain of binary operators with a precedence of at least the minimum.
+/// @param[in] integer is the minimum operator precedence accepted at this level.
+/// @param[out] unsigned integer pointer receiving the index of the node for the chain.
+/// @return 0 if the chain was parsed, 1 on error.
+/// @todo
+///
+bool Parser::ParseExpression(int min_precedence, unsigned int* index) {
+
+	unsigned int lhs = 0;
+	unsigned int rhs = 0;
+
+	if(ParseUnary(&lhs)) { return 1; }
+
+	while(m_current < m_count) {
+
+		const Token& oper = m_tokens[m_current];
+		int precedence = GetPrecedence(oper.type);
+
+		if(precedence == 0 || precedence < min_precedence) { break; }
+		m_current++;
+
+		// the right operand only takes operators that bind tighter, which makes equal precedence left associative
+		if(ParseExpression(precedence + 1, &rhs)) { return 1; }
+
+		switch(oper.type) {
+			case TOKEN_PLUS:		lhs = Emit(NODE_ADD, lhs, rhs, oper.pos); break;
+			case TOKEN_MINUS:		lhs = Emit(NODE_SUBTRACT, lhs, rhs, oper.pos); break;
+			case TOKEN_MULTIPLY:	lhs = Emit(NODE_MULTIPLY, lhs, rhs, oper.pos); break;
+			case TOKEN_DIVIDE:		lhs = Emit(NODE_DIVIDE, lhs, rhs, oper.pos); break;
+			default:				lhs = Emit(NODE_POWER, lhs, rhs, oper.pos); break;
+		}
+	}
+
+	*index = lhs;
+	return 0;
+}
+
+///
+/// @brief parses a negative sign and its operand. a negative sign binds tighter than any binary operator, so -2^2 is 4.
+/// @param[out] unsigned integer pointer receiving the index of the node.
+/// @return 0 if the operand was parsed, 1 on error.
+/// @todo
+///
+bool Parser::ParseUnary(unsigned int* index) {
+
+	if(m_current < m_count && m_tokens[m_current].type == TOKEN_MINUS) {
+
+		unsigned int pos = m_tokens[m_current].pos;
+		unsigned int operand = 0;
+
+		m_current++;
+		if(ParseUnary(&operand)) { return 1; }
+
+		*index = Emit(NODE_NEGATE, operand, 0, pos);
+		return 0;
+	}
+	return ParsePrimary(index);
+}
+
+///
+/// @brief parses a number, a variable or a parenthesized expression.
+/// @param[out] unsigned integer pointer receiving the index of the node.
+/// @return 0 if the operand was parsed, 1 on error.
+/// @todo
+///
+bool Parser::ParsePrimary(unsigned int* index) {
+
+	if(m_current >= m_count) {
+		return SetError(INVALID_INPUT_OPERATOR_LAST, m_count ? m_tokens[m_count - 1].pos : 0);
+	}
+
+	const Token& token = m_tokens[m_current];
+
+	switch(token.type) {
+
+		case TOKEN_NUMBER:
+			m_current++;
+			*index = EmitNumber(token);
+			return 0;
+
+		case TOKEN_VARIABLE:
+			m_current++;
+			*index = EmitVariable(token);
+			return 0;
+
+		case TOKEN_LEFT_PAREN: {
+
+			std::size_t open = m_current;
+
+			// a group solved before is replaced by its value without looking at its tokens
+			if(m_groups && (*m_groups)[open].known) {
+				m_current = (*m_groups)[open].close + 1;
+				*index = EmitKnown((*m_groups)[open], token.pos);
+				return 0;
+			}
+
+			if(++m_depth > MAX_DEPTH) { return SetError(SOLVE_ERROR, token.pos); }
+			m_current++;
+
+			if(ParseExpression(1, index)) { return 1; }
+
+			if(m_current >= m_count || m_tokens[m_current].type != TOKEN_RIGHT_PAREN) {
+				return SetError(INVALID_INPUT_PARENTHESES_MISMATCH, token.pos);
+			}
+			m_current++;
+			m_depth--;
+
+			if(m_groups) {
+				(*m_groups)[open].parsed = true;
+				(*m_groups)[open].node = *index;
+			}
+			return 0;
+		}
+
+		default:
+			return SetError(SOLVE_ERROR, token.pos);
+	}
+}
+
+///
+/// @brief appends a node to the tree, unless the same node is already in it. a node is the same if it applies
+/// @brief the same operator to the same children, or names the same variable, so its value is always the same.
+/// @param[in] node_type of the node.
+/// @param[in] unsigned integer is the left child, operand or constant index.
+/// @param[in] unsigned integer is the right child.
+/// @param[in] unsigned integer is the position of the operator within the expression.
+/// @return the index of the node.
+/// @todo
+///
+unsigned int Parser::Emit(node_type type, unsigned int lhs, unsigned int rhs, unsigned int pos) {
+
+	if(!m_sharing) { return Append(Node{ type, lhs, rhs, pos }); }
+
+	std::size_t slot = Find(type, lhs, rhs, pos);
+	if(m_table[slot].generation == m_generation) {
+		m_ast->shared++;
+		return m_table[slot].index;
+	}
+
+	unsigned int index = Append(Node{ type, lhs, rhs, pos });
+	Insert(slot, index);
+	return index;
+}
+
+///
+/// @brief appends a node to the tree without looking for the same node.
+/// @param[in] Node reference to the node.
+/// @return the index of the new node.
+/// @todo
+///
+unsigned int Parser::Append(const Node& node) {
+	m_ast->nodes.push_back(node);
+	return static_cast<unsigned int>(m_ast->nodes.size() - 1);
+}
+
+///
+/// @brief looks for a node in the table. numbers are found by the text of their literal, as the same literal
+/// @brief has the same value whether it is read as a long, a double, a big integer or a decimal.
+/// @param[in] node_type of the node.
+/// @param[in] unsigned integer is the left child, operand or variable index. unused for numbers.
+/// @param[in] unsigned integer is the right child, or the length of a number's literal.
+/// @param[in] unsigned integer is the position of a number's literal.
+/// @return the slot holding the node, or the empty slot where it belongs.
+/// @todo
+///
+std::size_t Parser::Find(node_type type, unsigned int lhs, unsigned int rhs, unsigned int pos) const {
+
+	const std::uint64_t k_multiplier = 0x9E3779B97F4A7C15ULL;
+	std::uint64_t hash = static_cast<std::uint64_t>(type);
+
+	if(type == NODE_NUMBER) {
+
+		// eight characters of the literal at a time
+		unsigned int i = 0;
+		for(; i + 8 <= rhs; i += 8) {
+			std::uint64_t word = 0;
+			std::memcpy(&word, m_expr + pos + i, 8);
+			hash = (hash ^ word) * k_multiplier;
+		}
+		if(i < rhs) {
+			std::uint64_t word = 0;
+			for(; i < rhs; i++) { word = (word << 8) | static_cast<unsigned char>(m_expr[pos + i]); }
+			hash = (hash ^ word) * k_multiplier;
+		}
+	} else {
+		hash = (hash ^ lhs) * k_multiplier;
+		hash = (hash ^ rhs) * k_multiplier;
+	}
+	hash ^= hash >> 32;
+
+	const Node* nodes = m_ast->nodes.data();
+	std::size_t slot = static_cast<std::size_t>(hash) & m_mask;
+
+	while(m_table[slot].generation == m_generation) {
+		const Node& node = nodes[m_table[slot].index];
+		if(node.type == type) {
+			if(type == NODE_NUMBER) {
+				if(node.rhs == rhs && SameText(m_expr + node.pos, m_expr + pos, rhs)) { return slot; }
+			} else if(node.lhs == lhs && node.rhs == rhs) {
+				return slot;
+			}
+		}
+		slot = (slot + 1) & m_mask;
+	}
+	return slot;
+}
+
+///
+/// @brief stores a new node in the empty slot found for it. the table is doubled once it is half full.
+/// @brief sharing is switched off for the rest of the expression once enough nodes show it repeats too little.
+/// @param[in] size_t is the slot returned by Find().
+/// @param[in] unsigned integer is the index of the node.
+/// @return
+/// @todo
+///
+void Parser::Insert(std::size_t slot, unsigned int index) {
+
+	m_table[slot] = entry{ m_generation, index };
+
+	// input without repeats stops paying for the table early on
+	std::size_t stored = m_ast->nodes.size();
+	if(stored >= SHARED_WINDOW && m_ast->shared * SHARED_RATIO < stored) {
+		m_sharing = false;
+		return;
+	}
+
+	if(stored * 2 <= m_table.size()) { return; }
+
+	std::vector<entry> old(m_table.size() * 2, entry{ 0, 0 });
+	old.swap(m_table);
+	m_mask = m_table.size() - 1;
+
+	for(const entry& e : old) {
+		if(e.generation != m_generation) { continue; }
+		const Node& node = m_ast->nodes[e.index];
+		m_table[Find(node.type, node.lhs, node.rhs, node.pos)] = e;
+	}
+}
+
+///
+/// @brief converts a number token to a constant of the expression's type and appends a node for it.
+/// @param[in] token reference to the number.
+/// @return the index of the new node.
+/// @todo
+///
+unsigned int Parser::EmitNumber(const Token& token) {
+
+	// a literal seen before is neither converted nor stored again
+	std::size_t slot = 0;
+	if(m_sharing) {
+		slot = Find(NODE_NUMBER, 0, token.len, token.pos);
+		if(m_table[slot].generation == m_generation) {
+			m_ast->shared++;
+			return m_table[slot].index;
+		}
+	}
+
+	PhaseTimer timer(m_stats, STAT_LITERALS);
+	unsigned int constant = 0;
+
+	if(m_ast->floating) {
+		constant = static_cast<unsigned int>(m_ast->floats.size());
+		m_ast->floats.push_back(ParseDouble(m_expr + token.pos, token.len));
+	} else {
+		constant = static_cast<unsigned int>(m_ast->integers.size());
+		m_ast->integers.push_back(ParseInteger(m_expr + token.pos, token.len));
+	}
+
+	unsigned int index = Append(Node{ NODE_NUMBER, constant, token.len, token.pos });
+	if(m_sharing) { Insert(slot, index); }
+	return index;
+}
+
+///
+/// @brief appends a node for a variable. every use of the same name shares one variable index.
+/// @param[in] token reference to the name.
+/// @return the index of the new node.
+/// @todo
+///
+unsigned int Parser::EmitVariable(const Token& token) {
+
+	std::vector<Token>& variables = m_ast->variables;
+	unsigned int variable = 0;
+
+	for(; variable < variables.size(); variable++) {
+		const Token& name = variables[variable];
+		if(name.len == token.len && std::memcmp(m_expr + name.pos, m_expr + token.pos, token.len) == 0) { break; }
+	}
+
+	if(variable == variables.size()) { variables.push_back(token); }
+
+	return Emit(NODE_VARIABLE, variable, 0, token.pos);
+}
+
+///
+/// @brief appends a number node holding the known value of a parenthesized group.
+/// @param[in] Group reference to the group and its value.
+/// @param[in] unsigned integer is the position of the group's '(' within the expression.
+/// @return the index of the new node.
+/// @todo
+///
+unsigned int Parser::EmitKnown(const Group& group, unsigned int pos) {
+
+	unsigned int constant = 0;
+
+	if(m_ast->floating) {
+		constant = static_cast<unsigned int>(m_ast->floats.size());
+		m_ast->floats.push_back(group.real);
+	} else {
+		constant = static_cast<unsigned int>(m_ast->integers.size());
+		m_ast->integers.push_back(group.integer);
+	}
+
+	// a known value has no literal to compare, so it is never shared
+	return Append(Node{ NODE_NUMBER, constant, 0, pos });
+}
+
+///
+/// @brief records the first error found while parsing.
+/// @param[in] enumerator corresponding to the error_code enum.
+/// @param[in] size_t is the position of the offending token.
+/// @return always 1, so callers can return the result directly.
+/// @todo
+///
+bool Parser::SetError(errors error_code, std::size_t pos) {
+	m_error_code = error_code;
+	m_error_pos = pos;
+	return 1;
+}
@@ -0,0 +1,145 @@
+//
+// PARSER.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef PARSER_HPP
+#define PARSER_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "../calculator/errors.hpp"
+#include "../lexer/lexer.hpp"
+#include "../stats/stats.hpp"
+
+namespace bocan {
+
+// node types use the operator character so they can be passed straight to PerformMathOperation().
+enum node_type : char {
+	NODE_NUMBER = '#',
+	NODE_VARIABLE = '$',
+	NODE_NEGATE = '~',
+	NODE_ADD = '+',
+	NODE_SUBTRACT = '-',
+	NODE_MULTIPLY = '*',
+	NODE_DIVIDE = '/',
+	NODE_POWER = '^'
+};
+
+// a node of the syntax tree. children always come before their parent,
+// so the tree can be evaluated by a single pass from the first node to the last.
+// a number node stores the index of its constant in lhs and the length of its literal in rhs,
+// a variable node the index of its variable, and a negate node stores its operand in lhs.
+// identical subtrees are stored once, so a node may be the child of more than one parent.
+struct Node {
+	node_type		type;
+	unsigned int	lhs;
+	unsigned int	rhs;
+	unsigned int	pos;
+};
+
+// the parsed expression. the root is the last node.
+// each distinct variable is listed once, by the token of its first use.
+struct Ast {
+	std::vector<Node>	nodes;
+	std::vector<long>	integers;
+	std::vector<double>	floats;
+	std::vector<Token>	variables;
+	bool				floating;
+	std::size_t			shared = 0;		// nodes that were found already in the tree instead of being added again
+};
+
+// a parenthesized group, stored at the index of its '(' token. a group that was solved before is not
+// parsed again, it becomes a single number with its known value. any other group gets the index of the
+// node holding its value, so the caller can read the value back after evaluation.
+struct Group {
+	unsigned int	close = 0;		// token index of the matching ')'
+	bool			known = false;
+	long			integer = 0;
+	double			real = 0;
+	bool			parsed = false;
+	unsigned int	node = 0;
+};
+
+class Parser {
+
+public:
+	bool	Parse(const char*, const std::vector<Token>&, bool, Ast*);
+	void	SetGroups(std::vector<Group>* groups) { m_groups = groups; }
+	void	SetStats(SolveStats* stats) { m_stats = stats; }
+	void	SetSharing(bool share) { m_share = share; }
+
+	errors		GetErrorCode() const { return m_error_code; }
+	std::size_t	GetErrorPosition() const { return m_error_pos; }
+
+	// the first size of the table of nodes used to find repeated subtrees. it doubles as needed, and is kept
+	static const std::size_t MIN_TABLE_SIZE = 1024;
+
+	// expressions of fewer tokens are parsed without looking for repeated subtrees
+	static const std::size_t MIN_SHARED_TOKENS = 64;
+
+	// once this many nodes are stored, an expression with fewer than one shared node for every
+	// SHARED_RATIO stored repeats too little to pay for the lookups, and the rest is parsed without them
+	static const std::size_t SHARED_WINDOW = 128;
+	static const std::size_t SHARED_RATIO = 4;
+
+private:
+	bool	ParseExpression(int, unsigned int*);
+	bool	ParseUnary(unsigned int*);
+	bool	ParsePrimary(unsigned int*);
+
+	unsigned int	Emit(node_type, unsigned int, unsigned int, unsigned int);
+	unsigned int	Append(const Node&);
+	std::size_t		Find(node_type, unsigned int, unsigned int, unsigned int) const;
+	void			Insert(std::size_t, unsigned int);
+	unsigned int	EmitNumber(const Token&);
+	unsigned int	EmitVariable(const Token&);
+	unsigned int	EmitKnown(const Group&, unsigned int);
+
+	bool	SetError(errors, std::size_t);
+
+	const char*		m_expr = nullptr;
+	const Token*	m_tokens = nullptr;
+	std::size_t		m_count = 0;
+	std::size_t		m_current = 0;
+	int				m_depth = 0;
+	Ast*			m_ast = nullptr;
+	std::vector<Group>*	m_groups = nullptr;
+	SolveStats*			m_stats = nullptr;
+
+	// hash-consing: an open addressing table of nodes kept between calls. an entry stamped with an
+	// older generation is empty, so starting a new expression does not clear the table
+	struct entry {
+		unsigned int	generation;
+		unsigned int	index;
+	};
+
+	bool				m_share = true;
+	bool				m_sharing = false;	// this expression is long enough to look for repeats
+	std::vector<entry>	m_table;
+	std::size_t			m_mask = 0;
+	unsigned int		m_generation = 0;
+
+	errors		m_error_code = NO_ERROR;
+	std::size_t	m_error_pos = 0;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// PARSER_HPP
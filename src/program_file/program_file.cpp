@@ -0,0 +1,322 @@
+//
+// PROGRAM_FILE.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "program_file.hpp"
+
+using bocan::ProgramFile;
+
+namespace {
+
+// every section of the file starts on a boundary of this many bytes, so the constants can be read in place
+const std::size_t k_alignment = 8;
+
+} // NAMESPACE
+
+///
+/// @brief checks the file for damage. FNV-1a over 64 bit words, folding the high half of each product into the
+/// @brief low half so every bit of a word reaches every bit of the result. four words are hashed side by side,
+/// @brief as four independent chains are four times as fast as one. not meant to resist tampering.
+/// @param[in] unsigned char pointer to the data.
+/// @param[in] size_t is the length of the data, a multiple of eight.
+/// @return unsigned integer checksum.
+/// @todo
+///
+std::uint64_t ProgramFile::Checksum(const unsigned char* data, std::size_t size) {
+
+	const std::uint64_t prime = 0x100000001B3ULL;
+	std::uint64_t lanes[4] = { 0xCBF29CE484222325ULL, 0x84222325CBF29CE4ULL, 0x9CE484222325CBF2ULL, 0x2325CBF29CE48422ULL };
+	std::size_t words = size / 8;
+	std::size_t i = 0;
+
+	for(; i + 4 <= words; i += 4) {
+		for(int lane = 0; lane < 4; lane++) {
+			std::uint64_t word = 0;
+			std::memcpy(&word, data + (i + lane) * 8, sizeof(word));
+			lanes[lane] = (lanes[lane] ^ word) * prime;
+			lanes[lane] ^= lanes[lane] >> 32;
+		}
+	}
+	for(; i < words; i++) {
+		std::uint64_t word = 0;
+		std::memcpy(&word, data + i * 8, sizeof(word));
+		lanes[0] = (lanes[0] ^ word) * prime;
+		lanes[0] ^= lanes[0] >> 32;
+	}
+
+	std::uint64_t hash = lanes[0];
+	for(int lane = 1; lane < 4; lane++) {
+		hash = (hash ^ lanes[lane]) * prime;
+		hash ^= hash >> 32;
+	}
+	return hash;
+}
+
+///
+/// @brief compiles every line of a text and writes the programs to a file. blank lines and lines that do not
+/// @brief compile are kept as entries without a program, so entries and lines keep the same numbers.
+/// @param[in] char pointer to the text, one expression per line.
+/// @param[in] size_t is the length of the text.
+/// @param[in] char pointer to the path of the file to write.
+/// @param[out] unsigned long pointer receiving the number of lines that did not compile.
+/// @param[in] boolean true to compile names as variables, whose names are kept in the file. otherwise a line with a name does not compile.
+/// @return 0 if the file was written, 1 if it could not be.
+/// @todo
+///
+bool ProgramFile::Write(const char* text, std::size_t size, const char* path, unsigned long* errors, bool variables) {
+
+	Solver solver;
+	Bytecode program;
+	std::vector<program_file_entry> entries;
+	std::vector<unsigned char> programs;
+
+	*errors = 0;
+
+	// one entry per line. the last line may not end with a newline.
+	std::size_t lines = 0;
+	for(const char* p = text; (p = static_cast<const char*>(std::memchr(p, '\n', size - (p - text)))); p++) { lines++; }
+	if(size && text[size - 1] != '\n') { lines++; }
+
+	// programs follow the header and the entries
+	const std::uint64_t base = sizeof(program_file_header) + lines * sizeof(program_file_entry);
+
+	std::size_t begin = 0;
+	while(begin < size) {
+
+		const char* newline = static_cast<const char*>(std::memchr(text + begin, '\n', size - begin));
+		std::size_t end = newline ? static_cast<std::size_t>(newline - text) : size;
+		std::size_t length = end - begin;
+		if(length && text[end - 1] == '\r') { length--; }
+
+		program_file_entry entry = { 0, 0, NO_ERROR, 0 };
+		Solution solution;
+
+		if(length && solver.Compile(text + begin, length, &program, &solution, variables)) {
+			entry.error_code = solution.error_code;
+			entry.error_pos = static_cast<std::uint32_t>(solution.error_pos);
+			(*errors)++;
+		} else if(length) {
+
+			BytecodeView view = program.View();
+			entry.program = base + programs.size();
+			Append(&programs, view.header, sizeof(bytecode_header));
+			Append(&programs, view.code, view.header->code_size * sizeof(std::uint32_t));
+			Append(&programs, view.positions, view.header->code_size * sizeof(std::uint32_t));
+			Append(&programs, view.constants, view.header->constant_count * sizeof(std::uint64_t));
+
+			entry.names = base + programs.size();
+			for(std::size_t i = 0; i < solver.GetVariableCount(); i++) {
+				std::string_view name = solver.GetVariableName(i);
+				Append(&programs, name.data(), name.size());
+				programs.push_back(0);
+			}
+			programs.resize((programs.size() + k_alignment - 1) / k_alignment * k_alignment, 0);
+		}
+
+		entries.push_back(entry);
+		begin = end + 1;
+	}
+
+	std::vector<unsigned char> file;
+	program_file_header header = {};
+	Append(&file, &header, sizeof(header));
+	Append(&file, entries.data(), entries.size() * sizeof(program_file_entry));
+	Append(&file, programs.data(), programs.size());
+
+	header.magic = MAGIC;
+	header.version = VERSION;
+	header.bytecode_version = Bytecode::VERSION;
+	header.count = static_cast<std::uint32_t>(entries.size());
+	header.size = file.size();
+	header.checksum = Checksum(file.data() + sizeof(header), file.size() - sizeof(header));
+	std::memcpy(file.data(), &header, sizeof(header));
+
+	std::FILE* out = std::fopen(path, "wb");
+	if(!out) { return 1; }
+
+	bool err = std::fwrite(file.data(), 1, file.size(), out) != file.size();
+	if(std::fclose(out) != 0) { err = true; }
+	return err;
+}
+
+///
+/// @brief maps a file written by Write() and checks every part of it, so the programs can then be run without further checks.
+/// @param[in] char pointer to the path of the file.
+/// @return 0 if the file can be used, 1 if it cannot. GetFailure() then tells why.
+/// @todo
+///
+bool ProgramFile::Open(const char* path) {
+
+	Close();
+	m_failure = nullptr;
+
+	if(m_file.Open(path)) { return Fail("UNABLE TO OPEN OR MAP THE FILE"); }
+
+	if(Check()) {
+		Close();
+		return 1;
+	}
+	return 0;
+}
+
+///
+/// @brief unmaps the file if one is open.
+/// @param
+/// @return
+/// @todo
+///
+void ProgramFile::Close() {
+	m_file.Close();
+	m_entries = nullptr;
+	m_count = 0;
+}
+
+///
+/// @brief finds the program compiled from one line.
+/// @param[in] size_t is the number of the line, from zero.
+/// @param[out] BytecodeView pointer receiving the program. it points into the mapped file.
+/// @param[out] Solution pointer receiving the error of a line that did not compile. a blank line has no error.
+/// @return 0 if the line has a program, 1 if it is blank or did not compile.
+/// @todo
+///
+bool ProgramFile::Get(std::size_t index, BytecodeView* view, Solution* solution) const {
+
+	*solution = Solution();
+
+	const program_file_entry& entry = m_entries[index];
+	if(!entry.program) {
+		solution->error_code = static_cast<errors>(entry.error_code);
+		solution->error_pos = entry.error_pos;
+		return 1;
+	}
+
+	const unsigned char* data = reinterpret_cast<const unsigned char*>(m_file.Data()) + entry.program;
+	const bytecode_header* header = reinterpret_cast<const bytecode_header*>(data);
+	data += sizeof(bytecode_header);
+
+	view->header = header;
+	view->code = reinterpret_cast<const std::uint32_t*>(data);
+	view->positions = view->code + header->code_size;
+	view->constants = reinterpret_cast<const std::uint64_t*>(view->positions + header->code_size);
+	return 0;
+}
+
+///
+/// @brief returns the names of a program's variables, in the order of its variable operands.
+/// @param[in] size_t is the number of the line, from zero.
+/// @return char pointer to the first name. each name ends with a nul and the next follows it. null if the line has no program.
+/// @todo
+///
+const char* ProgramFile::GetVariableNames(std::size_t index) const {
+	const program_file_entry& entry = m_entries[index];
+	return entry.program ? m_file.Data() + entry.names : nullptr;
+}
+
+///
+/// @brief records why a file was rejected.
+/// @param[in] char pointer to the reason.
+/// @return 1 always.
+/// @todo
+///
+bool ProgramFile::Fail(const char* reason) {
+	m_failure = reason;
+	return 1;
+}
+
+///
+/// @brief checks the header, the checksum and the bounds of every entry, and verifies every program.
+/// @param
+/// @return 0 if the file is sound, 1 if it is not.
+/// @todo
+///
+bool ProgramFile::Check() {
+
+	const unsigned char* data = reinterpret_cast<const unsigned char*>(m_file.Data());
+	const std::uint64_t size = m_file.Size();
+
+	if(size < sizeof(program_file_header)) { return Fail("FILE IS TOO SHORT"); }
+
+	program_file_header header;
+	std::memcpy(&header, data, sizeof(header));
+
+	if(header.magic != MAGIC) { return Fail("NOT A COMPILED EXPRESSION FILE"); }
+	if(header.version != VERSION || header.bytecode_version != Bytecode::VERSION) {
+		return Fail("FILE WAS WRITTEN BY ANOTHER VERSION. COMPILE IT AGAIN");
+	}
+	if(header.size != size || size % k_alignment) { return Fail("FILE SIZE DOES NOT MATCH ITS HEADER"); }
+	if(header.checksum != Checksum(data + sizeof(header), size - sizeof(header))) { return Fail("CHECKSUM DOES NOT MATCH"); }
+
+	const std::uint64_t base = sizeof(header) + static_cast<std::uint64_t>(header.count) * sizeof(program_file_entry);
+	if(base > size) { return Fail("ENTRIES RUN PAST THE END OF THE FILE"); }
+
+	m_entries = reinterpret_cast<const program_file_entry*>(data + sizeof(header));
+	m_count = header.count;
+
+	for(std::size_t i = 0; i < m_count; i++) {
+
+		const program_file_entry& entry = m_entries[i];
+		if(!entry.program) { continue; }
+
+		if(entry.program < base || entry.program % k_alignment || entry.program > size
+			|| size - entry.program < sizeof(bytecode_header)) {
+			return Fail("PROGRAM RUNS PAST THE END OF THE FILE");
+		}
+
+		const bytecode_header* program = reinterpret_cast<const bytecode_header*>(data + entry.program);
+		std::uint64_t end = entry.program + sizeof(bytecode_header) + 2 * sizeof(std::uint32_t) * static_cast<std::uint64_t>(program->code_size) +
+			sizeof(std::uint64_t) * static_cast<std::uint64_t>(program->constant_count);
+
+		if(end > size || entry.names != end) { return Fail("PROGRAM RUNS PAST THE END OF THE FILE"); }
+
+		// every name ends with a nul inside the file
+		const char* name = m_file.Data() + entry.names;
+		const char* last = m_file.Data() + size;
+		for(std::uint32_t v = 0; v < program->variable_count; v++) {
+			const char* nul = static_cast<const char*>(std::memchr(name, 0, last - name));
+			if(!nul) { return Fail("VARIABLE NAMES RUN PAST THE END OF THE FILE"); }
+			name = nul + 1;
+		}
+
+		BytecodeView view;
+		Solution solution;
+		Get(i, &view, &solution);
+		if(Bytecode::Verify(view)) { return Fail("A PROGRAM IS MALFORMED"); }
+	}
+	return 0;
+}
+
+///
+/// @brief appends bytes to a buffer.
+/// @param[in,out] vector pointer to the buffer.
+/// @param[in] void pointer to the bytes.
+/// @param[in] size_t is the number of bytes.
+/// @return
+/// @todo
+///
+void ProgramFile::Append(std::vector<unsigned char>* buffer, const void* data, std::size_t size) {
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	buffer->insert(buffer->end(), bytes, bytes + size);
+}
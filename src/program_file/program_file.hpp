@@ -0,0 +1,96 @@
+//
+// PROGRAM_FILE.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef PROGRAM_FILE_HPP
+#define PROGRAM_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../bytecode/bytecode.hpp"
+#include "../mapped_file/mapped_file.hpp"
+#include "../solver/solver.hpp"
+
+namespace bocan {
+
+// the first bytes of a .calcbin file. every offset is from the start of the file, so the file can be mapped
+// anywhere. count entries follow the header, then the programs. each program is a bytecode_header and its
+// sections, as in BytecodeView, followed by the names of its variables, each ending with a nul. programs
+// start on 8 byte boundaries. the checksum covers every byte after the header, and numbers are stored in
+// the byte order of the machine that wrote the file, so a file from a machine of the other order fails
+// the magic number check.
+struct program_file_header {
+	std::uint32_t	magic;
+	std::uint16_t	version;
+	std::uint16_t	bytecode_version;
+	std::uint32_t	count;
+	std::uint32_t	reserved;
+	std::uint64_t	size;
+	std::uint64_t	checksum;
+};
+
+// one line of the source. a blank line, or a line that did not compile, has no program.
+struct program_file_entry {
+	std::uint64_t	program;
+	std::uint64_t	names;
+	std::int32_t	error_code;
+	std::uint32_t	error_pos;
+};
+
+// a library of expressions compiled once and saved, one program per line of the source. Open() maps the file
+// and checks it, and the programs are then run straight from the mapping, with no lexing or parsing.
+// a file written by another version of the format or of the bytecode, or changed since it was written, is rejected.
+class ProgramFile {
+
+public:
+	ProgramFile() {}
+	ProgramFile(const ProgramFile&) = delete;
+	ProgramFile& operator=(const ProgramFile&) = delete;
+
+	static bool				Write(const char*, std::size_t, const char*, unsigned long*, bool variables = false);
+	static std::uint64_t	Checksum(const unsigned char*, std::size_t);
+
+	bool	Open(const char*);
+	void	Close();
+	bool	Get(std::size_t, BytecodeView*, Solution*) const;
+
+	std::size_t	GetCount() const { return m_count; }
+	const char*	GetVariableNames(std::size_t) const;
+	const char*	GetFailure() const { return m_failure; }
+
+	static const std::uint32_t	MAGIC = 0x424C4342;	// "BCLB"
+	static const std::uint16_t	VERSION = 1;
+
+private:
+	bool	Fail(const char*);
+	bool	Check();
+
+	static void	Append(std::vector<unsigned char>*, const void*, std::size_t);
+
+	MappedFile					m_file;
+	const program_file_entry*	m_entries = nullptr;
+	std::size_t					m_count = 0;
+	const char*					m_failure = nullptr;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// PROGRAM_FILE_HPP
@@ -0,0 +1,550 @@
+//
+// SERVER.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "server.hpp"
+#include "../number/number.hpp"
+
+using bocan::LatencyHistogram;
+using bocan::Server;
+
+///
+/// @brief counts one latency.
+/// @param[in] unsigned integer is the latency, in any unit.
+/// @return
+/// @todo
+///
+void LatencyHistogram::Record(std::uint64_t value) {
+	m_counts[GetBucket(value)]++;
+	m_count++;
+	m_max = std::max(m_max, value);
+}
+
+///
+/// @brief counts every latency counted by another histogram, such as one kept by another thread.
+/// @param[in] LatencyHistogram reference to the other histogram.
+/// @return
+/// @todo
+///
+void LatencyHistogram::Add(const LatencyHistogram& other) {
+	for(int i = 0; i < BUCKET_COUNT; i++) { m_counts[i] += other.m_counts[i]; }
+	m_count += other.m_count;
+	m_max = std::max(m_max, other.m_max);
+}
+
+///
+/// @brief forgets every latency counted so far.
+/// @param
+/// @return
+/// @todo
+///
+void LatencyHistogram::Reset() {
+	std::fill_n(m_counts, BUCKET_COUNT, 0);
+	m_count = 0;
+	m_max = 0;
+}
+
+///
+/// @brief finds the latency that the given fraction of all latencies are at or below.
+/// @param[in] double is the fraction, such as 0.5 for the median or 0.999.
+/// @return unsigned integer is the upper limit of the bucket holding that latency, or the largest latency if it is smaller.
+/// @todo
+///
+std::uint64_t LatencyHistogram::GetPercentile(double fraction) const {
+
+	if(m_count == 0) { return 0; }
+
+	std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(fraction * static_cast<double>(m_count)));
+	rank = std::min(std::max<std::uint64_t>(rank, 1), m_count);
+
+	std::uint64_t seen = 0;
+	for(int i = 0; i < BUCKET_COUNT; i++) {
+		seen += m_counts[i];
+		if(seen >= rank) { return std::min(GetBucketLimit(i), m_max); }
+	}
+	return m_max;
+}
+
+///
+/// @brief finds the bucket of a latency. values below sixteen have a bucket each, larger ones share a bucket
+/// @brief with the values that have the same highest bit and the same four bits below it.
+/// @param[in] unsigned integer is the latency.
+/// @return integer index of the bucket.
+/// @todo
+///
+int LatencyHistogram::GetBucket(std::uint64_t value) {
+
+	if(value < SUB_BUCKETS) { return static_cast<int>(value); }
+
+	int bit = 63;
+	while(!((value >> bit) & 1)) { bit--; }
+
+	int sub = static_cast<int>(value >> (bit - 4)) - SUB_BUCKETS;
+	return (bit - 3) * SUB_BUCKETS + sub;
+}
+
+///
+/// @brief finds the largest latency that falls in a bucket.
+/// @param[in] integer index of the bucket.
+/// @return unsigned integer upper limit of the bucket.
+/// @todo
+///
+std::uint64_t LatencyHistogram::GetBucketLimit(int bucket) {
+
+	if(bucket < SUB_BUCKETS) { return static_cast<std::uint64_t>(bucket); }
+
+	int bit = bucket / SUB_BUCKETS + 3;
+	std::uint64_t sub = static_cast<std::uint64_t>(bucket % SUB_BUCKETS);
+	std::uint64_t lower = (SUB_BUCKETS + sub) << (bit - 4);
+	return lower + ((std::uint64_t(1) << (bit - 4)) - 1);
+}
+
+///
+/// @brief creates a server that is not yet listening.
+/// @param[in] size_t is the capacity of the solver's cache of solutions. zero solves every line without a cache.
+/// @return
+/// @todo
+///
+Server::Server(std::size_t cache) {
+	if(cache) {
+		m_cache.reset(new SolutionCache(cache));
+		m_solver.SetCache(m_cache.get());
+	}
+}
+
+#ifdef __linux__
+
+///
+/// @brief closes every connection and the socket, and removes the socket's path.
+/// @param
+/// @return
+/// @todo
+///
+Server::~Server() {
+	for(std::unique_ptr<connection>& c : m_connections) {
+		if(c) { ::close(c->fd); }
+	}
+	if(m_listen >= 0) {
+		::close(m_listen);
+		::unlink(m_path.c_str());
+	}
+	if(m_epoll >= 0) { ::close(m_epoll); }
+	if(m_wake >= 0) { ::close(m_wake); }
+}
+
+///
+/// @brief creates the socket at the given path and starts listening on it. a socket left at the path by a
+/// @brief server that has exited is replaced, any other file is not.
+/// @param[in] char pointer to the path of the socket.
+/// @return 0 if the server is listening, 1 if the socket could not be created.
+/// @todo
+///
+bool Server::Listen(const char* path) {
+
+	sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+
+	std::size_t length = std::strlen(path);
+	if(length == 0 || length >= sizeof(address.sun_path)) {
+		std::fprintf(stderr, ">ERROR. SOCKET PATH '%s' IS TOO LONG.\n", path);
+		return 1;
+	}
+	std::memcpy(address.sun_path, path, length);
+
+	struct stat info;
+	if(::stat(path, &info) == 0 && S_ISSOCK(info.st_mode)) { ::unlink(path); }
+
+	m_listen = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if(m_listen < 0) {
+		std::fprintf(stderr, ">ERROR. UNABLE TO CREATE SOCKET. %s.\n", std::strerror(errno));
+		return 1;
+	}
+
+	if(::bind(m_listen, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(m_listen, SOMAXCONN) != 0) {
+		std::fprintf(stderr, ">ERROR. UNABLE TO LISTEN ON '%s'. %s.\n", path, std::strerror(errno));
+		::close(m_listen);
+		m_listen = -1;
+		return 1;
+	}
+	m_path = path;
+
+	m_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+	m_wake = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if(m_epoll < 0 || m_wake < 0) {
+		std::fprintf(stderr, ">ERROR. UNABLE TO CREATE EPOLL INSTANCE. %s.\n", std::strerror(errno));
+		return 1;
+	}
+
+	epoll_event event;
+	event.events = EPOLLIN;
+	event.data.fd = m_listen;
+	::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_listen, &event);
+	event.data.fd = m_wake;
+	::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wake, &event);
+	return 0;
+}
+
+///
+/// @brief answers clients until Stop() is called.
+/// @param
+/// @return 0 when stopped, 1 if the server is not listening or waiting for events failed.
+/// @todo
+///
+bool Server::Run() {
+
+	if(m_epoll < 0) { return 1; }
+
+	epoll_event events[MAX_EVENTS];
+
+	while(true) {
+
+		int count = ::epoll_wait(m_epoll, events, MAX_EVENTS, -1);
+		if(count < 0) {
+			if(errno == EINTR) { continue; }
+			std::fprintf(stderr, ">ERROR. UNABLE TO WAIT FOR CLIENTS. %s.\n", std::strerror(errno));
+			return 1;
+		}
+
+		for(int i = 0; i < count; i++) {
+
+			int fd = events[i].data.fd;
+
+			if(fd == m_wake) { return 0; }
+			if(fd == m_listen) {
+				Accept();
+				continue;
+			}
+
+			// the connection may have been closed by an earlier event in this batch
+			if(static_cast<std::size_t>(fd) >= m_connections.size() || !m_connections[fd]) { continue; }
+			connection* c = m_connections[fd].get();
+
+			if(events[i].events & EPOLLERR) {
+				Close(c);
+				continue;
+			}
+			if(events[i].events & (EPOLLIN | EPOLLHUP)) {
+				Read(c);
+				if(!m_connections[fd]) { continue; }
+			}
+			Update(c);
+		}
+	}
+}
+
+///
+/// @brief makes Run() return. it only writes to an eventfd, so it may be called from another thread or a signal handler.
+/// @param
+/// @return
+/// @todo
+///
+void Server::Stop() {
+	if(m_wake >= 0) {
+		std::uint64_t one = 1;
+		ssize_t written = ::write(m_wake, &one, sizeof(one));
+		(void)written;
+	}
+}
+
+///
+/// @brief accepts every waiting client.
+/// @param
+/// @return
+/// @todo
+///
+void Server::Accept() {
+	while(true) {
+
+		int fd = ::accept4(m_listen, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if(fd < 0) { return; }
+
+		if(static_cast<std::size_t>(fd) >= m_connections.size()) { m_connections.resize(fd + 1); }
+		m_connections[fd].reset(new connection());
+		m_connections[fd]->fd = fd;
+
+		epoll_event event;
+		event.events = EPOLLIN;
+		event.data.fd = fd;
+		::epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event);
+		m_connections[fd]->events = EPOLLIN;
+
+		m_connection_count++;
+		m_open++;
+	}
+}
+
+///
+/// @brief reads what a client has sent and answers every whole line in it. what is left of a line waits for the next read.
+/// @param[in,out] connection pointer to the client. it is closed if reading fails.
+/// @return
+/// @todo
+///
+void Server::Read(connection* c) {
+
+	if(!c->reading) { return; }
+
+	if(c->input.size() < c->input_size + READ_SIZE) { c->input.resize(c->input_size + READ_SIZE); }
+
+	ssize_t count = ::recv(c->fd, c->input.data() + c->input_size, READ_SIZE, 0);
+	if(count < 0) {
+		if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) { Close(c); }
+		return;
+	}
+
+	// every line of this read is timed from now
+	auto received = std::chrono::steady_clock::now();
+
+	std::size_t begin = 0;
+	std::size_t scanned = c->input_size;
+	c->input_size += static_cast<std::size_t>(count);
+
+	while(true) {
+		const char* newline = static_cast<const char*>(std::memchr(c->input.data() + scanned, '\n', c->input_size - scanned));
+		if(!newline) { break; }
+
+		std::size_t end = static_cast<std::size_t>(newline - c->input.data());
+		Answer(c, c->input.data() + begin, end - begin, received);
+		begin = end + 1;
+		scanned = begin;
+
+		if(c->closing) { return; }
+	}
+
+	// the client has finished sending. like the last line of a file, its last line may not end with a newline.
+	if(count == 0) {
+		if(begin < c->input_size) { Answer(c, c->input.data() + begin, c->input_size - begin, received); }
+		c->input_size = 0;
+		c->reading = false;
+		c->closing = true;
+		return;
+	}
+
+	c->input_size -= begin;
+	if(begin && c->input_size) { std::memmove(c->input.data(), c->input.data() + begin, c->input_size); }
+
+	if(c->input_size > MAX_LINE) {
+		static const char k_message[] = "ERROR LINE TOO LONG\n";
+		Reserve(c, sizeof(k_message));
+		std::memcpy(c->output.data() + c->output_size, k_message, sizeof(k_message) - 1);
+		c->output_size += sizeof(k_message) - 1;
+		c->reading = false;
+		c->closing = true;
+	}
+}
+
+///
+/// @brief sends as much of the waiting answers as the socket takes. a connection that fails is closed.
+/// @param[in,out] connection pointer to the client.
+/// @return
+/// @todo
+///
+void Server::Write(connection* c) {
+
+	while(c->output_sent < c->output_size) {
+		ssize_t count = ::send(c->fd, c->output.data() + c->output_sent, c->output_size - c->output_sent, MSG_NOSIGNAL);
+		if(count < 0) {
+			if(errno == EINTR) { continue; }
+			if(errno != EAGAIN && errno != EWOULDBLOCK) { Close(c); }
+			return;
+		}
+		c->output_sent += static_cast<std::size_t>(count);
+	}
+	c->output_size = 0;
+	c->output_sent = 0;
+}
+
+///
+/// @brief sends what it can, then asks epoll for the events the connection now needs. a client that is not
+/// @brief taking its answers is not read from, and a client that has finished is closed once it has them all.
+/// @param[in,out] connection pointer to the client. it is not valid afterwards if the connection was closed.
+/// @return
+/// @todo
+///
+void Server::Update(connection* c) {
+
+	int fd = c->fd;
+	if(c->output_sent < c->output_size) { Write(c); }
+	if(!m_connections[fd]) { return; }
+
+	std::size_t pending = c->output_size - c->output_sent;
+	if(c->closing && pending == 0) {
+		Close(c);
+		return;
+	}
+
+	std::uint32_t events = 0;
+	if(c->reading && !c->closing && pending < MAX_PENDING_OUTPUT) { events |= EPOLLIN; }
+	if(pending) { events |= EPOLLOUT; }
+
+	if(events != c->events) {
+		epoll_event event;
+		event.events = events;
+		event.data.fd = c->fd;
+		::epoll_ctl(m_epoll, EPOLL_CTL_MOD, c->fd, &event);
+		c->events = events;
+	}
+}
+
+///
+/// @brief closes a connection and frees its buffers.
+/// @param[in] connection pointer to the client. it is not valid afterwards.
+/// @return
+/// @todo
+///
+void Server::Close(connection* c) {
+	int fd = c->fd;
+	::epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+	::close(fd);
+	m_connections[fd].reset();
+	m_open--;
+}
+
+///
+/// @brief solves one line, or runs it if it is a command, and appends the answer to the connection's output.
+/// @param[in,out] connection pointer to the client.
+/// @param[in] char pointer to the first character of the line.
+/// @param[in] size_t is the length of the line without the newline.
+/// @param[in] time_point is when the line was read. the time from then until the answer is ready is counted.
+/// @return
+/// @todo
+///
+void Server::Answer(connection* c, const char* line, std::size_t size, std::chrono::steady_clock::time_point received) {
+
+	// ignore the carriage return of windows line endings
+	if(size && line[size - 1] == '\r') { size--; }
+
+	if(size && (line[0] == 'S' || line[0] == 'R' || line[0] == 'Q') && !Command(c, line, size)) { return; }
+
+	Reserve(c, FORMAT_SIZE + 16);
+	char* out = c->output.data() + c->output_size;
+
+	// blank lines are answered with blank lines so the answers stay aligned with the lines
+	if(size == 0) {
+		out[0] = '\n';
+		c->output_size++;
+		return;
+	}
+
+	Solution solution;
+	std::size_t len = 0;
+
+	m_requests++;
+	if(m_solver.Solve(line, size, &solution)) {
+		m_errors++;
+		len = static_cast<std::size_t>(std::snprintf(out, FORMAT_SIZE + 16, "ERROR %d", static_cast<int>(solution.error_code)));
+	} else {
+		len = solution.floating ? FormatDouble(solution.real, out) : FormatInteger(solution.integer, out);
+	}
+	out[len] = '\n';
+	c->output_size += len + 1;
+
+	m_latency.Record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - received).count()));
+}
+
+///
+/// @brief runs a command line. STATS answers with the request, error and connection counts and the 50th, 99th and
+/// @brief 99.9th percentile and largest latency in microseconds. RESET clears the counts and answers OK. QUIT closes
+/// @brief the connection once its answers are sent. commands are not counted as requests.
+/// @param[in,out] connection pointer to the client.
+/// @param[in] char pointer to the first character of the line.
+/// @param[in] size_t is the length of the line.
+/// @return 0 if the line was a command, 1 if it is an expression.
+/// @todo
+///
+bool Server::Command(connection* c, const char* line, std::size_t size) {
+
+	std::string_view command(line, size);
+	const std::size_t capacity = 256;
+
+	if(command == "STATS") {
+		Reserve(c, capacity);
+		c->output_size += static_cast<std::size_t>(std::snprintf(c->output.data() + c->output_size, capacity,
+			"REQUESTS %lu ERRORS %lu CONNECTIONS %lu OPEN %lu P50 %.3f P99 %.3f P999 %.3f MAX %.3f US\n",
+			m_requests, m_errors, m_connection_count, m_open,
+			m_latency.GetPercentile(0.5) / 1e3, m_latency.GetPercentile(0.99) / 1e3,
+			m_latency.GetPercentile(0.999) / 1e3, m_latency.GetMax() / 1e3));
+		return 0;
+	}
+	if(command == "RESET") {
+		m_latency.Reset();
+		m_requests = 0;
+		m_errors = 0;
+		Reserve(c, 4);
+		std::memcpy(c->output.data() + c->output_size, "OK\n", 3);
+		c->output_size += 3;
+		return 0;
+	}
+	if(command == "QUIT") {
+		c->reading = false;
+		c->closing = true;
+		return 0;
+	}
+	return 1;
+}
+
+///
+/// @brief makes room for more answers at the end of the connection's output.
+/// @param[in,out] connection pointer to the client.
+/// @param[in] size_t is the number of bytes needed.
+/// @return
+/// @todo
+///
+void Server::Reserve(connection* c, std::size_t size) {
+	if(c->output_size + size > c->output.size()) { c->output.resize(c->output.size() * 2 + size); }
+}
+
+#else
+
+// epoll is only available on linux, so elsewhere the server reports that it cannot run
+
+Server::~Server() {}
+
+bool Server::Listen(const char*) {
+	std::fprintf(stderr, ">ERROR. SERVE MODE IS ONLY SUPPORTED ON LINUX.\n");
+	return 1;
+}
+
+bool Server::Run() {
+	return 1;
+}
+
+void Server::Stop() {}
+
+#endif
@@ -0,0 +1,142 @@
+//
+// SERVER.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef SERVER_HPP
+#define SERVER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../cache/cache.hpp"
+#include "../solver/solver.hpp"
+#include "../stats/stats.hpp"
+
+namespace bocan {
+
+// counts latencies in buckets that are powers of two split into sixteen, so any value is kept to within
+// about six percent. recording is a few instructions and takes no memory, and percentiles are read by
+// walking the buckets.
+class LatencyHistogram {
+
+public:
+	void	Record(std::uint64_t);
+	void	Add(const LatencyHistogram&);
+	void	Reset();
+
+	std::uint64_t	GetPercentile(double) const;
+	std::uint64_t	GetCount() const { return m_count; }
+	std::uint64_t	GetMax() const { return m_max; }
+
+	static const int SUB_BUCKETS = 16;
+	static const int BUCKET_COUNT = 61 * SUB_BUCKETS;
+
+private:
+	static int				GetBucket(std::uint64_t);
+	static std::uint64_t	GetBucketLimit(int);
+
+	std::uint64_t	m_counts[BUCKET_COUNT] = {};
+	std::uint64_t	m_count = 0;
+	std::uint64_t	m_max = 0;
+};
+
+// solves expressions for any number of clients on a unix domain socket, so a caller pays for starting the
+// calculator once instead of once per expression. one thread waits on every connection with epoll.
+// the protocol is lines of text: each line is an expression and is answered with one line, the solution or
+// "ERROR <code>", exactly as batch mode writes it. a client may send many lines without waiting, and the
+// answers come back in the same order. the lines STATS, RESET and QUIT are commands, see Command().
+class Server {
+
+public:
+	explicit Server(std::size_t cache = 0);
+	~Server();
+
+	Server(const Server&) = delete;
+	Server& operator=(const Server&) = delete;
+
+	bool	Listen(const char*);
+	bool	Run();
+	void	Stop();
+
+	void	SetStats(SolveStats* stats) { m_solver.SetStats(stats); }
+
+	const LatencyHistogram&	GetHistogram() const { return m_latency; }
+
+	unsigned long	GetConnectionCount() const { return m_connection_count; }
+	unsigned long	GetRequestCount() const { return m_requests; }
+	unsigned long	GetErrorCount() const { return m_errors; }
+
+	// a line may be no longer than this. a client that sends a longer one is disconnected.
+	static const std::size_t MAX_LINE = 1 << 20;
+
+	// a client is not read from while this many bytes of its answers are waiting to be sent
+	static const std::size_t MAX_PENDING_OUTPUT = 1 << 18;
+
+	// bytes read from a connection at a time, so one busy client cannot hold up the others
+	static const std::size_t READ_SIZE = 1 << 16;
+
+	static const int MAX_EVENTS = 64;
+
+private:
+	struct connection {
+		int					fd = -1;
+		std::vector<char>	input;
+		std::size_t			input_size = 0;
+		std::vector<char>	output;
+		std::size_t			output_size = 0;
+		std::size_t			output_sent = 0;
+		bool				reading = true;
+		bool				closing = false;
+		std::uint32_t		events = 0;
+	};
+
+	void	Accept();
+	void	Read(connection*);
+	void	Write(connection*);
+	void	Update(connection*);
+	void	Close(connection*);
+	void	Answer(connection*, const char*, std::size_t, std::chrono::steady_clock::time_point);
+	bool	Command(connection*, const char*, std::size_t);
+	void	Reserve(connection*, std::size_t);
+
+	Solver							m_solver;
+	std::unique_ptr<SolutionCache>	m_cache;
+
+	// indexed by file descriptor, which the kernel keeps small
+	std::vector<std::unique_ptr<connection>>	m_connections;
+
+	int			m_listen = -1;
+	int			m_epoll = -1;
+	int			m_wake = -1;
+	std::string	m_path;
+
+	LatencyHistogram	m_latency;
+	unsigned long		m_connection_count = 0;
+	unsigned long		m_open = 0;
+	unsigned long		m_requests = 0;
+	unsigned long		m_errors = 0;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// SERVER_HPP
@@ -0,0 +1,400 @@
+//
+// SOLVER.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstddef>
+#include <string_view>
+
+#include "solver.hpp"
+#include "../bytecode/bytecode.hpp"
+#include "../cache/cache.hpp"
+
+using bocan::Solver;
+
+///
+/// @brief checks the syntax of an expression and splits it into tokens.
+/// @param[in] char pointer to the expression. it must stay valid until Evaluate() returns.
+/// @param[in] size_t is the length of the expression.
+/// @param[out] Solution pointer receiving the number type, or the error code and position.
+/// @return 0 if the expression passes all checks, 1 if it fails.
+/// @todo
+///
+bool Solver::Tokenize(const char* expr, std::size_t size, Solution* solution) {
+
+	*solution = Solution();
+	m_expr = expr;
+
+	if(m_stats) { m_stats->expressions++; }
+
+	PhaseTimer timer(m_stats, STAT_LEX);
+	if(m_lexer.Tokenize(expr, size, &m_tokens)) {
+		m_expr = nullptr;
+		return Fail(solution, m_lexer.GetErrorCode(), m_lexer.GetErrorPosition());
+	}
+
+	solution->floating = m_lexer.IsFloating();
+	return 0;
+}
+
+///
+/// @brief solves the expression passed to the last successful call of Tokenize().
+/// @param[in,out] Solution pointer filled in by Tokenize(), receiving the solution or the error.
+/// @return 0 if the expression was solved, 1 if it failed.
+/// @todo
+///
+bool Solver::Evaluate(Solution* solution) {
+
+	if(!m_expr) { return Fail(solution, SOLVE_ERROR, 0); }
+
+	{
+		PhaseTimer timer(m_stats, STAT_PARSE);
+		if(m_parser.Parse(m_expr, m_tokens, solution->floating, &m_ast)) {
+			return Fail(solution, m_parser.GetErrorCode(), m_parser.GetErrorPosition());
+		}
+	}
+	CountNodes();
+
+	PhaseTimer timer(m_stats, STAT_EVALUATE);
+	bool err = solution->floating ? m_evaluator.Evaluate(m_ast, &solution->real)
+	                              : m_evaluator.Evaluate(m_ast, &solution->integer);
+	if(err) { return Fail(solution, m_evaluator.GetErrorCode(), m_evaluator.GetErrorPosition()); }
+
+	solution->modulus = m_evaluator.GetModulusFlag();
+	return 0;
+}
+
+///
+/// @brief solves the expression passed to the last successful call of Tokenize() with integers of any size.
+/// @brief '/' and '^' then stay integer operations. an expression with a radix point or an exponent in any
+/// @brief of its numbers is still solved with doubles.
+/// @param[out] BigInt pointer receiving the solution when the expression is solved with integers.
+/// @param[in,out] Solution pointer filled in by Tokenize(). floating is set if the solution is a double instead.
+/// @return 0 if the expression was solved, 1 if it failed.
+/// @todo
+///
+bool Solver::EvaluateBig(BigInt* result, Solution* solution) {
+
+	if(!m_expr) { return Fail(solution, SOLVE_ERROR, 0); }
+
+	for(const Token& token : m_tokens) {
+		if(token.type != TOKEN_NUMBER) { continue; }
+		for(std::size_t i = 0; i < token.len; i++) {
+			char c = m_expr[token.pos + i];
+			if(c < '0' || c > '9') { return Evaluate(solution); }
+		}
+	}
+
+	solution->floating = false;
+
+	{
+		PhaseTimer timer(m_stats, STAT_PARSE);
+		if(m_parser.Parse(m_expr, m_tokens, false, &m_ast)) {
+			return Fail(solution, m_parser.GetErrorCode(), m_parser.GetErrorPosition());
+		}
+	}
+	CountNodes();
+
+	PhaseTimer timer(m_stats, STAT_EVALUATE);
+	if(m_evaluator.Evaluate(m_ast, m_expr, result)) {
+		return Fail(solution, m_evaluator.GetErrorCode(), m_evaluator.GetErrorPosition());
+	}
+
+	solution->modulus = m_evaluator.GetModulusFlag();
+	return 0;
+}
+
+///
+/// @brief solves the expression passed to the last successful call of Tokenize() with exact decimals.
+/// @param[in] DecimalFormat reference to the scale and rounding mode.
+/// @param[out] Decimal pointer receiving the solution.
+/// @param[in,out] Solution pointer filled in by Tokenize(), receiving the error if solving fails.
+/// @return 0 if the expression was solved, 1 if it failed.
+/// @todo
+///
+bool Solver::EvaluateDecimal(const DecimalFormat& format, Decimal* result, Solution* solution) {
+
+	if(!m_expr) { return Fail(solution, SOLVE_ERROR, 0); }
+
+	// the constants of the tree are not used, every number is read again from its literal
+	bool floating = solution->floating;
+	solution->floating = false;
+
+	{
+		PhaseTimer timer(m_stats, STAT_PARSE);
+		if(m_parser.Parse(m_expr, m_tokens, floating, &m_ast)) {
+			return Fail(solution, m_parser.GetErrorCode(), m_parser.GetErrorPosition());
+		}
+	}
+	CountNodes();
+
+	PhaseTimer timer(m_stats, STAT_EVALUATE);
+	if(m_evaluator.Evaluate(m_ast, m_expr, format, result)) {
+		return Fail(solution, m_evaluator.GetErrorCode(), m_evaluator.GetErrorPosition());
+	}
+	return 0;
+}
+
+///
+/// @brief checks and solves an expression in one call.
+/// @param[in] char pointer to the expression.
+/// @param[in] size_t is the length of the expression.
+/// @param[out] Solution pointer receiving the solution or the error.
+/// @return 0 if the expression was solved, 1 if it failed.
+/// @todo
+///
+bool Solver::Solve(const char* expr, std::size_t size, Solution* solution) {
+	if(Tokenize(expr, size, solution)) { return 1; }
+	if(m_cache) { return SolveCached(solution); }
+	return Evaluate(solution);
+}
+
+///
+/// @brief solves the tokenized expression through the cache set with SetCache().
+/// @brief a whole expression seen before is not parsed at all. otherwise every parenthesized group solved before
+/// @brief becomes a single number, and the expression and its new groups are stored once it is solved.
+/// @brief only solutions are stored. an expression that fails is solved again each time so its error position is its own.
+/// @param[in,out] Solution pointer filled in by Tokenize(), receiving the solution or the error.
+/// @return 0 if the expression was solved, 1 if it failed.
+/// @todo
+///
+bool Solver::SolveCached(Solution* solution) {
+
+	Normalize();
+
+	if(m_cache->Lookup(m_key, solution)) { return 0; }
+
+	FindGroups(solution->floating);
+
+	m_parser.SetGroups(&m_groups);
+	bool err = Evaluate(solution);
+	m_parser.SetGroups(nullptr);
+
+	if(err) { return 1; }
+
+	m_cache->Insert(m_key, *solution);
+
+	// the warning for an integer division with a remainder belongs to the whole expression,
+	// it cannot be traced to a group, so such groups are not stored
+	if(!solution->modulus) { StoreGroups(solution->floating); }
+	return 0;
+}
+
+///
+/// @brief records an error in the solution.
+/// @param[out] Solution pointer receiving the error.
+/// @param[in] enumerator corresponding to the error_code enum.
+/// @param[in] size_t is the position of the error within the expression.
+/// @return always 1, so callers can return the result directly.
+/// @todo
+///
+bool Solver::Fail(Solution* solution, errors error_code, std::size_t pos) {
+	solution->error_code = error_code;
+	solution->error_pos = pos;
+	if(m_stats) { m_stats->errors++; }
+	return 1;
+}
+
+///
+/// @brief starts or stops collecting stats. the parser times the conversion of numbers into the same counters.
+/// @param[in] SolveStats pointer to the counters, or nullptr to stop.
+/// @return
+/// @todo
+///
+void Solver::SetStats(SolveStats* stats) {
+	m_stats = stats;
+	m_parser.SetStats(stats);
+}
+
+///
+/// @brief counts the operators and numbers of the tree that was just parsed, and the nodes it shares.
+/// @return
+/// @todo
+///
+void Solver::CountNodes() {
+
+	if(!m_stats) { return; }
+
+	m_stats->shared_nodes += m_ast.shared;
+
+	for(const Node& node : m_ast.nodes) {
+		switch(node.type) {
+			case NODE_ADD:		m_stats->operations[STAT_ADD]++; break;
+			case NODE_SUBTRACT:	m_stats->operations[STAT_SUBTRACT]++; break;
+			case NODE_MULTIPLY:	m_stats->operations[STAT_MULTIPLY]++; break;
+			case NODE_DIVIDE:	m_stats->operations[STAT_DIVIDE]++; break;
+			case NODE_POWER:	m_stats->operations[STAT_POWER]++; break;
+			case NODE_NEGATE:	m_stats->operations[STAT_NEGATE]++; break;
+			case NODE_NUMBER:
+
+				// a group whose value came from the cache has no literal
+				if(node.rhs) {
+					m_stats->literals++;
+					m_stats->literal_bytes += node.rhs;
+				}
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+///
+/// @brief writes the normalized text of the tokens to the expression key, and records where each token starts in it.
+/// @return
+/// @todo
+///
+void Solver::Normalize() {
+
+	m_key.assign(1, '=');
+	m_offsets.resize(m_tokens.size());
+
+	for(std::size_t i = 0; i < m_tokens.size(); i++) {
+
+		const Token& token = m_tokens[i];
+		m_offsets[i] = m_key.size();
+
+		switch(token.type) {
+			case TOKEN_PLUS:		m_key.push_back('+'); break;
+			case TOKEN_MINUS:		m_key.push_back('-'); break;
+			case TOKEN_MULTIPLY:	m_key.push_back('*'); break;
+			case TOKEN_DIVIDE:		m_key.push_back('/'); break;
+			case TOKEN_POWER:		m_key.push_back('^'); break;
+			case TOKEN_LEFT_PAREN:	m_key.push_back('('); break;
+			case TOKEN_RIGHT_PAREN:	m_key.push_back(')'); break;
+			default:				m_key.append(m_expr + token.pos, token.len); break;
+		}
+	}
+}
+
+///
+/// @brief matches the parentheses of the tokenized expression and looks up the value of each group.
+/// @param[in] boolean true if the expression is solved with doubles. a group's value depends on the number type.
+/// @return
+/// @todo
+///
+void Solver::FindGroups(bool floating) {
+
+	m_groups.resize(m_tokens.size());
+	m_opens.clear();
+
+	for(std::size_t i = 0; i < m_tokens.size(); i++) {
+
+		if(m_tokens[i].type == TOKEN_LEFT_PAREN) {
+			m_groups[i] = Group();
+			m_opens.push_back(i);
+			continue;
+		}
+
+		if(m_tokens[i].type != TOKEN_RIGHT_PAREN || m_opens.empty()) { continue; }
+
+		Group& group = m_groups[m_opens.back()];
+		group.close = static_cast<unsigned int>(i);
+
+		std::string_view key = GetGroupKey(m_opens.back(), floating);
+		m_opens.pop_back();
+
+		Solution known;
+		if(!key.empty() && m_cache->LookupGroup(key, &known)) {
+			group.known = true;
+			group.integer = known.integer;
+			group.real = known.real;
+		}
+	}
+}
+
+///
+/// @brief stores the value of every group parsed by the last solve.
+/// @param[in] boolean true if the expression was solved with doubles.
+/// @return
+/// @todo
+///
+void Solver::StoreGroups(bool floating) {
+
+	for(std::size_t i = 0; i < m_tokens.size(); i++) {
+
+		if(m_tokens[i].type != TOKEN_LEFT_PAREN || !m_groups[i].parsed) { continue; }
+
+		std::string_view key = GetGroupKey(i, floating);
+		if(key.empty()) { continue; }
+
+		Solution value;
+		value.floating = floating;
+		if(floating) {
+			value.real = m_evaluator.GetFloatValue(m_groups[i].node);
+		} else {
+			value.integer = m_evaluator.GetIntegerValue(m_groups[i].node);
+		}
+		m_cache->Insert(key, value);
+	}
+}
+
+///
+/// @brief builds the key of a parenthesized group from the expression key.
+/// @param[in] size_t is the token index of the group's '('. its match must already be known.
+/// @param[in] boolean true if the expression is solved with doubles.
+/// @return the key, or an empty view if the group is too long to be cached.
+/// @todo
+///
+std::string_view Solver::GetGroupKey(std::size_t open, bool floating) {
+
+	std::size_t begin = m_offsets[open];
+	std::size_t end = m_offsets[m_groups[open].close] + 1;
+
+	if(end - begin > MAX_GROUP_KEY) { return std::string_view(); }
+
+	m_group_key.assign(1, floating ? 'D' : 'L');
+	m_group_key.append(m_key, begin, end - begin);
+	return m_group_key;
+}
+
+///
+/// @brief checks and parses an expression and compiles it to bytecode.
+/// @param[in] char pointer to the expression.
+/// @param[in] size_t is the length of the expression.
+/// @param[out] Bytecode pointer receiving the program.
+/// @param[out] Solution pointer receiving the number type, or the error code and position.
+/// @param[in] boolean true to accept names as variables. otherwise a name is invalid input, as it is to Solve().
+/// @return 0 if the expression was compiled, 1 if it failed.
+/// @todo
+///
+bool Solver::Compile(const char* expr, std::size_t size, Bytecode* program, Solution* solution, bool variables) {
+
+	*solution = Solution();
+	m_expr = expr;
+
+	if(m_lexer.Tokenize(expr, size, &m_tokens, variables)) {
+		solution->error_code = m_lexer.GetErrorCode();
+		solution->error_pos = m_lexer.GetErrorPosition();
+		return 1;
+	}
+
+	solution->floating = m_lexer.IsFloating();
+
+	if(m_parser.Parse(expr, m_tokens, solution->floating, &m_ast)) {
+		solution->error_code = m_parser.GetErrorCode();
+		solution->error_pos = m_parser.GetErrorPosition();
+		return 1;
+	}
+
+	if(program->Compile(m_ast)) {
+		solution->error_code = SOLVE_ERROR;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,110 @@
+//
+// SOLVER.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef SOLVER_HPP
+#define SOLVER_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../calculator/errors.hpp"
+#include "../lexer/lexer.hpp"
+#include "../parser/parser.hpp"
+#include "../evaluator/evaluator.hpp"
+#include "../stats/stats.hpp"
+
+namespace bocan {
+
+class Bytecode;
+class SolutionCache;
+
+// everything known about one solved expression. this replaces the solve_err, modulus and floating flags
+// that used to live in the calculator, so no state is shared between two solves.
+struct Solution {
+	bool		floating = false;
+	long		integer = 0;
+	double		real = 0;
+	bool		modulus = false;
+	errors		error_code = NO_ERROR;
+	std::size_t	error_pos = 0;
+	std::size_t	error_row = 0;	// the failing row when a compiled expression is solved over columns
+};
+
+// evaluation context. it holds only scratch storage for the lexer, parser and evaluator,
+// so each thread (or each call on the stack) can own one and solve without locks.
+class Solver {
+
+public:
+	bool	Tokenize(const char*, std::size_t, Solution*);
+	bool	Evaluate(Solution*);
+	bool	EvaluateBig(BigInt*, Solution*);
+	bool	EvaluateDecimal(const DecimalFormat&, Decimal*, Solution*);
+	bool	Solve(const char*, std::size_t, Solution*);
+	bool	Compile(const char*, std::size_t, Bytecode*, Solution*, bool variables = false);
+
+	void	SetCache(SolutionCache* cache) { m_cache = cache; }
+	void	SetPool(ThreadPool* pool) { m_evaluator.SetPool(pool); }
+	void	SetStats(SolveStats*);
+
+	SolveStats*	GetStats() const { return m_stats; }
+
+	// the variables of the last compiled expression, in the order of the program's variable operands
+	std::size_t			GetVariableCount() const { return m_ast.variables.size(); }
+	std::string_view	GetVariableName(std::size_t index) const { return std::string_view(m_expr + m_ast.variables[index].pos, m_ast.variables[index].len); }
+
+	// parenthesized groups with a longer normalized text are never looked up or stored
+	static const std::size_t MAX_GROUP_KEY = 256;
+
+private:
+	bool	SolveCached(Solution*);
+	bool	Fail(Solution*, errors, std::size_t);
+	void	CountNodes();
+	void	Normalize();
+	void	FindGroups(bool);
+	void	StoreGroups(bool);
+
+	std::string_view	GetGroupKey(std::size_t, bool);
+
+	Lexer				m_lexer;
+	Parser				m_parser;
+	Evaluator			m_evaluator;
+	std::vector<Token>	m_tokens;
+	Ast					m_ast;
+
+	const char*	m_expr = nullptr;
+
+	// optional instrumentation. nothing is timed or counted without it.
+	SolveStats*	m_stats = nullptr;
+
+	// optional memoization. the key of an expression is its tokens with the white space removed,
+	// 'x' written as '*' and implicit multiplication written out, so equivalent inputs share one entry.
+	SolutionCache*				m_cache = nullptr;
+	std::string					m_key;
+	std::string					m_group_key;
+	std::vector<std::size_t>	m_offsets;
+	std::vector<Group>			m_groups;
+	std::vector<std::size_t>	m_opens;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// SOLVER_HPP
@@ -0,0 +1,80 @@
+//
+// ALLOCATIONS.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "allocations.hpp"
+
+namespace {
+
+std::atomic<bool>			g_count_allocations(false);
+std::atomic<unsigned long>	g_allocations(0);
+std::atomic<unsigned long>	g_allocated_bytes(0);
+
+} // NAMESPACE
+
+void* operator new(std::size_t size) {
+	if(g_count_allocations.load(std::memory_order_relaxed)) {
+		g_allocations.fetch_add(1, std::memory_order_relaxed);
+		g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+	}
+	void* p = std::malloc(size ? size : 1);
+	if(!p) { throw std::bad_alloc(); }
+	return p;
+}
+
+void operator delete(void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+	std::free(p);
+}
+
+///
+/// @brief switches the counting of heap allocations on or off. the counts are kept while it is off.
+/// @param[in] boolean true to count every later call to operator new.
+/// @return
+/// @todo
+///
+void bocan::CountAllocations(bool on) {
+	g_count_allocations.store(on, std::memory_order_relaxed);
+}
+
+///
+/// @brief returns the number of heap allocations counted so far.
+/// @return unsigned long count of calls to operator new.
+/// @todo
+///
+unsigned long bocan::GetAllocationCount() {
+	return g_allocations.load(std::memory_order_relaxed);
+}
+
+///
+/// @brief returns the number of bytes requested by the heap allocations counted so far.
+/// @return unsigned long sum of the sizes passed to operator new.
+/// @todo
+///
+unsigned long bocan::GetAllocatedBytes() {
+	return g_allocated_bytes.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,35 @@
+//
+// ALLOCATIONS.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef ALLOCATIONS_HPP
+#define ALLOCATIONS_HPP
+
+namespace bocan {
+
+// allocations.cpp replaces the global operator new and operator delete with versions that count
+// every allocation and its size while counting is switched on. it is linked into the calculator and
+// the benchmarks only, never into libcalc, so a program using the library keeps its own allocator.
+void			CountAllocations(bool);
+unsigned long	GetAllocationCount();
+unsigned long	GetAllocatedBytes();
+
+} // NAMESPACE BOCAN
+
+#endif	// ALLOCATIONS_HPP
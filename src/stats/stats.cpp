@@ -0,0 +1,97 @@
+//
+// STATS.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cstdio>
+
+#include "stats.hpp"
+
+using bocan::SolveStats;
+
+namespace {
+
+const char* const k_phase_names[bocan::STAT_PHASE_COUNT] = { "lex", "parse", "literals", "evaluate", "format" };
+const char* const k_operation_names[bocan::STAT_OPERATION_COUNT] = { "+", "-", "*", "/", "^", "negate" };
+
+} // NAMESPACE
+
+///
+/// @brief adds the counters of another solver to these.
+/// @param[in] SolveStats reference to the counters to add.
+/// @return
+/// @todo
+///
+void SolveStats::Add(const SolveStats& other) {
+	expressions += other.expressions;
+	errors += other.errors;
+	for(int i = 0; i < STAT_PHASE_COUNT; i++) { seconds[i] += other.seconds[i]; }
+	for(int i = 0; i < STAT_OPERATION_COUNT; i++) { operations[i] += other.operations[i]; }
+	literals += other.literals;
+	literal_bytes += other.literal_bytes;
+	shared_nodes += other.shared_nodes;
+}
+
+///
+/// @brief writes the counters as a table, or as a JSON object.
+/// @param[in] FILE pointer to the stream receiving the report.
+/// @param[in] unsigned long is the number of heap allocations made while the stats were collected.
+/// @param[in] unsigned long is the number of bytes those allocations asked for.
+/// @param[in] boolean true to write JSON instead of a table.
+/// @return
+/// @todo
+///
+void SolveStats::Print(std::FILE* out, unsigned long allocations, unsigned long allocated_bytes, bool json) const {
+
+	double total = 0;
+	for(int i = 0; i < STAT_PHASE_COUNT; i++) {
+		if(i != STAT_LITERALS) { total += seconds[i]; }
+	}
+
+	if(json) {
+		std::fprintf(out, "{ \"expressions\": %lu, \"errors\": %lu, \"seconds\": {", expressions, errors);
+		for(int i = 0; i < STAT_PHASE_COUNT; i++) {
+			std::fprintf(out, "%s \"%s\": %.9f", i ? "," : "", k_phase_names[i], seconds[i]);
+		}
+		std::fprintf(out, " }, \"operations\": {");
+		for(int i = 0; i < STAT_OPERATION_COUNT; i++) {
+			std::fprintf(out, "%s \"%s\": %lu", i ? "," : "", k_operation_names[i], operations[i]);
+		}
+		std::fprintf(out, " }, \"literals\": %lu, \"literal_bytes\": %lu, \"shared_nodes\": %lu, \"allocations\": %lu, \"allocated_bytes\": %lu }\n",
+			literals, literal_bytes, shared_nodes, allocations, allocated_bytes);
+		return;
+	}
+
+	std::fprintf(out, ">STATS %lu EXPRESSIONS %lu ERRORS\n", expressions, errors);
+	std::fprintf(out, ">%-10s %-12s %-10s %-8s\n", "PHASE", "SECONDS", "NS/EXPR", "SHARE");
+	for(int i = 0; i < STAT_PHASE_COUNT; i++) {
+
+		// literals are timed within parsing, so they are shown under it and not counted twice in the share
+		std::fprintf(out, ">%-10s %-12.6f %-10.0f %5.1f%%\n", i == STAT_LITERALS ? "  literals" : k_phase_names[i], seconds[i],
+			expressions ? seconds[i] * 1e9 / expressions : 0.0, total > 0 ? seconds[i] * 100 / total : 0.0);
+	}
+
+	std::fprintf(out, ">%-10s %-12s\n", "OPERATOR", "COUNT");
+	for(int i = 0; i < STAT_OPERATION_COUNT; i++) {
+		std::fprintf(out, ">%-10s %-12lu\n", k_operation_names[i], operations[i]);
+	}
+
+	std::fprintf(out, ">LITERALS %lu BYTES %lu\n", literals, literal_bytes);
+	std::fprintf(out, ">SHARED NODES %lu\n", shared_nodes);
+	std::fprintf(out, ">ALLOCATIONS %lu BYTES %lu\n", allocations, allocated_bytes);
+}
@@ -0,0 +1,89 @@
+//
+// STATS.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#include <chrono>
+#include <cstdio>
+
+namespace bocan {
+
+enum stat_phase {
+	STAT_LEX,
+	STAT_PARSE,
+	STAT_LITERALS,		// converting numbers to longs and doubles, which is part of parsing
+	STAT_EVALUATE,
+	STAT_FORMAT,
+	STAT_PHASE_COUNT
+};
+
+enum stat_operation {
+	STAT_ADD,
+	STAT_SUBTRACT,
+	STAT_MULTIPLY,
+	STAT_DIVIDE,
+	STAT_POWER,
+	STAT_NEGATE,
+	STAT_OPERATION_COUNT
+};
+
+// counters for everything one solver did, see Solver::SetStats(). each thread's solver has its own,
+// and they are added together for the report, so collecting them takes no locks.
+struct SolveStats {
+	unsigned long	expressions = 0;
+	unsigned long	errors = 0;
+	double			seconds[STAT_PHASE_COUNT] = {};
+	unsigned long	operations[STAT_OPERATION_COUNT] = {};
+	unsigned long	literals = 0;
+	unsigned long	literal_bytes = 0;
+	unsigned long	shared_nodes = 0;	// repeated subtrees and literals that were parsed into an existing node
+
+	void	Add(const SolveStats&);
+	void	Print(std::FILE*, unsigned long, unsigned long, bool) const;
+};
+
+// adds the time from its construction to its destruction to one phase. with no stats it does nothing,
+// not even read the clock, so the cost of instrumented code that is switched off is one pointer test.
+class PhaseTimer {
+
+public:
+	PhaseTimer(SolveStats* stats, stat_phase phase) : m_stats(stats), m_phase(phase) {
+		if(m_stats) { m_start = std::chrono::steady_clock::now(); }
+	}
+
+	~PhaseTimer() {
+		if(m_stats) {
+			m_stats->seconds[m_phase] += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+		}
+	}
+
+	PhaseTimer(const PhaseTimer&) = delete;
+	PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+	SolveStats*	m_stats;
+	stat_phase	m_phase;
+	std::chrono::steady_clock::time_point	m_start;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// STATS_HPP
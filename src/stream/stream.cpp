@@ -0,0 +1,473 @@
+//
+// STREAM.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#include "stream.hpp"
+#include "../number/number.hpp"
+#include "../parser/parser.hpp"
+
+using bocan::StreamSolver;
+
+///
+/// @brief clears the stacks, the error and the position, ready for the first piece of a new expression.
+/// @brief the stacks keep their capacity.
+/// @param
+/// @return
+/// @todo
+///
+void StreamSolver::Begin() {
+
+	m_lexer.Begin();
+	m_operators.clear();
+	m_values.clear();
+
+	m_number = NUMBER_NONE;
+	m_literal.clear();
+	m_offset = 0;
+	m_deepest = 0;
+	m_depth = 0;
+	m_operand = false;
+	m_floating = false;
+
+	m_error_code = NO_ERROR;
+	m_error_pos = 0;
+	m_solve_error = NO_ERROR;
+	m_solve_error_pos = 0;
+}
+
+///
+/// @brief reads the next piece of the expression. a number or an exponent may be cut anywhere between two pieces.
+/// @param[in] char pointer to the piece. it is not needed once Feed() returns.
+/// @param[in] size_t is the length of the piece in bytes.
+/// @return 0 if the text so far is valid, 1 if it has a syntax error. further pieces are then ignored.
+/// @todo
+///
+bool StreamSolver::Feed(const char* data, std::size_t size) {
+
+	if(m_error_code != NO_ERROR) { return 1; }
+
+	for(std::size_t i = 0; i < size; i++) {
+		if(Scan(data[i], m_offset + i)) {
+			m_offset += size;
+			return 1;
+		}
+	}
+
+	m_offset += size;
+	return 0;
+}
+
+///
+/// @brief checks the end of the expression and solves what is left on the stacks.
+/// @param[out] Solution pointer receiving the solution, or the error code and its byte offset.
+/// @return 0 if the expression was solved, 1 if it failed.
+/// @todo
+///
+bool StreamSolver::Finish(Solution* solution) {
+
+	*solution = Solution();
+
+	// white space ends a number at the end of the text under the same rules as anywhere else
+	if(m_error_code == NO_ERROR && !Scan(' ', m_offset) && m_lexer.Finish(m_offset)) {
+		SetError(m_lexer.GetErrorCode(), m_lexer.GetErrorPosition());
+	}
+
+	if(m_error_code == NO_ERROR) {
+		if(m_depth <= MAX_DEPTH) {
+			while(!m_operators.empty()) { Reduce(); }
+		}
+		if(m_solve_error != NO_ERROR) { SetError(m_solve_error, m_solve_error_pos); }
+	}
+
+	if(m_error_code != NO_ERROR) {
+		solution->error_code = m_error_code;
+		solution->error_pos = m_error_pos;
+		return 1;
+	}
+
+	solution->floating = m_floating;
+	if(m_floating) {
+		solution->real = m_values.back().real;
+	} else {
+		solution->integer = m_values.back().integer;
+	}
+	return 0;
+}
+
+///
+/// @brief solves an expression read from a stream in pieces of CHUNK_SIZE bytes. reading stops at the first syntax error.
+/// @param[in] FILE pointer to the stream.
+/// @param[out] Solution pointer receiving the solution, or the error code and its byte offset.
+/// @return 0 if the expression was solved, 1 if it failed or the stream could not be read.
+/// @todo
+///
+bool StreamSolver::Solve(std::FILE* in, Solution* solution) {
+
+	Begin();
+	m_buffer.resize(CHUNK_SIZE);
+
+	while(true) {
+		std::size_t count = std::fread(m_buffer.data(), 1, CHUNK_SIZE, in);
+		if(count && Feed(m_buffer.data(), count)) { break; }
+		if(count < CHUNK_SIZE) { break; }
+	}
+
+	if(std::ferror(in)) {
+		*solution = Solution();
+		solution->error_code = SOLVE_ERROR;
+		solution->error_pos = m_offset;
+		return 1;
+	}
+	return Finish(solution);
+}
+
+///
+/// @brief reads one character. the same characters are accepted as by the lexer, plus line breaks as white space.
+/// @param[in] char is the character.
+/// @param[in] size_t is its byte offset from the start of the expression.
+/// @return 0 if the text so far is valid, 1 on a syntax error.
+/// @todo
+///
+bool StreamSolver::Scan(char c, std::size_t pos) {
+
+	// continue the number being read, or end it and read the character on its own
+	switch(m_number) {
+
+		case NUMBER_NONE:
+			break;
+
+		case NUMBER_MANTISSA:
+			if(c >= '0' && c <= '9') {
+				m_digits = true;
+				return Append(c);
+			}
+			if(c == '.') {
+				if(m_radix) { return SetError(INVALID_INPUT_RADIX_POINT, pos); }
+				m_radix = true;
+				return Append(c);
+			}
+
+			// check if a '.' was passed without a number around it
+			if(!m_digits) { return SetError(INVALID_INPUT_RADIX_POINT, m_number_pos); }
+
+			if(c == 'e' || c == 'E') {
+				m_number = NUMBER_EXPONENT_MARK;
+				m_exponent_pos = pos;
+				return Append(c);
+			}
+			if(EndNumber()) { return 1; }
+			break;
+
+		case NUMBER_EXPONENT_MARK:
+			if(c == '+' || c == '-') {
+				m_number = NUMBER_EXPONENT_SIGN;
+				return Append(c);
+			}
+
+			// fall through
+		case NUMBER_EXPONENT_SIGN:
+			if(c >= '0' && c <= '9') {
+				m_number = NUMBER_EXPONENT;
+				return Append(c);
+			}
+
+			// an 'e' without digits after it is not part of the number, and is not allowed on its own
+			if(EndNumber()) { return 1; }
+			return SetError(INVALID_INPUT_INVALID_INTEGER, m_exponent_pos);
+
+		case NUMBER_EXPONENT:
+			if(c >= '0' && c <= '9') { return Append(c); }
+			if(EndNumber()) { return 1; }
+			break;
+	}
+
+	switch(c) {
+
+		case ' ':
+		case '\t':
+		case '\r':
+		case '\n':
+			return 0;
+
+		case '0':
+		case '1':
+		case '2':
+		case '3':
+		case '4':
+		case '5':
+		case '6':
+		case '7':
+		case '8':
+		case '9':
+		case '.':
+			m_number = NUMBER_MANTISSA;
+			m_number_pos = pos;
+			m_radix = c == '.';
+			m_digits = !m_radix;
+			m_literal.assign(1, c);
+			return 0;
+
+		case '+':	return Push(TOKEN_PLUS, pos, 1);
+		case '-':	return Push(TOKEN_MINUS, pos, 1);
+		case 'x':
+		case '*':	return Push(TOKEN_MULTIPLY, pos, 1);
+		case '(':	return Push(TOKEN_LEFT_PAREN, pos, 1);
+		case ')':	return Push(TOKEN_RIGHT_PAREN, pos, 1);
+
+		case '/':
+			m_floating = true;
+			return Push(TOKEN_DIVIDE, pos, 1);
+
+		case '^':
+			m_floating = true;
+			return Push(TOKEN_POWER, pos, 1);
+
+		default:
+			return SetError(INVALID_INPUT_INVALID_INTEGER, pos);
+	}
+}
+
+///
+/// @brief adds a character to the number being read.
+/// @param[in] char is the character.
+/// @return 0 on success, 1 if the number is longer than MAX_LITERAL.
+/// @todo
+///
+bool StreamSolver::Append(char c) {
+	if(m_literal.size() == MAX_LITERAL) { return SetError(NUMBER_TOO_LONG, m_number_pos); }
+	m_literal.push_back(c);
+	return 0;
+}
+
+///
+/// @brief converts the number that was read to a long and a double and passes it on as a token.
+/// @param
+/// @return 0 if the number is allowed in this position, 1 on a syntax error.
+/// @todo
+///
+bool StreamSolver::EndNumber() {
+
+	// an unfinished exponent is not part of the number
+	std::size_t len = m_literal.size();
+	if(m_number == NUMBER_EXPONENT_MARK || m_number == NUMBER_EXPONENT_SIGN) {
+		len = m_exponent_pos - m_number_pos;
+	} else if(m_number == NUMBER_EXPONENT) {
+		m_floating = true;
+	}
+	if(m_radix) { m_floating = true; }
+	m_number = NUMBER_NONE;
+
+	// the integer is only used if the number has no radix point or exponent
+	m_number_value.integer = ParseInteger(m_literal.data(), len);
+	m_number_value.real = ParseDouble(m_literal.data(), len);
+
+	return Push(TOKEN_NUMBER, m_number_pos, len);
+}
+
+///
+/// @brief checks a token with the lexer, then shifts it, and any implicit multiplication before it, onto the stacks.
+/// @param[in] token_type of the token.
+/// @param[in] size_t is its byte offset.
+/// @param[in] size_t is its length.
+/// @return 0 if the token is allowed in this position, 1 on a syntax error.
+/// @todo
+///
+bool StreamSolver::Push(token_type type, std::size_t pos, std::size_t len) {
+
+	m_pending.clear();
+
+	if(m_lexer.Push(&m_pending, type, pos, len)) {
+		return SetError(m_lexer.GetErrorCode(), m_lexer.GetErrorPosition());
+	}
+
+	for(const Token& token : m_pending) { Shift(token.type, pos); }
+
+	std::size_t depth = m_operators.size() + m_values.size();
+	if(depth > m_deepest) { m_deepest = depth; }
+	return 0;
+}
+
+///
+/// @brief moves a checked token onto the stacks. operators of equal or higher precedence waiting on the stack
+/// @brief are solved first, which gives the same order of operations as the parser: left associative, with a
+/// @brief negative sign binding tighter than any binary operator.
+/// @param[in] token_type of the token.
+/// @param[in] size_t is its byte offset.
+/// @return
+/// @todo
+///
+void StreamSolver::Shift(token_type type, std::size_t pos) {
+
+	// past the deepest nesting the parser allows only the syntax of the rest is checked
+	if(m_depth > MAX_DEPTH) { return; }
+
+	char oper = NODE_ADD;
+
+	switch(type) {
+
+		case TOKEN_NUMBER:
+			m_values.push_back(m_number_value);
+			ApplyNegates();
+			m_operand = true;
+			return;
+
+		case TOKEN_LEFT_PAREN:
+
+			// too deep a group fails as it does in the parser, before any arithmetic error
+			if(++m_depth > MAX_DEPTH) {
+				m_solve_error = SOLVE_ERROR;
+				m_solve_error_pos = pos;
+				return;
+			}
+			m_operators.push_back(operation{ '(', pos });
+			m_operand = false;
+			return;
+
+		case TOKEN_RIGHT_PAREN:
+
+			// the lexer has checked that a matching '(' is on the stack
+			while(m_operators.back().type != '(') { Reduce(); }
+			m_operators.pop_back();
+			m_depth--;
+			ApplyNegates();
+			m_operand = true;
+			return;
+
+		case TOKEN_MINUS:
+
+			// a '-' where an operand is expected is a negative sign
+			if(!m_operand) {
+				m_operators.push_back(operation{ NODE_NEGATE, pos });
+				return;
+			}
+			oper = NODE_SUBTRACT;
+			break;
+
+		case TOKEN_MULTIPLY:	oper = NODE_MULTIPLY; break;
+		case TOKEN_DIVIDE:		oper = NODE_DIVIDE; break;
+		case TOKEN_POWER:		oper = NODE_POWER; break;
+		default:				break;
+	}
+
+	int precedence = GetPrecedence(oper);
+	while(!m_operators.empty() && GetPrecedence(m_operators.back().type) >= precedence) { Reduce(); }
+
+	m_operators.push_back(operation{ oper, pos });
+	m_operand = false;
+}
+
+///
+/// @brief solves the binary operator on top of the stack with the two operands on top of the value stack.
+/// @brief the long is only kept up to date while the expression may still be solved with longs.
+/// @param
+/// @return
+/// @todo
+///
+void StreamSolver::Reduce() {
+
+	operation oper = m_operators.back();
+	m_operators.pop_back();
+
+	value rhs = m_values.back();
+	m_values.pop_back();
+	value& lhs = m_values.back();
+
+	// after an arithmetic error only the syntax of the rest is checked
+	if(m_solve_error != NO_ERROR) { return; }
+
+	if(!m_floating) {
+		switch(oper.type) {
+			case NODE_ADD:		lhs.integer = WrapAdd(lhs.integer, rhs.integer); break;
+			case NODE_SUBTRACT:	lhs.integer = WrapSubtract(lhs.integer, rhs.integer); break;
+			case NODE_MULTIPLY:	lhs.integer = WrapMultiply(lhs.integer, rhs.integer); break;
+			default:			break;
+		}
+	}
+
+	switch(oper.type) {
+		case NODE_ADD:		lhs.real = lhs.real + rhs.real; break;
+		case NODE_SUBTRACT:	lhs.real = lhs.real - rhs.real; break;
+		case NODE_MULTIPLY:	lhs.real = lhs.real * rhs.real; break;
+		case NODE_POWER:	lhs.real = std::pow(lhs.real, rhs.real); break;
+		case NODE_DIVIDE:
+
+			// check for a divide by zero error
+			if(rhs.real == 0) {
+				m_solve_error = DIVIDE_BY_ZERO;
+				m_solve_error_pos = oper.pos;
+				break;
+			}
+			lhs.real = lhs.real / rhs.real;
+			break;
+		default:
+			break;
+	}
+}
+
+///
+/// @brief applies the negative signs waiting on the stack to the operand that was just completed.
+/// @param
+/// @return
+/// @todo
+///
+void StreamSolver::ApplyNegates() {
+
+	value& operand = m_values.back();
+
+	while(!m_operators.empty() && m_operators.back().type == NODE_NEGATE) {
+		m_operators.pop_back();
+		operand.integer = WrapNegate(operand.integer);
+		operand.real = -operand.real;
+	}
+}
+
+///
+/// @brief records the first syntax error in the stream.
+/// @param[in] enumerator corresponding to the error_code enum.
+/// @param[in] size_t is the byte offset of the offending character.
+/// @return always 1, so callers can return the result directly.
+/// @todo
+///
+bool StreamSolver::SetError(errors error_code, std::size_t pos) {
+	m_error_code = error_code;
+	m_error_pos = pos;
+	return 1;
+}
+
+///
+/// @brief returns the binding strength of an operator on the stack, as GetPrecedence() does for tokens.
+/// @param[in] char is the node type of the operator, or '(' for an open group.
+/// @return 3 for '^', 2 for multiplication and division, 1 for addition and subtraction, 0 for an open group.
+/// @todo
+///
+int StreamSolver::GetPrecedence(char type) {
+	switch(type) {
+		case NODE_POWER:		return 3;
+		case NODE_MULTIPLY:
+		case NODE_DIVIDE:		return 2;
+		case NODE_ADD:
+		case NODE_SUBTRACT:		return 1;
+		default:				return 0;
+	}
+}
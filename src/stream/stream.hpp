@@ -0,0 +1,122 @@
+//
+// STREAM.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef STREAM_HPP
+#define STREAM_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../calculator/errors.hpp"
+#include "../lexer/lexer.hpp"
+#include "../solver/solver.hpp"
+
+namespace bocan {
+
+// solves a single expression that arrives in pieces, such as a generated file of many gigabytes, without
+// holding it in memory. the pieces are split into tokens as they arrive, each token is checked by the lexer
+// and reduced at once with an operator stack and an operand stack, so memory grows with how deeply the
+// expression is nested, up to the parser's MAX_DEPTH, never with its length. whether it is solved with longs or doubles is only known at
+// the end, so both values are carried until a '/', '^', radix point or exponent settles it. the solution,
+// and the byte offset of any error, are the same as Solver::Solve() gives for the whole text, except that
+// line breaks are read as white space.
+class StreamSolver {
+
+public:
+	void	Begin();
+	bool	Feed(const char*, std::size_t);
+	bool	Finish(Solution*);
+	bool	Solve(std::FILE*, Solution*);
+
+	std::size_t	GetByteCount() const { return m_offset; }
+	std::size_t	GetDeepestStack() const { return m_deepest; }
+
+	// bytes read from a file at a time
+	static const std::size_t CHUNK_SIZE = 1 << 16;
+
+	// a number is the only token kept as text until it ends, so its length is bounded
+	static const std::size_t MAX_LITERAL = 4096;
+
+private:
+	enum number_state : unsigned char {
+		NUMBER_NONE,
+		NUMBER_MANTISSA,
+		NUMBER_EXPONENT_MARK,
+		NUMBER_EXPONENT_SIGN,
+		NUMBER_EXPONENT
+	};
+
+	// an operator waiting for its right operand. the type is a node type, or '(' for an open group.
+	struct operation {
+		char		type;
+		std::size_t	pos;
+	};
+
+	// an operand as a long and as a double, only one of which is the answer
+	struct value {
+		long	integer;
+		double	real;
+	};
+
+	bool	Scan(char, std::size_t);
+	bool	Append(char);
+	bool	EndNumber();
+	bool	Push(token_type, std::size_t, std::size_t);
+	void	Shift(token_type, std::size_t);
+	void	Reduce();
+	void	ApplyNegates();
+	bool	SetError(errors, std::size_t);
+
+	static int	GetPrecedence(char);
+
+	Lexer					m_lexer;
+	std::vector<Token>		m_pending;
+	std::vector<operation>	m_operators;
+	std::vector<value>		m_values;
+	std::vector<char>		m_buffer;
+
+	// the number being read, which may continue in the next piece
+	number_state	m_number = NUMBER_NONE;
+	std::string		m_literal;
+	std::size_t		m_number_pos = 0;
+	std::size_t		m_exponent_pos = 0;
+	bool			m_radix = false;
+	bool			m_digits = false;
+	value			m_number_value = value();
+
+	std::size_t	m_offset = 0;
+	std::size_t	m_deepest = 0;
+	int			m_depth = 0;
+	bool		m_operand = false;
+	bool		m_floating = false;
+
+	// a syntax error stops the stream. an arithmetic error is only reported if the rest of the text is valid,
+	// as it would be if the whole text were checked before it is solved.
+	errors		m_error_code = NO_ERROR;
+	std::size_t	m_error_pos = 0;
+	errors		m_solve_error = NO_ERROR;
+	std::size_t	m_solve_error_pos = 0;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// STREAM_HPP
@@ -0,0 +1,211 @@
+//
+// THREAD_POOL.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "thread_pool.hpp"
+
+using bocan::ThreadPool;
+
+namespace {
+
+// index of the queue owned by the current thread. threads outside the pool use queue 0.
+thread_local unsigned int t_thread_index = 0;
+
+} // NAMESPACE
+
+///
+/// @brief creates one queue per thread and starts the worker threads.
+/// @param[in] unsigned integer is the number of threads, including the thread that waits on the pool. zero is treated as one.
+/// @return
+/// @todo
+///
+ThreadPool::ThreadPool(unsigned int threads) : m_pending(0), m_next(0), m_waiters(0), m_finished(0) {
+
+	if(threads == 0) { threads = 1; }
+
+	for(unsigned int i = 0; i < threads; i++) {
+		m_queues.emplace_back(new queue);
+	}
+	for(unsigned int i = 1; i < threads; i++) {
+		m_workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+	}
+}
+
+///
+/// @brief stops and joins the worker threads. tasks still queued are run before the workers exit.
+/// @param
+/// @return
+/// @todo
+///
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> guard(m_sleep_lock);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+
+	for(auto& worker : m_workers) { worker.join(); }
+}
+
+///
+/// @brief queues a task. a worker queues onto its own queue, other threads spread tasks over all queues.
+/// @param[in] function to run on any thread of the pool.
+/// @return
+/// @todo
+///
+void ThreadPool::Submit(std::function<void()> task) {
+
+	unsigned int count = GetThreadCount();
+	unsigned int index = t_thread_index;
+
+	if(index == 0 || index >= count) { index = m_next.fetch_add(1, std::memory_order_relaxed) % count; }
+
+	{
+		std::lock_guard<std::mutex> guard(m_queues[index]->lock);
+		m_queues[index]->tasks.push_back(std::move(task));
+	}
+	m_pending.fetch_add(1);
+
+	// taking the lock orders the wake up after a worker that is about to sleep has checked for tasks
+	{ std::lock_guard<std::mutex> guard(m_sleep_lock); }
+	m_wake.notify_one();
+
+	// a waiting thread may run the task itself
+	if(m_waiters.load()) { WakeWaiters(); }
+}
+
+///
+/// @brief runs one queued task on the calling thread, if there is one.
+/// @param
+/// @return boolean true if a task was run, false if every queue was empty.
+/// @todo
+///
+bool ThreadPool::RunPendingTask() {
+
+	std::function<void()> task;
+
+	if(!PopTask(t_thread_index % GetThreadCount(), &task)) { return false; }
+
+	task();
+	Finish();
+	return true;
+}
+
+///
+/// @brief returns the index of the calling thread within its pool. 0 for threads that are not pool workers.
+/// @param
+/// @return unsigned integer index, useful for picking per-thread scratch storage.
+/// @todo
+///
+unsigned int ThreadPool::GetThreadIndex() {
+	return t_thread_index;
+}
+
+///
+/// @brief runs tasks until the pool is destroyed, sleeping while there is no work.
+/// @param[in] unsigned integer is the index of the worker's own queue.
+/// @return
+/// @todo
+///
+void ThreadPool::WorkerLoop(unsigned int index) {
+
+	t_thread_index = index;
+	std::function<void()> task;
+
+	while(true) {
+
+		if(PopTask(index, &task)) {
+			task();
+			task = nullptr;
+			Finish();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleep_lock);
+		m_wake.wait(lock, [this] { return m_stop || m_pending.load() > 0; });
+
+		if(m_stop && m_pending.load() == 0) { return; }
+	}
+}
+
+///
+/// @brief takes the newest task of the thread's own queue, or steals the oldest task of another queue.
+/// @param[in] unsigned integer is the index of the thread's own queue.
+/// @param[out] function pointer receiving the task.
+/// @return boolean true if a task was taken.
+/// @todo
+///
+bool ThreadPool::PopTask(unsigned int index, std::function<void()>* task) {
+
+	unsigned int count = GetThreadCount();
+
+	{
+		queue& own = *m_queues[index];
+		std::lock_guard<std::mutex> guard(own.lock);
+		if(!own.tasks.empty()) {
+			*task = std::move(own.tasks.back());
+			own.tasks.pop_back();
+			m_pending.fetch_sub(1);
+			return true;
+		}
+	}
+
+	for(unsigned int i = 1; i < count; i++) {
+		queue& victim = *m_queues[(index + i) % count];
+		std::lock_guard<std::mutex> guard(victim.lock);
+		if(!victim.tasks.empty()) {
+			*task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			m_pending.fetch_sub(1);
+			return true;
+		}
+	}
+	return false;
+}
+
+///
+/// @brief counts a finished task and wakes the threads waiting on the pool, whose condition may now hold.
+/// @param
+/// @return
+/// @todo
+///
+void ThreadPool::Finish() {
+	m_finished.fetch_add(1);
+	if(m_waiters.load()) { WakeWaiters(); }
+}
+
+///
+/// @brief wakes every thread blocked in WaitUntil().
+/// @param
+/// @return
+/// @todo
+///
+void ThreadPool::WakeWaiters() {
+
+	// taking the lock orders the wake up after a waiter that is about to sleep has checked its condition
+	{ std::lock_guard<std::mutex> guard(m_sleep_lock); }
+	m_idle.notify_all();
+}
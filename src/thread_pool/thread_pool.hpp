@@ -0,0 +1,104 @@
+//
+// THREAD_POOL.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++14
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bocan {
+
+// work-stealing thread pool. every participant owns a task queue: a worker takes its newest task first
+// and, when its own queue is empty, steals the oldest task from another queue.
+// the thread that waits on the pool runs tasks too, so a pool of n threads starts n - 1 workers.
+class ThreadPool {
+
+public:
+	explicit ThreadPool(unsigned int);
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	~ThreadPool();
+
+	void	Submit(std::function<void()>);
+	bool	RunPendingTask();
+
+	unsigned int	GetThreadCount() const { return static_cast<unsigned int>(m_queues.size()); }
+
+	static unsigned int	GetThreadIndex();
+
+	///
+	/// @brief runs queued tasks on the calling thread until the condition is met. with nothing left to run,
+	/// @brief the caller sleeps until a task is queued or finishes, as the condition can only change then.
+	/// @param[in] callable returning true once the caller may continue.
+	/// @return
+	/// @todo
+	///
+	template<typename Condition>
+	void WaitUntil(Condition done) {
+		while(!done()) {
+			if(RunPendingTask()) { continue; }
+
+			// counted as a waiter before reading the finished count, so a task finishing after this is never missed
+			m_waiters.fetch_add(1);
+			unsigned long finished = m_finished.load();
+			{
+				std::unique_lock<std::mutex> lock(m_sleep_lock);
+				m_idle.wait(lock, [&] { return done() || m_pending.load() > 0 || m_finished.load() != finished; });
+			}
+			m_waiters.fetch_sub(1);
+		}
+	}
+
+private:
+	struct queue {
+		std::mutex							lock;
+		std::deque<std::function<void()>>	tasks;
+	};
+
+	void	WorkerLoop(unsigned int);
+	bool	PopTask(unsigned int, std::function<void()>*);
+	void	Finish();
+	void	WakeWaiters();
+
+	std::vector<std::unique_ptr<queue>>	m_queues;
+	std::vector<std::thread>			m_workers;
+
+	std::mutex				m_sleep_lock;
+	std::condition_variable	m_wake;
+	std::atomic<long>		m_pending;
+	std::atomic<unsigned int>	m_next;
+
+	// threads blocked in WaitUntil(), and the number of tasks run so far
+	std::condition_variable		m_idle;
+	std::atomic<unsigned int>	m_waiters;
+	std::atomic<unsigned long>	m_finished;
+	bool					m_stop = false;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// THREAD_POOL_HPP
@@ -0,0 +1,337 @@
+//
+// WORKSHEET.CPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "worksheet.hpp"
+#include "../lexer/lexer.hpp"
+
+using bocan::Worksheet;
+
+///
+/// @brief compiles a definition and solves it, along with every definition that uses it. if the definition
+/// @brief does not compile, or would use itself, the worksheet is left as it was.
+/// @param[in] string_view is the name being defined.
+/// @param[in] char pointer to the expression. names of other definitions may be used as variables.
+/// @param[in] size_t is the length of the expression.
+/// @param[out] Solution pointer receiving the new value, or the error.
+/// @return 0 if the definition was made and has a value, 1 on error.
+/// @todo
+///
+bool Worksheet::Define(std::string_view name, const char* expr, std::size_t size, Solution* solution) {
+
+	Expression compiled;
+	if(compiled.Compile(expr, size, solution)) { return 1; }
+
+	m_inputs.clear();
+	for(std::size_t i = 0; i < compiled.GetVariableCount(); i++) {
+		m_inputs.push_back(Insert(compiled.GetVariableName(i)));
+	}
+
+	unsigned int id = Insert(name);
+	if(Reaches(id, m_inputs)) {
+		*solution = Solution();
+		solution->error_code = CIRCULAR_DEFINITION;
+		return 1;
+	}
+
+	Unlink(id);
+
+	definition& d = m_definitions[id];
+	d.expression = std::move(compiled);
+	d.inputs = m_inputs;
+	d.defined = true;
+	d.fixed = false;
+	for(unsigned int input : d.inputs) { m_definitions[input].dependents.push_back(id); }
+
+	Update(id);
+
+	*solution = d.value;
+	return d.value.error_code != NO_ERROR;
+}
+
+///
+/// @brief gives a name a value that was solved elsewhere, such as 'ans', and solves every definition that uses it again.
+/// @param[in] string_view is the name.
+/// @param[in] Solution reference to the value.
+/// @return
+/// @todo
+///
+void Worksheet::Assign(std::string_view name, const Solution& value) {
+
+	unsigned int id = Insert(name);
+	Unlink(id);
+
+	definition& d = m_definitions[id];
+	d.expression = Expression();
+	d.inputs.clear();
+	d.defined = true;
+	d.fixed = true;
+	d.value = value;
+
+	Update(id);
+}
+
+///
+/// @brief solves an expression with the current values of the definitions it names, without defining anything.
+/// @param[in] char pointer to the expression.
+/// @param[in] size_t is the length of the expression.
+/// @param[out] Solution pointer receiving the solution, or the error.
+/// @return 0 on success, 1 on error.
+/// @todo
+///
+bool Worksheet::Solve(const char* expr, std::size_t size, Solution* solution) {
+
+	if(m_scratch.Compile(expr, size, solution)) { return 1; }
+
+	m_inputs.clear();
+	for(std::size_t i = 0; i < m_scratch.GetVariableCount(); i++) {
+		unsigned int id = Find(m_scratch.GetVariableName(i));
+		if(id == NONE) {
+			*solution = Solution();
+			solution->error_code = UNDEFINED_VARIABLE;
+			return 1;
+		}
+		m_inputs.push_back(id);
+	}
+	return Bind(&m_scratch, m_inputs, solution);
+}
+
+///
+/// @brief returns the current value of a definition.
+/// @param[in] string_view is the name.
+/// @param[out] Solution pointer receiving the value, or the error.
+/// @return 0 if the name has a value, 1 if it is not defined or its value is an error.
+/// @todo
+///
+bool Worksheet::Lookup(std::string_view name, Solution* solution) const {
+
+	unsigned int id = Find(name);
+	if(id == NONE) {
+		*solution = Solution();
+		solution->error_code = UNDEFINED_VARIABLE;
+		return 1;
+	}
+
+	*solution = m_definitions[id].value;
+	return solution->error_code != NO_ERROR;
+}
+
+///
+/// @brief checks whether a line defines a name, as in 'rate = 0.07'. a lone 'x' is the multiplication operator, not a name.
+/// @param[in] char pointer to the line.
+/// @param[in] size_t is the length of the line.
+/// @param[out] string_view pointer receiving the name.
+/// @param[out] size_t pointer receiving the position of the expression after the '='.
+/// @return boolean true if the line is an assignment.
+/// @todo
+///
+bool Worksheet::IsAssignment(const char* line, std::size_t size, std::string_view* name, std::size_t* expr) {
+
+	std::size_t i = 0;
+	while(i < size && (line[i] == ' ' || line[i] == '\t')) { i++; }
+
+	std::size_t start = i;
+	while(i < size && bocan::IsLetter(line[i])) { i++; }
+	if(i == start || (i - start == 1 && line[start] == 'x')) { return false; }
+
+	std::size_t end = i;
+	while(i < size && (line[i] == ' ' || line[i] == '\t')) { i++; }
+	if(i == size || line[i] != '=') { return false; }
+
+	*name = std::string_view(line + start, end - start);
+	*expr = i + 1;
+	return true;
+}
+
+///
+/// @brief finds a definition by name.
+/// @param[in] string_view is the name.
+/// @return unsigned integer index of the definition, or NONE.
+/// @todo
+///
+unsigned int Worksheet::Find(std::string_view name) const {
+	auto it = m_index.find(name);
+	return it == m_index.end() ? NONE : it->second;
+}
+
+///
+/// @brief finds a definition by name, adding one without a value if the name is new.
+/// @param[in] string_view is the name.
+/// @return unsigned integer index of the definition.
+/// @todo
+///
+unsigned int Worksheet::Insert(std::string_view name) {
+
+	unsigned int id = Find(name);
+	if(id != NONE) { return id; }
+
+	id = static_cast<unsigned int>(m_definitions.size());
+	m_definitions.emplace_back();
+
+	definition& d = m_definitions.back();
+	d.name.assign(name.data(), name.size());
+	d.value.error_code = UNDEFINED_VARIABLE;
+
+	m_index.emplace(std::string_view(d.name), id);
+	return id;
+}
+
+///
+/// @brief solves an expression with the values of the definitions bound to its variables.
+/// @param[in,out] Expression pointer to the compiled expression.
+/// @param[in] vector reference to the definition bound to each variable.
+/// @param[out] Solution pointer receiving the solution, or the first error among the values.
+/// @return 0 on success, 1 on error.
+/// @todo
+///
+bool Worksheet::Bind(Expression* expression, const std::vector<unsigned int>& inputs, Solution* solution) {
+
+	bool integral = expression->IsIntegral();
+
+	m_values.resize(inputs.size());
+	m_integers.resize(inputs.size());
+	for(std::size_t i = 0; i < inputs.size(); i++) {
+
+		const Solution& value = m_definitions[inputs[i]].value;
+		if(value.error_code != NO_ERROR) {
+			*solution = Solution();
+			solution->error_code = value.error_code;
+			return 1;
+		}
+		m_values[i] = value.floating ? value.real : static_cast<double>(value.integer);
+		m_integers[i] = value.integer;
+		if(value.floating) { integral = false; }
+	}
+
+	// whole numbers stay exact beyond the 53 bits of a double
+	if(integral) { return expression->Evaluate(m_integers.data(), solution); }
+	return expression->Evaluate(m_values.data(), solution);
+}
+
+///
+/// @brief checks whether any of the given definitions uses the definition, directly or through others.
+/// @brief if so, making the definition use them would make it use itself.
+/// @param[in] unsigned integer index of the definition.
+/// @param[in] vector reference to the definitions it would use.
+/// @return boolean true if one of them is the definition or uses it.
+/// @todo
+///
+bool Worksheet::Reaches(unsigned int id, const std::vector<unsigned int>& targets) {
+
+	if(targets.empty()) { return false; }
+
+	m_visit++;
+	m_stack.clear();
+	m_stack.emplace_back(id, 0);
+	m_definitions[id].visit = m_visit;
+
+	while(!m_stack.empty()) {
+		unsigned int current = m_stack.back().first;
+		m_stack.pop_back();
+		for(unsigned int next : m_definitions[current].dependents) {
+			if(m_definitions[next].visit != m_visit) {
+				m_definitions[next].visit = m_visit;
+				m_stack.emplace_back(next, 0);
+			}
+		}
+	}
+
+	for(unsigned int target : targets) {
+		if(m_definitions[target].visit == m_visit) { return true; }
+	}
+	return false;
+}
+
+///
+/// @brief removes a definition from the dependents of everything it uses.
+/// @param[in] unsigned integer index of the definition.
+/// @return
+/// @todo
+///
+void Worksheet::Unlink(unsigned int id) {
+	for(unsigned int input : m_definitions[id].inputs) {
+		std::vector<unsigned int>& dependents = m_definitions[input].dependents;
+		dependents.erase(std::find(dependents.begin(), dependents.end(), id));
+	}
+	m_definitions[id].inputs.clear();
+}
+
+///
+/// @brief solves a changed definition and everything that uses it. a depth first walk along the dependents lists
+/// @brief each definition after everything that uses it, so the list read backwards is an order in which
+/// @brief every definition is solved after the ones it uses. definitions that are not reached are not touched.
+/// @param[in] unsigned integer index of the definition that changed.
+/// @return
+/// @todo
+///
+void Worksheet::Update(unsigned int id) {
+
+	m_visit++;
+	m_order.clear();
+	m_stack.clear();
+	m_stack.emplace_back(id, 0);
+	m_definitions[id].visit = m_visit;
+
+	while(!m_stack.empty()) {
+
+		unsigned int current = m_stack.back().first;
+		std::size_t next = m_stack.back().second;
+		const std::vector<unsigned int>& dependents = m_definitions[current].dependents;
+
+		if(next == dependents.size()) {
+			m_order.push_back(current);
+			m_stack.pop_back();
+			continue;
+		}
+
+		m_stack.back().second++;
+		unsigned int dependent = dependents[next];
+		if(m_definitions[dependent].visit != m_visit) {
+			m_definitions[dependent].visit = m_visit;
+			m_stack.emplace_back(dependent, 0);
+		}
+	}
+
+	for(auto it = m_order.rbegin(); it != m_order.rend(); ++it) { Recompute(*it); }
+}
+
+///
+/// @brief solves one definition with the current values of the definitions it uses.
+/// @param[in] unsigned integer index of the definition.
+/// @return
+/// @todo
+///
+void Worksheet::Recompute(unsigned int id) {
+
+	definition& d = m_definitions[id];
+	if(d.fixed) { return; }
+
+	if(!d.defined) {
+		d.value = Solution();
+		d.value.error_code = UNDEFINED_VARIABLE;
+		return;
+	}
+	Bind(&d.expression, d.inputs, &d.value);
+}
@@ -0,0 +1,94 @@
+//
+// WORKSHEET.HPP [PROJECT CALCULATOR]
+// C++ VERSION GNU++17
+// macOS 11.7.9
+// DUAL-CORE INTEL CORE i5 @ 2.8 GHZ
+//
+// COPYRIGHT [2023] [MATTHEW T. BUCHANAN] [BOCAN SOFTWARE]
+//
+// LICENSED UNDER THE APACHE LICENSE, VERSION 2.0 (THE "LICENSE");
+// YOU MAY NOT USE THIS FILE EXCEPT IN COMPLIANCE WITH THE LICENSE.
+// YOU MAY OBTAIN A COPY OF THE LICENSE AT
+//
+// http://www.apacher.org/licenses.LICENSE-2.0
+//
+// UNLESS REQUIRED BY APPLICABLE LAW OR AGREED TO IN WRITING, SOFTWARE
+// DISTRIBUTED UNDER THE LICENSE IS DISTRIBUTED ON AN "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+// SEE THE LICENSE FOR THE SPECIFIC LANGUAGE GOVERNING PERMISSIONS AND
+// LIMITATIONS UNDER THE LICENSE.
+
+#ifndef WORKSHEET_HPP
+#define WORKSHEET_HPP
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../expression/expression.hpp"
+#include "../solver/solver.hpp"
+
+namespace bocan {
+
+// named definitions such as 'rate = 0.07' or 'total = price*(1+rate)', kept with the graph of which
+// definitions use which. each definition is compiled once, and its value is kept as the long or double
+// it was solved to. an integral expression of longs is solved with longs, so using a value later loses
+// nothing. when a definition changes, only the definitions that use it, directly or through others, are
+// solved again, in an order where every definition comes after the ones it uses. a name may be used
+// before it is defined, and a definition that would use itself is refused.
+class Worksheet {
+
+public:
+	bool	Define(std::string_view, const char*, std::size_t, Solution*);
+	void	Assign(std::string_view, const Solution&);
+	bool	Solve(const char*, std::size_t, Solution*);
+	bool	Lookup(std::string_view, Solution*) const;
+
+	std::size_t		GetCount() const { return m_definitions.size(); }
+	std::size_t		GetUpdateCount() const { return m_order.size(); }
+
+	static bool	IsAssignment(const char*, std::size_t, std::string_view*, std::size_t*);
+
+private:
+	struct definition {
+		std::string					name;
+		Expression					expression;
+		std::vector<unsigned int>	inputs;			// the definition bound to each variable of the expression
+		std::vector<unsigned int>	dependents;		// the definitions that use this one
+		Solution					value;
+		bool						defined = false;
+		bool						fixed = false;	// a value given by Assign() rather than an expression
+		unsigned long				visit = 0;
+	};
+
+	unsigned int	Find(std::string_view) const;
+	unsigned int	Insert(std::string_view);
+	bool			Bind(Expression*, const std::vector<unsigned int>&, Solution*);
+	bool			Reaches(unsigned int, const std::vector<unsigned int>&);
+	void			Unlink(unsigned int);
+	void			Update(unsigned int);
+	void			Recompute(unsigned int);
+
+	// a deque never moves its elements, so the index can refer to the names they hold
+	std::deque<definition>								m_definitions;
+	std::unordered_map<std::string_view, unsigned int>	m_index;
+
+	// scratch for one change: the definitions to solve again, the walk that finds them, and variable values
+	std::vector<unsigned int>							m_order;
+	std::vector<std::pair<unsigned int, std::size_t>>	m_stack;
+	std::vector<unsigned int>							m_inputs;
+	std::vector<double>									m_values;
+	std::vector<long>									m_integers;
+	Expression											m_scratch;
+	unsigned long										m_visit = 0;
+
+	static const unsigned int NONE = ~0u;
+};
+
+} // NAMESPACE BOCAN
+
+#endif	// WORKSHEET_HPP